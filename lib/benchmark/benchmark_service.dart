@@ -44,32 +44,6 @@ Future<Uint8List?> _runDartCrypto(Map<String, dynamic> args) async {
   }
 }
 
-/// A wrapper for the FFI (Foreign Function Interface) cryptographic implementation.
-/// This function is designed to be executed in a separate isolate via `compute()`.
-///
-/// It takes a map of arguments, instantiates the [FfiCryptoService], and performs
-/// either encryption or decryption by calling native code.
-Uint8List? _runFfiCrypto(Map<String, dynamic> args) {
-  // Instantiate the service within the isolate.
-  final service = FfiCryptoService();
-  // Unpack arguments from the map.
-  final bool isEncrypt = args['isEncrypt'];
-  final AlgorithmType algoType = args['algoType'];
-  final Uint8List data = args['data'];
-  final Uint8List key = args['key']; // Raw bytes for the key.
-  final Uint8List nonce = args['nonce']; // Raw bytes for the nonce.
-
-  // Conditionally call the appropriate encryption or decryption method.
-  if (isEncrypt) {
-    return (algoType == AlgorithmType.aesGcm)
-        ? service.encryptAesGcm(data, key, nonce)
-        : service.encryptChaCha(data, key, nonce);
-  } else {
-    return (algoType == AlgorithmType.aesGcm)
-        ? service.decryptAesGcm(data, key, nonce)
-        : service.decryptChaCha(data, key, nonce);
-  }
-}
 // NOTE: A wrapper for Platform Channel (_runPcCrypto) was removed as it's not
 // suitable for use with `compute`. Platform Channel calls are inherently asynchronous
 // and must be initiated from the main isolate to communicate with the platform thread.
@@ -79,6 +53,22 @@ class BenchmarkService {
   // Instantiate the services for each implementation type.
   final PlatformChannelCryptoService _pcService =
       PlatformChannelCryptoService();
+  // Created on first FFI run; it keeps the native completion port between
+  // calls instead of spawning an isolate per operation.
+  late final FfiCryptoService _ffiService = FfiCryptoService();
+
+  // Natively generated nonces not handed out yet (see _generateNonce).
+  static const int _nonceBatch = 256;
+  Uint8List _nonceBuffer = Uint8List(0);
+  int _nonceOffset = 0;
+  bool _nativeNoncesAvailable = true;
+
+  // The native CPU report is logged once, before the first FFI run.
+  bool _cpuReportLogged = false;
+
+  // Seed of the benchmark payloads (see generateRandomData).
+  static const int _payloadSeed = 0x6e63;
+  bool _nativeRandomAvailable = true;
 
   // Keys used for the benchmarks. We generate them once to ensure consistency.
   late SecretKey _aesKeyDartImpl; // AES key for the pure Dart implementation.
@@ -113,22 +103,73 @@ class BenchmarkService {
 
   /// Generates a [Uint8List] of a specified size with random data.
   ///
+  /// The payload only has to look random to the ciphers, not be secret, so it
+  /// comes from the native seeded generator: one call fills even the largest
+  /// sizes, and the same size yields the same bytes on every device. Where
+  /// the native library is unavailable, a seeded Dart [Random] is used.
+  ///
   /// [sizeInBytes] The desired size of the data block.
-  Uint8List _generateRandomData(int sizeInBytes) {
-    final random = Random.secure();
+  Uint8List generateRandomData(int sizeInBytes) {
+    if (_nativeRandomAvailable) {
+      try {
+        final data = _ffiService.randomBytes(sizeInBytes, seed: _payloadSeed);
+        if (data != null) return data;
+      } catch (e) {
+        print("Native random data unavailable, using Dart: $e");
+        _nativeRandomAvailable = false;
+      }
+    }
+    final random = Random(_payloadSeed);
     return Uint8List.fromList(
         List.generate(sizeInBytes, (_) => random.nextInt(256)));
   }
 
   /// Generates a 96-bit (12-byte) nonce (Initialization Vector).
   /// This size is standard for AES-GCM and ChaCha20-Poly1305.
+  ///
+  /// Nonces are taken from a buffer filled natively (RAND_bytes) in batches
+  /// of [_nonceBatch], so the loop does not pay for a Dart `Random.secure()`
+  /// call per byte. Where the native library is unavailable, the nonce is
+  /// generated in Dart instead.
   Uint8List _generateNonce() {
-    final random = Random.secure();
     const int nonceSize = 12; // 12 bytes = 96 bits.
+    if (_nonceOffset >= _nonceBuffer.length && _nativeNoncesAvailable) {
+      try {
+        final nonces = _ffiService.generateNonces(_nonceBatch);
+        if (nonces != null) {
+          _nonceBuffer = nonces;
+          _nonceOffset = 0;
+        }
+      } catch (e) {
+        print("Native nonce generation unavailable, using Dart: $e");
+        _nativeNoncesAvailable = false;
+      }
+    }
+    if (_nonceOffset < _nonceBuffer.length) {
+      final nonce =
+          _nonceBuffer.sublist(_nonceOffset, _nonceOffset + nonceSize);
+      _nonceOffset += nonceSize;
+      return nonce;
+    }
+    final random = Random.secure();
     return Uint8List.fromList(
         List.generate(nonceSize, (_) => random.nextInt(256)));
   }
 
+  /// Logs which BoringSSL code paths this device uses and which algorithm
+  /// the native calibration would pick, so that results from different
+  /// devices can be told apart by CPU class.
+  void _logCpuReportOnce() {
+    if (_cpuReportLogged) return;
+    _cpuReportLogged = true;
+    try {
+      print("Native CPU report: ${_ffiService.cpuFeatureReport()}");
+      print("Native auto algorithm: ${_ffiService.autoAlgorithm()}");
+    } catch (e) {
+      print("Native CPU report unavailable: $e");
+    }
+  }
+
   /// Runs a full benchmark cycle for a given configuration.
   ///
   /// This is the main method of the service. It performs the following steps:
@@ -167,10 +208,22 @@ class BenchmarkService {
     int sumRss = 0;
 
     //  Get the starting CPU time before the benchmark loop.
-    // This requires a platform channel call, so it's asynchronous.
+    // This requires a platform channel call, so it's asynchronous. The FFI
+    // implementation additionally measures the thread CPU time of each native
+    // call, reported separately as NativeCPUTime_ms.
+    final bool measuresNatively = implType == ImplementationType.ffi;
+    if (measuresNatively) _logCpuReportOnce();
     final int startCpuTime = await _pcService.getCpuTime();
+    NativeThreadUsage? nativeUsage =
+        measuresNatively ? NativeThreadUsage.zero : null;
+
+    // For FFI runs a native sampler thread also records RSS at 1 kHz during
+    // the loop, so transient peaks inside a single large call are captured.
+    final NativeMemorySampler? memorySampler =
+        measuresNatively ? _ffiService.createMemorySampler() : null;
+    memorySampler?.begin();
 
-    final plainText = testData ?? _generateRandomData(dataSize);
+    final plainText = testData ?? generateRandomData(dataSize);
     final List<Duration> encryptDurations = [];
     final List<Duration> decryptDurations = [];
 
@@ -218,16 +271,18 @@ class BenchmarkService {
             break;
 
           case ImplementationType.ffi:
-            // Use `compute` to run the FFI crypto logic in a separate isolate.
-            encryptedData = await compute(_runFfiCrypto, {
-              'isEncrypt': true,
-              'algoType': algoType,
-              'data': plainText,
-              'key': algoType == AlgorithmType.aesGcm
+            // Queue the call on the native worker pool; the completion
+            // (with the worker's thread usage) arrives on a native port.
+            final (data, usage) = await _ffiService.encryptAsync(
+              algoType,
+              plainText,
+              algoType == AlgorithmType.aesGcm
                   ? _aesKeyRawBytes
                   : _chaKeyRawBytes,
-              'nonce': nonce,
-            });
+              nonce,
+            );
+            encryptedData = data;
+            nativeUsage = _addUsage(nativeUsage, usage);
             break;
         }
         stopwatchEncrypt.stop();
@@ -273,16 +328,17 @@ class BenchmarkService {
             break;
 
           case ImplementationType.ffi:
-            // Use `compute` for FFI decryption in a separate isolate.
-            decryptedData = await compute(_runFfiCrypto, {
-              'isEncrypt': false,
-              'algoType': algoType,
-              'data': encryptedData,
-              'key': algoType == AlgorithmType.aesGcm
+            // FFI decryption on the native worker pool as well.
+            final (data, usage) = await _ffiService.decryptAsync(
+              algoType,
+              encryptedData,
+              algoType == AlgorithmType.aesGcm
                   ? _aesKeyRawBytes
                   : _chaKeyRawBytes,
-              'nonce': nonce,
-            });
+              nonce,
+            );
+            decryptedData = data;
+            nativeUsage = _addUsage(nativeUsage, usage);
             break;
         }
         stopwatchDecrypt.stop();
@@ -319,6 +375,16 @@ class BenchmarkService {
           ? endCpuTime - startCpuTime
           : -1; // -1 indicates an error or unavailability.
 
+      // Prefer the native sampler's statistics over the per-iteration samples.
+      final memoryStats = memorySampler?.end();
+      int averageRss = sumRss ~/ iterations;
+      if (memoryStats != null) {
+        averageRss = memoryStats.rssAverage;
+        peakRss = max(peakRss, memoryStats.rssPeak);
+        print("Native memory sampler: ${memoryStats.samples} samples, "
+            "heap peak delta: ${memoryStats.heapPeak != null ? memoryStats.heapPeak! - memoryStats.heapStart! : 'N/A'} B");
+      }
+
       // Measure memory after the test.
       await Future.delayed(const Duration(milliseconds: 50));
       final finalRss = ProcessInfo.currentRss;
@@ -352,9 +418,10 @@ class BenchmarkService {
         initialMemory: initialRss,
         peakMemory: peakRss,
         finalMemory: finalRss,
-        averageMemory: sumRss ~/ iterations,
+        averageMemory: averageRss,
         //  Pass the new metrics to the BenchmarkResult constructor.
         cpuTimeUsed: cpuTimeDelta,
+        nativeUsage: nativeUsage,
         stdevEncryptTime: stdevEncrypt,
         stdevDecryptTime: stdevDecrypt,
       );
@@ -369,9 +436,20 @@ class BenchmarkService {
         iterations: iterations,
         message: e.toString(),
       );
+    } finally {
+      // Stops the sampler thread, also when a phase is still running.
+      memorySampler?.dispose();
     }
   }
 
+  /// Adds the usage of one native call to a running total. A call that could
+  /// not be measured invalidates the total (null).
+  NativeThreadUsage? _addUsage(
+      NativeThreadUsage? total, NativeThreadUsage? call) {
+    if (total == null || call == null) return null;
+    return total + call;
+  }
+
   /// Calculates the average duration from a list of [Duration] objects.
   Duration _calculateAverage(List<Duration> durations) {
     if (durations.isEmpty) return Duration.zero;
@@ -29,6 +29,72 @@ enum AlgorithmType {
   chaChaPoly
 }
 
+/// Resource usage of one native thread, read with `nc_thread_usage_get` from
+/// the FFI layer. A single sample holds cumulative counters; the difference of
+/// two samples taken around a native call attributes the usage to that call.
+@immutable
+class NativeThreadUsage {
+  /// User + system CPU time of the thread, in nanoseconds.
+  final int cpuTimeNs;
+
+  /// Page faults served without I/O.
+  final int minorFaults;
+
+  /// Page faults that required I/O.
+  final int majorFaults;
+
+  /// Context switches because the thread blocked or yielded.
+  final int voluntarySwitches;
+
+  /// Context switches because the thread was preempted.
+  final int involuntarySwitches;
+
+  /// Whether the fault and context switch counters are available
+  /// (per-thread rusage is Linux/Android only; CPU time is always present).
+  final bool hasRusage;
+
+  const NativeThreadUsage({
+    required this.cpuTimeNs,
+    required this.minorFaults,
+    required this.majorFaults,
+    required this.voluntarySwitches,
+    required this.involuntarySwitches,
+    this.hasRusage = true,
+  });
+
+  /// An empty total to accumulate deltas into.
+  static const NativeThreadUsage zero = NativeThreadUsage(
+    cpuTimeNs: 0,
+    minorFaults: 0,
+    majorFaults: 0,
+    voluntarySwitches: 0,
+    involuntarySwitches: 0,
+  );
+
+  /// The usage between [earlier] and this sample.
+  NativeThreadUsage operator -(NativeThreadUsage earlier) => NativeThreadUsage(
+        cpuTimeNs: cpuTimeNs - earlier.cpuTimeNs,
+        minorFaults: minorFaults - earlier.minorFaults,
+        majorFaults: majorFaults - earlier.majorFaults,
+        voluntarySwitches: voluntarySwitches - earlier.voluntarySwitches,
+        involuntarySwitches: involuntarySwitches - earlier.involuntarySwitches,
+        hasRusage: hasRusage && earlier.hasRusage,
+      );
+
+  /// The sum of two deltas.
+  NativeThreadUsage operator +(NativeThreadUsage other) => NativeThreadUsage(
+        cpuTimeNs: cpuTimeNs + other.cpuTimeNs,
+        minorFaults: minorFaults + other.minorFaults,
+        majorFaults: majorFaults + other.majorFaults,
+        voluntarySwitches: voluntarySwitches + other.voluntarySwitches,
+        involuntarySwitches: involuntarySwitches + other.involuntarySwitches,
+        hasRusage: hasRusage && other.hasRusage,
+      );
+
+  /// The CPU time in milliseconds.
+  double get cpuTimeMs => cpuTimeNs / 1e6;
+}
+
 /// A data class to store the result of a single benchmark test run.
 ///
 /// It is marked as `@immutable` to indicate that its state should not change
@@ -75,6 +141,12 @@ class BenchmarkResult {
   /// A value of -1 indicates that the measurement was not available.
   final int cpuTimeUsed;
 
+  /// CPU time, page faults and context switches of the native crypto calls
+  /// alone, measured on the thread that ran each call: the calling thread for
+  /// the synchronous wrappers, the native worker thread for encryptAsync and
+  /// decryptAsync. Only available for the FFI implementation; null otherwise.
+  final NativeThreadUsage? nativeUsage;
+
   /// [ENGLISH] The standard deviation of encryption times, indicating jitter.
   final Duration stdevEncryptTime;
 
@@ -111,6 +183,7 @@ class BenchmarkResult {
     required this.cpuTimeUsed,
     required this.stdevEncryptTime,
     required this.stdevDecryptTime,
+    this.nativeUsage,
     this.success = true,
     this.errorMessage,
   });
@@ -171,6 +244,17 @@ class BenchmarkResult {
 
     // [ENGLISH] Format CPU time. Assuming 100 jiffies per second, so 1 jiffy = 10ms.
     final cpuTimeMs = (cpuTimeUsed * 10).toStringAsFixed(2);
+    // Native per-thread usage of the crypto calls (FFI only).
+    String nativeCpu = '';
+    final usage = nativeUsage;
+    if (usage != null) {
+      nativeCpu = '\nNative CPU Time: ${usage.cpuTimeMs.toStringAsFixed(3)}ms,';
+      if (usage.hasRusage) {
+        nativeCpu +=
+            '\nFaults: ${usage.minorFaults} minor, ${usage.majorFaults} major,'
+            '\nCtx switches: ${usage.voluntarySwitches} vol, ${usage.involuntarySwitches} invol,';
+      }
+    }
 
     return '${implType.name},'
         '\n${algoType.name},'
@@ -180,6 +264,7 @@ class BenchmarkResult {
         '\nDecrypt: ${decMs}ms (±${decStdevMs}ms),' // [ENGLISH] Added stdev to output
         '\nSum: ${sumMs}ms'
         '\nCPU Time: ${cpuTimeUsed > -1 ? "${cpuTimeMs}ms" : "N/A"},' // [ENGLISH] Added CPU time to output
+        '$nativeCpu'
         '\nInit mem: ${(initialMemory / 1048576).toStringAsFixed(3)}MB'
         '\nPeak mem: ${(peakMemory / 1048576).toStringAsFixed(3)}MB'
         '\nFinal mem: ${(finalMemory / 1048576).toStringAsFixed(3)}MB'
@@ -204,7 +289,13 @@ class BenchmarkResult {
         (stdevEncryptTime.inMicroseconds / 1000).toStringAsFixed(3);
     final decStdevMs =
         (stdevDecryptTime.inMicroseconds / 1000).toStringAsFixed(3);
+    // CPUTime_ms is the process-wide jiffies from the platform channel for
+    // every implementation; NativeCPUTime_ms is the thread CPU time of the
+    // native crypto calls alone (FFI only).
     final cpuTimeMs = cpuTimeUsed > -1 ? (cpuTimeUsed * 10).toString() : "N/A";
+    final nativeCpuTimeMs = nativeUsage != null
+        ? nativeUsage!.cpuTimeMs.toStringAsFixed(3)
+        : "N/A";
 
     // RAM usages in MB
     final ramAvgMb = (averageMemory / (1024 * 1024)).toStringAsFixed(3);
@@ -212,6 +303,6 @@ class BenchmarkResult {
 
     // Returns a semicolon-separated string.
     // [ENGLISH] Updated the CSV format to include the new metrics.
-    return "$implType;$algoType;$dataSize;$iterations;$wallEncryptMs;$encStdevMs;$wallDecryptMs;$decStdevMs;$wallSumMs;$cpuTimeMs;$ramAvgMb;$ramPeakMb\n";
+    return "$implType;$algoType;$dataSize;$iterations;$wallEncryptMs;$encStdevMs;$wallDecryptMs;$decStdevMs;$wallSumMs;$cpuTimeMs;$ramAvgMb;$ramPeakMb;$nativeCpuTimeMs\n";
   }
 }
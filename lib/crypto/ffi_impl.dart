@@ -1,10 +1,14 @@
 // ignore_for_file: avoid_print // For print logs during debugging
 
+import 'dart:async'; // For Completer (asynchronous API)
 import 'dart:ffi'; // Core FFI types (Pointer, Int32, etc.)
+import 'dart:isolate'; // For RawReceivePort (asynchronous API completions)
 import 'dart:io' show Platform; // For platform checking
 import 'dart:typed_data';
 
-import 'package:ffi/ffi.dart'; // For calloc (C memory allocation)
+import 'package:ffi/ffi.dart'; // For calloc (C memory allocation) and Utf8
+
+import 'common.dart'; // For AlgorithmType and NativeThreadUsage
 
 // --- FFI type definitions corresponding to signatures in native_crypto.h ---
 
@@ -89,6 +93,363 @@ typedef DecryptChaChaDart = int Function(
     int aadLen,
     Pointer<Uint8> outPlaintext);
 
+// --- FFI type definitions for the handle-based and batch API ---
+
+// Algorithm identifiers (NC_ALG_* in native_crypto.h).
+const int ncAlgAes256Gcm = 0;
+const int ncAlgChaCha20Poly1305 = 1;
+
+// nc_aead_ctx* nc_aead_ctx_new(int algorithm, const uint8_t* key, size_t key_len)
+typedef AeadCtxNewNative = Pointer<Void> Function(
+    Int32 algorithm, Pointer<Uint8> key, IntPtr keyLen);
+typedef AeadCtxNewDart = Pointer<Void> Function(
+    int algorithm, Pointer<Uint8> key, int keyLen);
+
+// void nc_aead_ctx_free(nc_aead_ctx* ctx)
+typedef AeadCtxFreeNative = Void Function(Pointer<Void> ctx);
+typedef AeadCtxFreeDart = void Function(Pointer<Void> ctx);
+
+// --- FFI type definitions for the nonce generation API ---
+
+// Nonce modes (NC_NONCE_* in native_crypto.h).
+const int ncNonceCounter = 0;
+const int ncNonceRandom = 1;
+const int ncNonceLen = 12;
+
+// int nc_aead_generate_nonces(nc_aead_ctx* ctx, int mode, uint8_t* out_nonces, size_t count)
+typedef GenerateNoncesNative = Int32 Function(
+    Pointer<Void> ctx, Int32 mode, Pointer<Uint8> outNonces, IntPtr count);
+typedef GenerateNoncesDart = int Function(
+    Pointer<Void> ctx, int mode, Pointer<Uint8> outNonces, int count);
+
+// int nc_aead_seal_auto_nonce(...)
+typedef SealAutoNonceNative = Int32 Function(
+    Pointer<Void> ctx,
+    Int32 mode,
+    Pointer<Uint8> plaintext,
+    IntPtr plaintextLen,
+    Pointer<Uint8> aad,
+    IntPtr aadLen,
+    Pointer<Uint8> outNonce,
+    Pointer<Uint8> outCiphertextTag);
+typedef SealAutoNonceDart = int Function(
+    Pointer<Void> ctx,
+    int mode,
+    Pointer<Uint8> plaintext,
+    int plaintextLen,
+    Pointer<Uint8> aad,
+    int aadLen,
+    Pointer<Uint8> outNonce,
+    Pointer<Uint8> outCiphertextTag);
+
+// --- FFI type definitions for the random data API ---
+
+// Random modes (NC_RANDOM_* in native_crypto.h).
+const int ncRandomCrypto = 0;
+const int ncRandomSeeded = 1;
+
+// int nc_fill_random(uint8_t* buf, size_t len, int mode, uint64_t seed)
+typedef FillRandomNative = Int32 Function(
+    Pointer<Uint8> buf, IntPtr len, Int32 mode, Uint64 seed);
+typedef FillRandomDart = int Function(
+    Pointer<Uint8> buf, int len, int mode, int seed);
+
+// --- FFI type definitions for the CPU capability and automatic selection API ---
+
+// Placeholder for the faster AEAD on this CPU (NC_ALG_AUTO in native_crypto.h).
+// Only nc_aead_ctx_new accepts it, and the context it creates seals only.
+const int ncAlgAuto = 100;
+
+/// Mirror of `nc_cpu_features` from native_crypto.h.
+final class NcCpuFeatures extends Struct {
+  @Int32()
+  external int asmEnabled;
+  @Int32()
+  external int aesHardware;
+  @Int32()
+  external int aesni;
+  @Int32()
+  external int pclmulqdq;
+  @Int32()
+  external int ssse3;
+  @Int32()
+  external int avx;
+  @Int32()
+  external int avx2;
+  @Int32()
+  external int avx512;
+  @Int32()
+  external int vaes;
+  @Int32()
+  external int vpclmulqdq;
+  @Int32()
+  external int neon;
+  @Int32()
+  external int armv8Aes;
+  @Int32()
+  external int armv8Pmull;
+  external Pointer<Utf8> expectedAesGcmPath;
+  external Pointer<Utf8> expectedChachaPath;
+}
+
+/// Mirror of `nc_auto_selection` from native_crypto.h.
+final class NcAutoSelection extends Struct {
+  @Int32()
+  external int algorithm;
+  @Int32()
+  external int calibrated;
+  @Double()
+  external double aesGcmMibPerS;
+  @Double()
+  external double chachaMibPerS;
+}
+
+// int nc_cpu_features_get(nc_cpu_features* out_features)
+typedef CpuFeaturesGetNative = Int32 Function(
+    Pointer<NcCpuFeatures> outFeatures);
+typedef CpuFeaturesGetDart = int Function(Pointer<NcCpuFeatures> outFeatures);
+
+// int nc_algorithm_auto(nc_auto_selection* out_selection)
+typedef AlgorithmAutoNative = Int32 Function(
+    Pointer<NcAutoSelection> outSelection);
+typedef AlgorithmAutoDart = int Function(
+    Pointer<NcAutoSelection> outSelection);
+
+/// Mirror of `nc_aead_batch_item` from native_crypto.h.
+final class NcAeadBatchItem extends Struct {
+  external Pointer<Uint8> input;
+  @IntPtr()
+  external int inputLen;
+  external Pointer<Uint8> nonce;
+  @IntPtr()
+  external int nonceLen;
+  external Pointer<Uint8> aad;
+  @IntPtr()
+  external int aadLen;
+  external Pointer<Uint8> output;
+}
+
+// int nc_aead_seal_batch(...) / int nc_aead_open_batch(...)
+typedef AeadBatchNative = Int32 Function(Pointer<Void> ctx,
+    Pointer<NcAeadBatchItem> items, IntPtr count, Pointer<Int32> outStatus);
+typedef AeadBatchDart = int Function(Pointer<Void> ctx,
+    Pointer<NcAeadBatchItem> items, int count, Pointer<Int32> outStatus);
+
+// --- FFI type definitions for the file API ---
+
+// int nc_file_seal(...) / int nc_file_open(...)
+typedef FileProcessNative = Int32 Function(
+    Pointer<Void> ctx,
+    Pointer<Utf8> inPath,
+    Pointer<Utf8> outPath,
+    Pointer<Uint8> noncePrefix,
+    Pointer<Uint8> aad,
+    IntPtr aadLen,
+    IntPtr segmentSize,
+    Pointer<Uint64> outLen);
+typedef FileProcessDart = int Function(
+    Pointer<Void> ctx,
+    Pointer<Utf8> inPath,
+    Pointer<Utf8> outPath,
+    Pointer<Uint8> noncePrefix,
+    Pointer<Uint8> aad,
+    int aadLen,
+    int segmentSize,
+    Pointer<Uint64> outLen);
+
+// Length of the nonce prefix of the segmented format (NC_SEGMENT_NONCE_PREFIX_LEN).
+const int ncSegmentNoncePrefixLen = 7;
+
+// --- FFI type definitions for the thread resource usage API ---
+
+/// Mirror of `nc_thread_usage` from native_crypto.h.
+final class NcThreadUsage extends Struct {
+  @Uint64()
+  external int cpuTimeNs;
+  @Uint64()
+  external int minorFaults;
+  @Uint64()
+  external int majorFaults;
+  @Uint64()
+  external int voluntarySwitches;
+  @Uint64()
+  external int involuntarySwitches;
+}
+
+// int nc_thread_usage_get(nc_thread_usage* out_usage)
+typedef ThreadUsageGetNative = Int32 Function(Pointer<NcThreadUsage> outUsage);
+typedef ThreadUsageGetDart = int Function(Pointer<NcThreadUsage> outUsage);
+
+// Error code for a missing per-thread rusage (NC_ERR_UNSUPPORTED in native_crypto.h).
+const int ncErrUnsupported = -3;
+
+// --- FFI type definitions for the memory sampler API ---
+
+/// Mirror of `nc_mem_stats` from native_crypto.h.
+final class NcMemStats extends Struct {
+  @Uint64()
+  external int samples;
+  @Uint64()
+  external int rssStartBytes;
+  @Uint64()
+  external int rssEndBytes;
+  @Uint64()
+  external int rssAvgBytes;
+  @Uint64()
+  external int rssPeakBytes;
+  @Uint64()
+  external int heapStartBytes;
+  @Uint64()
+  external int heapEndBytes;
+  @Uint64()
+  external int heapAvgBytes;
+  @Uint64()
+  external int heapPeakBytes;
+  @Int32()
+  external int heapSupported;
+}
+
+// nc_mem_sampler* nc_mem_sampler_new(unsigned int rate_hz)
+typedef MemSamplerNewNative = Pointer<Void> Function(Uint32 rateHz);
+typedef MemSamplerNewDart = Pointer<Void> Function(int rateHz);
+
+// int nc_mem_sampler_begin(nc_mem_sampler* sampler)
+typedef MemSamplerBeginNative = Int32 Function(Pointer<Void> sampler);
+typedef MemSamplerBeginDart = int Function(Pointer<Void> sampler);
+
+// int nc_mem_sampler_end(nc_mem_sampler* sampler, nc_mem_stats* out_stats)
+typedef MemSamplerEndNative = Int32 Function(
+    Pointer<Void> sampler, Pointer<NcMemStats> outStats);
+typedef MemSamplerEndDart = int Function(
+    Pointer<Void> sampler, Pointer<NcMemStats> outStats);
+
+// void nc_mem_sampler_free(nc_mem_sampler* sampler)
+typedef MemSamplerFreeNative = Void Function(Pointer<Void> sampler);
+typedef MemSamplerFreeDart = void Function(Pointer<Void> sampler);
+
+// --- FFI type definitions for the buffer pool API ---
+
+// void* nc_buf_acquire(size_t size)
+typedef BufAcquireNative = Pointer<Uint8> Function(Size size);
+typedef BufAcquireDart = Pointer<Uint8> Function(int size);
+
+// void nc_buf_release(void* buf)
+typedef BufReleaseNative = Void Function(Pointer<Uint8> buf);
+typedef BufReleaseDart = void Function(Pointer<Uint8> buf);
+
+// void nc_buf_release_wipe(void* buf, size_t wipe_len)
+typedef BufReleaseWipeNative = Void Function(Pointer<Uint8> buf, Size wipeLen);
+typedef BufReleaseWipeDart = void Function(Pointer<Uint8> buf, int wipeLen);
+
+// --- FFI type definitions for the asynchronous API ---
+
+// Operation codes (NC_ASYNC_SEAL / NC_ASYNC_OPEN in native_crypto.h).
+const int ncAsyncSeal = 0;
+const int ncAsyncOpen = 1;
+
+// int nc_async_set_dart_post(void* post_cobject)
+typedef AsyncSetDartPostNative = Int32 Function(Pointer<Void> postCObject);
+typedef AsyncSetDartPostDart = int Function(Pointer<Void> postCObject);
+
+// int nc_async_submit_port(...)
+typedef AsyncSubmitPortNative = Int32 Function(
+    Pointer<Void> ctx,
+    Int32 operation,
+    Pointer<Uint8> input,
+    IntPtr inputLen,
+    Pointer<Uint8> nonce,
+    IntPtr nonceLen,
+    Pointer<Uint8> aad,
+    IntPtr aadLen,
+    Pointer<Uint8> output,
+    Int64 requestId,
+    Int64 dartPort);
+typedef AsyncSubmitPortDart = int Function(
+    Pointer<Void> ctx,
+    int operation,
+    Pointer<Uint8> input,
+    int inputLen,
+    Pointer<Uint8> nonce,
+    int nonceLen,
+    Pointer<Uint8> aad,
+    int aadLen,
+    Pointer<Uint8> output,
+    int requestId,
+    int dartPort);
+
+/// Native memory owned by one in-flight asynchronous operation.
+class _AsyncRequest {
+  final Completer<(Uint8List?, NativeThreadUsage?)> completer = Completer();
+  final Pointer<Void> ctx;
+  final Pointer<Uint8> buffer;
+  final Pointer<Uint8> nonce;
+  final Pointer<Uint8> aad;
+  final bool isEncrypt;
+  final int length; // Input length; the buffer holds plaintext up to here.
+
+  _AsyncRequest(
+      this.ctx, this.buffer, this.nonce, this.aad, this.isEncrypt, this.length);
+}
+
+/// Memory statistics of one sampled phase, in bytes.
+class NativeMemoryStats {
+  final int samples;
+  final int rssAverage;
+  final int rssPeak;
+  final int rssStart;
+
+  /// Heap bytes in use (malloc); null if the C library has no mallinfo.
+  final int? heapPeak;
+  final int? heapStart;
+
+  const NativeMemoryStats({
+    required this.samples,
+    required this.rssAverage,
+    required this.rssPeak,
+    required this.rssStart,
+    this.heapPeak,
+    this.heapStart,
+  });
+}
+
+/// A native background thread that samples RSS and heap usage at a fixed
+/// rate between [begin] and [end], catching peaks that sampling from Dart
+/// between operations misses. Call [dispose] when done.
+class NativeMemorySampler {
+  final Pointer<Void> _handle;
+  final MemSamplerBeginDart _begin;
+  final MemSamplerEndDart _end;
+  final MemSamplerFreeDart _free;
+
+  NativeMemorySampler._(this._handle, this._begin, this._end, this._free);
+
+  /// Starts a sampled phase. Returns false if a phase is already running.
+  bool begin() => _begin(_handle) == 0;
+
+  /// Ends the sampled phase and returns its statistics (null if no phase ran).
+  NativeMemoryStats? end() {
+    final statsPtr = calloc<NcMemStats>();
+    try {
+      if (_end(_handle, statsPtr) != 0) return null;
+      final stats = statsPtr.ref;
+      final hasHeap = stats.heapSupported != 0;
+      return NativeMemoryStats(
+        samples: stats.samples,
+        rssAverage: stats.rssAvgBytes,
+        rssPeak: stats.rssPeakBytes,
+        rssStart: stats.rssStartBytes,
+        heapPeak: hasHeap ? stats.heapPeakBytes : null,
+        heapStart: hasHeap ? stats.heapStartBytes : null,
+      );
+    } finally {
+      calloc.free(statsPtr);
+    }
+  }
+
+  /// Stops the sampler thread and releases it.
+  void dispose() => _free(_handle);
+}
+
 /// Cryptographic service for FFI (Foreign Function Interface) calls
 /// to the native C library.
 class FfiCryptoService {
@@ -97,6 +458,36 @@ class FfiCryptoService {
   late DecryptAesGcmDart _decryptAesGcm;
   late EncryptChaChaDart _encryptChaCha;
   late DecryptChaChaDart _decryptChaCha;
+  late AeadCtxNewDart _aeadCtxNew;
+  late AeadCtxFreeDart _aeadCtxFree;
+  late AeadBatchDart _sealBatch;
+  late AeadBatchDart _openBatch;
+  late GenerateNoncesDart _generateNonces;
+  late SealAutoNonceDart _sealAutoNonce;
+  late FillRandomDart _fillRandom;
+  late CpuFeaturesGetDart _cpuFeaturesGet;
+  late AlgorithmAutoDart _algorithmAuto;
+  late FileProcessDart _fileSeal;
+  late FileProcessDart _fileOpen;
+  late ThreadUsageGetDart _threadUsageGet;
+  late MemSamplerNewDart _memSamplerNew;
+  late MemSamplerBeginDart _memSamplerBegin;
+  late MemSamplerEndDart _memSamplerEnd;
+  late MemSamplerFreeDart _memSamplerFree;
+  late BufAcquireDart _bufAcquire;
+  late BufReleaseDart _bufRelease;
+  late BufReleaseWipeDart _bufReleaseWipe;
+  late AsyncSubmitPortDart _asyncSubmitPort;
+
+  // Completions of the asynchronous API arrive on this port (opened while
+  // operations are in flight), keyed by request id.
+  RawReceivePort? _asyncPort;
+  final Map<int, _AsyncRequest> _asyncRequests = {};
+  int _nextAsyncRequestId = 0;
+
+  /// Usage of the calling thread inside the last single-shot native call
+  /// (encrypt/decrypt wrappers), or null if it could not be measured.
+  NativeThreadUsage? lastCallUsage;
 
   /// Constructor that loads the native library and looks up functions.
   FfiCryptoService() {
@@ -122,6 +513,138 @@ class FfiCryptoService {
         .lookup<NativeFunction<DecryptChaChaNative>>(
             "decrypt_chacha20_poly1305")
         .asFunction<DecryptChaChaDart>();
+
+    // Look up the handle-based and batch functions
+    _aeadCtxNew = nativeLib
+        .lookup<NativeFunction<AeadCtxNewNative>>("nc_aead_ctx_new")
+        .asFunction<AeadCtxNewDart>();
+    _aeadCtxFree = nativeLib
+        .lookup<NativeFunction<AeadCtxFreeNative>>("nc_aead_ctx_free")
+        .asFunction<AeadCtxFreeDart>();
+    _sealBatch = nativeLib
+        .lookup<NativeFunction<AeadBatchNative>>("nc_aead_seal_batch")
+        .asFunction<AeadBatchDart>();
+    _openBatch = nativeLib
+        .lookup<NativeFunction<AeadBatchNative>>("nc_aead_open_batch")
+        .asFunction<AeadBatchDart>();
+
+    // Look up the nonce generation functions
+    _generateNonces = nativeLib
+        .lookup<NativeFunction<GenerateNoncesNative>>("nc_aead_generate_nonces")
+        .asFunction<GenerateNoncesDart>();
+    _sealAutoNonce = nativeLib
+        .lookup<NativeFunction<SealAutoNonceNative>>("nc_aead_seal_auto_nonce")
+        .asFunction<SealAutoNonceDart>();
+    _fillRandom = nativeLib
+        .lookup<NativeFunction<FillRandomNative>>("nc_fill_random")
+        .asFunction<FillRandomDart>();
+
+    // Look up the CPU capability and automatic selection functions
+    _cpuFeaturesGet = nativeLib
+        .lookup<NativeFunction<CpuFeaturesGetNative>>("nc_cpu_features_get")
+        .asFunction<CpuFeaturesGetDart>();
+    _algorithmAuto = nativeLib
+        .lookup<NativeFunction<AlgorithmAutoNative>>("nc_algorithm_auto")
+        .asFunction<AlgorithmAutoDart>();
+
+    // Look up the file functions
+    _fileSeal = nativeLib
+        .lookup<NativeFunction<FileProcessNative>>("nc_file_seal")
+        .asFunction<FileProcessDart>();
+    _fileOpen = nativeLib
+        .lookup<NativeFunction<FileProcessNative>>("nc_file_open")
+        .asFunction<FileProcessDart>();
+
+    // Look up the thread resource usage function
+    _threadUsageGet = nativeLib
+        .lookup<NativeFunction<ThreadUsageGetNative>>("nc_thread_usage_get")
+        .asFunction<ThreadUsageGetDart>();
+
+    // Look up the memory sampler functions
+    _memSamplerNew = nativeLib
+        .lookup<NativeFunction<MemSamplerNewNative>>("nc_mem_sampler_new")
+        .asFunction<MemSamplerNewDart>();
+    _memSamplerBegin = nativeLib
+        .lookup<NativeFunction<MemSamplerBeginNative>>("nc_mem_sampler_begin")
+        .asFunction<MemSamplerBeginDart>();
+    _memSamplerEnd = nativeLib
+        .lookup<NativeFunction<MemSamplerEndNative>>("nc_mem_sampler_end")
+        .asFunction<MemSamplerEndDart>();
+    _memSamplerFree = nativeLib
+        .lookup<NativeFunction<MemSamplerFreeNative>>("nc_mem_sampler_free")
+        .asFunction<MemSamplerFreeDart>();
+
+    // Look up the buffer pool functions used for every argument buffer
+    _bufAcquire = nativeLib
+        .lookup<NativeFunction<BufAcquireNative>>("nc_buf_acquire")
+        .asFunction<BufAcquireDart>();
+    _bufRelease = nativeLib
+        .lookup<NativeFunction<BufReleaseNative>>("nc_buf_release")
+        .asFunction<BufReleaseDart>();
+    _bufReleaseWipe = nativeLib
+        .lookup<NativeFunction<BufReleaseWipeNative>>("nc_buf_release_wipe")
+        .asFunction<BufReleaseWipeDart>();
+
+    // Look up the asynchronous API and let it post to Dart ports
+    _asyncSubmitPort = nativeLib
+        .lookup<NativeFunction<AsyncSubmitPortNative>>("nc_async_submit_port")
+        .asFunction<AsyncSubmitPortDart>();
+    nativeLib
+        .lookup<NativeFunction<AsyncSetDartPostNative>>(
+            "nc_async_set_dart_post")
+        .asFunction<AsyncSetDartPostDart>()(NativeApi.postCObject.cast());
+  }
+
+  /// Samples the resource usage of the calling thread.
+  /// Returns null if the native call failed entirely.
+  NativeThreadUsage? sampleThreadUsage() {
+    final usagePtr = calloc<NcThreadUsage>();
+    try {
+      return _readThreadUsage(usagePtr);
+    } finally {
+      calloc.free(usagePtr);
+    }
+  }
+
+  /// Fills [usagePtr] with a native sample and converts it to Dart.
+  NativeThreadUsage? _readThreadUsage(Pointer<NcThreadUsage> usagePtr) {
+    final status = _threadUsageGet(usagePtr);
+    if (status != 0 && status != ncErrUnsupported) return null;
+    final usage = usagePtr.ref;
+    return NativeThreadUsage(
+      cpuTimeNs: usage.cpuTimeNs,
+      minorFaults: usage.minorFaults,
+      majorFaults: usage.majorFaults,
+      voluntarySwitches: usage.voluntarySwitches,
+      involuntarySwitches: usage.involuntarySwitches,
+      hasRusage: status == 0,
+    );
+  }
+
+  /// Starts a native memory sampler thread ([rateHz] samples per second while
+  /// a phase runs). Returns null where it is unavailable (e.g. Windows).
+  NativeMemorySampler? createMemorySampler({int rateHz = 1000}) {
+    final handle = _memSamplerNew(rateHz);
+    if (handle == nullptr) return null;
+    return NativeMemorySampler._(
+        handle, _memSamplerBegin, _memSamplerEnd, _memSamplerFree);
+  }
+
+  /// Runs one native call and records the thread usage it caused in
+  /// [lastCallUsage], so the buffer copies around the call are not counted.
+  int _measuredCall(int Function() call) {
+    // Both samples share one allocation made outside the measured region.
+    final usagePtr = calloc<NcThreadUsage>();
+    try {
+      final before = _readThreadUsage(usagePtr);
+      final result = call();
+      final after = _readThreadUsage(usagePtr);
+      lastCallUsage =
+          (before != null && after != null) ? after - before : null;
+      return result;
+    } finally {
+      calloc.free(usagePtr);
+    }
   }
 
   /// Helper to load the native library based on the platform.
@@ -154,26 +677,42 @@ class FfiCryptoService {
   }
 
   /// Helper function to allocate C memory and copy data from a Uint8List.
-  /// Returns a pointer that MUST be freed by calloc.free()!
-  Pointer<Uint8> _allocatePointerFromList(Uint8List list) {
-    final ptr = calloc.allocate<Uint8>(list.length);
+  /// [capacity] reserves extra room after the data (e.g. for an in-place
+  /// encryption that appends a tag); it defaults to the list length.
+  /// Returns a pointer that MUST be released by _releaseBuffer()!
+  Pointer<Uint8> _allocatePointerFromList(Uint8List list, {int? capacity}) {
+    final ptr = _allocateBuffer(capacity ?? list.length);
     // Copy data from the Dart list to C memory
     ptr.asTypedList(list.length).setAll(0, list);
     return ptr;
   }
 
-  /// Helper function to allocate an empty C buffer of a given size.
-  /// Returns a pointer that MUST be freed by calloc.free()!
+  /// Helper function to allocate an uninitialized C buffer of a given size.
+  /// Buffers come from the native pool (nc_buf_acquire), which reuses
+  /// released buffers of the same size class instead of allocating and
+  /// freeing on every call. The contents are not zeroed: callers always
+  /// overwrite them before the native function reads them.
+  /// Returns a pointer that MUST be released by _releaseBuffer()!
   Pointer<Uint8> _allocateBuffer(int size) {
-    // calloc initializes memory to zeros, which is safer.
     // Check if size is negative (though Dart should catch this earlier).
     if (size < 0) throw ArgumentError("Buffer size cannot be negative");
-    // If size is 0, allocating 1 byte is safer to get a valid pointer for free().
-    // However, C functions might not expect zero-length buffers.
-    // For this use case, if plaintext.length is 0, outBufferSize will be 16.
-    // If decrypting only a tag (16B), outBufferSize could be 0.
-    // C functions should handle 0-length output gracefully or return an error.
-    return calloc.allocate<Uint8>(size > 0 ? size : 1);
+    // A size of 0 still returns a valid buffer of the smallest class.
+    final ptr = _bufAcquire(size);
+    if (ptr == nullptr) throw const OutOfMemoryError();
+    return ptr;
+  }
+
+  /// Returns a buffer from _allocateBuffer() to the native pool.
+  /// [wipeLength] bytes are cleared first for buffers that held a secret,
+  /// i.e. a key or plaintext (pooled buffers are reused as they are). The
+  /// wipe runs natively as one OPENSSL_cleanse, not as a Dart-side loop.
+  void _releaseBuffer(Pointer<Uint8> ptr, {int wipeLength = 0}) {
+    if (ptr == nullptr) return;
+    if (wipeLength > 0) {
+      _bufReleaseWipe(ptr, wipeLength);
+    } else {
+      _bufRelease(ptr);
+    }
   }
 
   // --- Wrappers for C functions (AES-GCM) ---
@@ -187,8 +726,11 @@ class FfiCryptoService {
       return null;
     }
 
-    // 1. Allocate C memory for input data
-    final plainTextPtr = _allocatePointerFromList(plainText);
+    // 1. Allocate one C buffer for the plaintext with room for the tag
+    // (16 bytes for GCM); encryption runs in place, so no separate output
+    // buffer is needed.
+    final bufferPtr =
+        _allocatePointerFromList(plainText, capacity: plainText.length + 16);
     final keyPtr = _allocatePointerFromList(key);
     final noncePtr = _allocatePointerFromList(nonce);
     Pointer<Uint8> aadPtr =
@@ -199,30 +741,25 @@ class FfiCryptoService {
       aadLen = aad.length;
     }
 
-    // 2. Allocate C memory for output data
-    // Output buffer = ciphertext + tag (16 bytes for GCM)
-    final outBufferSize = plainText.length + 16;
-    final outPtr = _allocateBuffer(outBufferSize);
-
     Uint8List? resultData; // Resulting Dart byte list
 
     try {
-      // 3. Call the C function via FFI
-      final resultLen = _encryptAesGcm(
-          plainTextPtr,
+      // 2. Call the C function via FFI
+      final resultLen = _measuredCall(() => _encryptAesGcm(
+          bufferPtr,
           plainText.length,
           keyPtr,
           noncePtr,
           nonce.length,
           aadPtr,
           aadLen,
-          outPtr); // Pass the pointer to the output buffer
+          bufferPtr)); // Output aliases the input (in-place)
 
-      // 4. Process the result
+      // 3. Process the result
       if (resultLen >= 0) {
         // Success, copy the result from C memory to Uint8List
         // Copy only as many bytes as the C function returned
-        resultData = Uint8List.fromList(outPtr.asTypedList(resultLen));
+        resultData = Uint8List.fromList(bufferPtr.asTypedList(resultLen));
       } else {
         // Error reported by the C function (e.g., < 0)
         print(
@@ -234,14 +771,13 @@ class FfiCryptoService {
       print("FFI call error (encryptAesGcm): $e");
       resultData = null;
     } finally {
-      // 5. ALWAYS free the allocated C memory!
-      calloc.free(plainTextPtr);
-      calloc.free(keyPtr);
-      calloc.free(noncePtr);
-      if (aadPtr != nullptr) {
-        calloc.free(aadPtr);
-      }
-      calloc.free(outPtr);
+      // 4. ALWAYS return the C buffers to the pool!
+      // The buffer still holds the plaintext unless the seal succeeded.
+      _releaseBuffer(bufferPtr,
+          wipeLength: resultData == null ? plainText.length : 0);
+      _releaseBuffer(keyPtr, wipeLength: key.length);
+      _releaseBuffer(noncePtr);
+      _releaseBuffer(aadPtr);
     }
     return resultData;
   }
@@ -255,8 +791,9 @@ class FfiCryptoService {
       return null;
     }
 
-    // 1. Allocate C memory for inputs
-    final ciphertextTagPtr = _allocatePointerFromList(ciphertextTag);
+    // 1. Allocate one C buffer for the ciphertext and tag; decryption runs in
+    // place and leaves the plaintext at the start of the same buffer.
+    final bufferPtr = _allocatePointerFromList(ciphertextTag);
     final keyPtr = _allocatePointerFromList(key);
     final noncePtr = _allocatePointerFromList(nonce);
     Pointer<Uint8> aadPtr = nullptr;
@@ -266,27 +803,24 @@ class FfiCryptoService {
       aadLen = aad.length;
     }
 
-    // 2. Allocate C memory for output (plaintext)
-    // Max possible size = input size (ciphertext without tag)
+    // Max possible plaintext size = input size without the tag
     final outBufferSize = ciphertextTag.length - 16;
-    // If outBufferSize is 0 (e.g., ciphertextTag only contains the tag), allocate a minimal buffer.
-    // The C function should return 0 for empty plaintext or an error.
-    final outPtr = _allocateBuffer(outBufferSize < 0 ? 0 : outBufferSize);
 
     Uint8List? resultData;
 
     try {
-      // 3. Call the C function
-      final resultLen = _decryptAesGcm(ciphertextTagPtr, ciphertextTag.length,
-          keyPtr, noncePtr, nonce.length, aadPtr, aadLen, outPtr);
+      // 2. Call the C function
+      final resultLen = _measuredCall(() => _decryptAesGcm(bufferPtr,
+          ciphertextTag.length, keyPtr, noncePtr, nonce.length, aadPtr, aadLen,
+          bufferPtr));
 
-      // 4. Process the result
+      // 3. Process the result
       if (resultLen >= 0) {
         // Success, copy the result
         // Ensure we don't read beyond the allocated buffer, though resultLen should be <= outBufferSize
         final safeResultLen =
             resultLen > outBufferSize ? outBufferSize : resultLen;
-        resultData = Uint8List.fromList(outPtr.asTypedList(safeResultLen));
+        resultData = Uint8List.fromList(bufferPtr.asTypedList(safeResultLen));
       } else {
         // Error from C (e.g., -2 for tag mismatch)
         print(
@@ -297,14 +831,12 @@ class FfiCryptoService {
       print("FFI call error (decryptAesGcm): $e");
       resultData = null;
     } finally {
-      // 5. Free C memory
-      calloc.free(ciphertextTagPtr);
-      calloc.free(keyPtr);
-      calloc.free(noncePtr);
-      if (aadPtr != nullptr) {
-        calloc.free(aadPtr);
-      }
-      calloc.free(outPtr);
+      // 4. Return C memory to the pool
+      // After an in-place open the buffer holds the plaintext.
+      _releaseBuffer(bufferPtr, wipeLength: ciphertextTag.length);
+      _releaseBuffer(keyPtr, wipeLength: key.length);
+      _releaseBuffer(noncePtr);
+      _releaseBuffer(aadPtr);
     }
     return resultData;
   }
@@ -318,8 +850,10 @@ class FfiCryptoService {
       return null;
     }
 
-    // 1. Allocate C memory for inputs
-    final plainTextPtr = _allocatePointerFromList(plainText);
+    // 1. Allocate one C buffer for the plaintext with room for the tag
+    // (16 bytes for Poly1305); encryption runs in place.
+    final bufferPtr =
+        _allocatePointerFromList(plainText, capacity: plainText.length + 16);
     final keyPtr = _allocatePointerFromList(key);
     final noncePtr = _allocatePointerFromList(nonce);
     Pointer<Uint8> aadPtr = nullptr;
@@ -329,29 +863,24 @@ class FfiCryptoService {
       aadLen = aad.length;
     }
 
-    // 2. Allocate C memory for output
-    // Output buffer = ciphertext + tag (16 bytes for Poly1305)
-    final outBufferSize = plainText.length + 16;
-    final outPtr = _allocateBuffer(outBufferSize);
-
     Uint8List? resultData;
 
     try {
-      // 3. Call the C function
-      final resultLen = _encryptChaCha(
+      // 2. Call the C function
+      final resultLen = _measuredCall(() => _encryptChaCha(
           // Call the correct C function
-          plainTextPtr,
+          bufferPtr,
           plainText.length,
           keyPtr,
           noncePtr,
           nonce.length,
           aadPtr,
           aadLen,
-          outPtr);
+          bufferPtr)); // Output aliases the input (in-place)
 
-      // 4. Process the result
+      // 3. Process the result
       if (resultLen >= 0) {
-        resultData = Uint8List.fromList(outPtr.asTypedList(resultLen));
+        resultData = Uint8List.fromList(bufferPtr.asTypedList(resultLen));
       } else {
         print(
             "FFI C function encrypt_chacha20_poly1305 returned error code: $resultLen");
@@ -361,14 +890,13 @@ class FfiCryptoService {
       print("FFI call error (encryptChaCha): $e");
       resultData = null;
     } finally {
-      // 5. Free C memory
-      calloc.free(plainTextPtr);
-      calloc.free(keyPtr);
-      calloc.free(noncePtr);
-      if (aadPtr != nullptr) {
-        calloc.free(aadPtr);
-      }
-      calloc.free(outPtr);
+      // 4. Return C memory to the pool
+      // The buffer still holds the plaintext unless the seal succeeded.
+      _releaseBuffer(bufferPtr,
+          wipeLength: resultData == null ? plainText.length : 0);
+      _releaseBuffer(keyPtr, wipeLength: key.length);
+      _releaseBuffer(noncePtr);
+      _releaseBuffer(aadPtr);
     }
     return resultData;
   }
@@ -382,8 +910,9 @@ class FfiCryptoService {
       return null;
     }
 
-    // 1. Allocate C memory for inputs
-    final ciphertextTagPtr = _allocatePointerFromList(ciphertextTag);
+    // 1. Allocate one C buffer for the ciphertext and tag; decryption runs in
+    // place and leaves the plaintext at the start of the same buffer.
+    final bufferPtr = _allocatePointerFromList(ciphertextTag);
     final keyPtr = _allocatePointerFromList(key);
     final noncePtr = _allocatePointerFromList(nonce);
     Pointer<Uint8> aadPtr = nullptr;
@@ -393,29 +922,28 @@ class FfiCryptoService {
       aadLen = aad.length;
     }
 
-    // 2. Allocate C memory for output (plaintext)
+    // Max possible plaintext size = input size without the tag
     final outBufferSize = ciphertextTag.length - 16;
-    final outPtr = _allocateBuffer(outBufferSize < 0 ? 0 : outBufferSize);
     Uint8List? resultData;
 
     try {
-      // 3. Call the C function
-      final resultLen = _decryptChaCha(
+      // 2. Call the C function
+      final resultLen = _measuredCall(() => _decryptChaCha(
           // Call the correct C function
-          ciphertextTagPtr,
+          bufferPtr,
           ciphertextTag.length,
           keyPtr,
           noncePtr,
           nonce.length,
           aadPtr,
           aadLen,
-          outPtr);
+          bufferPtr)); // Output aliases the input (in-place)
 
-      // 4. Process the result
+      // 3. Process the result
       if (resultLen >= 0) {
         final safeResultLen =
             resultLen > outBufferSize ? outBufferSize : resultLen;
-        resultData = Uint8List.fromList(outPtr.asTypedList(safeResultLen));
+        resultData = Uint8List.fromList(bufferPtr.asTypedList(safeResultLen));
       } else {
         print(
             "FFI C function decrypt_chacha20_poly1305 returned error code: $resultLen");
@@ -425,15 +953,537 @@ class FfiCryptoService {
       print("FFI call error (decryptChaCha): $e");
       resultData = null;
     } finally {
-      // 5. Free C memory
-      calloc.free(ciphertextTagPtr);
-      calloc.free(keyPtr);
-      calloc.free(noncePtr);
-      if (aadPtr != nullptr) {
-        calloc.free(aadPtr);
-      }
-      calloc.free(outPtr);
+      // 4. Return C memory to the pool
+      // After an in-place open the buffer holds the plaintext.
+      _releaseBuffer(bufferPtr, wipeLength: ciphertextTag.length);
+      _releaseBuffer(keyPtr, wipeLength: key.length);
+      _releaseBuffer(noncePtr);
+      _releaseBuffer(aadPtr);
     }
     return resultData;
   }
+
+  // --- Batch wrappers ---
+
+  /// Encrypts every message in [messages] with one native context and a single
+  /// batch call, using `nonces[i]` for `messages[i]`.
+  ///
+  /// Returns one entry per message (null if that record failed), or null if the
+  /// batch could not be run at all.
+  List<Uint8List?>? encryptBatch(AlgorithmType algoType,
+      List<Uint8List> messages, Uint8List key, List<Uint8List> nonces,
+      {Uint8List? aad}) {
+    return _runBatch(true, algoType, messages, key, nonces, aad);
+  }
+
+  /// Decrypts every record in [ciphertextTags] with one native context and a
+  /// single batch call, using `nonces[i]` for `ciphertextTags[i]`.
+  ///
+  /// Returns one entry per record (null if that record failed authentication),
+  /// or null if the batch could not be run at all.
+  List<Uint8List?>? decryptBatch(AlgorithmType algoType,
+      List<Uint8List> ciphertextTags, Uint8List key, List<Uint8List> nonces,
+      {Uint8List? aad}) {
+    return _runBatch(false, algoType, ciphertextTags, key, nonces, aad);
+  }
+
+  /// Shared implementation of [encryptBatch] and [decryptBatch].
+  ///
+  /// All inputs are packed into one contiguous C buffer (and all outputs into
+  /// another) so the whole batch costs a fixed number of allocations.
+  List<Uint8List?>? _runBatch(bool isEncrypt, AlgorithmType algoType,
+      List<Uint8List> inputs, Uint8List key, List<Uint8List> nonces,
+      Uint8List? aad) {
+    if (key.length != 32 || inputs.length != nonces.length) {
+      print("FFI Error (Batch): Invalid key length or nonce count.");
+      return null;
+    }
+    if (nonces.any((nonce) => nonce.length != 12) ||
+        (!isEncrypt && inputs.any((input) => input.length < 16))) {
+      print("FFI Error (Batch): Invalid nonce/ciphertextTag length.");
+      return null;
+    }
+    final count = inputs.length;
+    if (count == 0) return <Uint8List?>[];
+
+    // Output size per record: + tag when sealing, - tag when opening.
+    final outLengths = [
+      for (final input in inputs)
+        isEncrypt ? input.length + 16 : input.length - 16
+    ];
+    final totalIn = inputs.fold<int>(0, (sum, input) => sum + input.length);
+    final totalOut = outLengths.fold<int>(0, (sum, len) => sum + len);
+
+    // 1. Allocate C memory for inputs, outputs, descriptors and statuses
+    final keyPtr = _allocatePointerFromList(key);
+    final inPtr = _allocateBuffer(totalIn);
+    final noncePtr = _allocateBuffer(count * 12);
+    final outPtr = _allocateBuffer(totalOut);
+    final itemsPtr = calloc<NcAeadBatchItem>(count);
+    final statusPtr = calloc<Int32>(count);
+    Pointer<Uint8> aadPtr = nullptr;
+    int aadLen = 0;
+    if (aad != null && aad.isNotEmpty) {
+      aadPtr = _allocatePointerFromList(aad);
+      aadLen = aad.length;
+    }
+    final algorithm = algoType == AlgorithmType.aesGcm
+        ? ncAlgAes256Gcm
+        : ncAlgChaCha20Poly1305;
+    final ctx = _aeadCtxNew(algorithm, keyPtr, key.length);
+
+    List<Uint8List?>? results;
+
+    try {
+      if (ctx == nullptr) {
+        print("FFI C function nc_aead_ctx_new failed.");
+        return null;
+      }
+
+      // 2. Copy inputs and fill in the descriptors
+      int inOffset = 0;
+      int outOffset = 0;
+      for (int i = 0; i < count; i++) {
+        (inPtr + inOffset).asTypedList(inputs[i].length).setAll(0, inputs[i]);
+        (noncePtr + i * 12).asTypedList(12).setAll(0, nonces[i]);
+        final item = (itemsPtr + i).ref;
+        item.input = inPtr + inOffset;
+        item.inputLen = inputs[i].length;
+        item.nonce = noncePtr + i * 12;
+        item.nonceLen = 12;
+        item.aad = aadPtr;
+        item.aadLen = aadLen;
+        item.output = outPtr + outOffset;
+        inOffset += inputs[i].length;
+        outOffset += outLengths[i];
+      }
+
+      // 3. One FFI crossing for the whole batch
+      final succeeded = isEncrypt
+          ? _sealBatch(ctx, itemsPtr, count, statusPtr)
+          : _openBatch(ctx, itemsPtr, count, statusPtr);
+      if (succeeded < 0) {
+        print("FFI C batch function returned error code: $succeeded");
+        return null;
+      }
+
+      // 4. Copy each successful record back to Dart
+      results = List<Uint8List?>.filled(count, null);
+      outOffset = 0;
+      for (int i = 0; i < count; i++) {
+        final status = statusPtr[i];
+        if (status >= 0) {
+          results[i] =
+              Uint8List.fromList((outPtr + outOffset).asTypedList(status));
+        }
+        outOffset += outLengths[i];
+      }
+    } catch (e) {
+      print("FFI call error (batch): $e");
+      results = null;
+    } finally {
+      // 5. Free the context and all C memory
+      if (ctx != nullptr) {
+        _aeadCtxFree(ctx);
+      }
+      _releaseBuffer(keyPtr, wipeLength: key.length);
+      // The plaintext side of the batch is the input when sealing and the
+      // output when opening.
+      _releaseBuffer(inPtr, wipeLength: isEncrypt ? totalIn : 0);
+      _releaseBuffer(noncePtr);
+      _releaseBuffer(outPtr, wipeLength: isEncrypt ? 0 : totalOut);
+      calloc.free(itemsPtr);
+      calloc.free(statusPtr);
+      _releaseBuffer(aadPtr);
+    }
+    return results;
+  }
+
+  // --- Wrappers for C functions (nonces) ---
+
+  /// Generates [count] random 12-byte nonces with one native call
+  /// (RAND_bytes), concatenated in the returned list.
+  ///
+  /// Returns null if the native generator failed.
+  Uint8List? generateNonces(int count) {
+    if (count <= 0) return Uint8List(0);
+    final outPtr = _allocateBuffer(count * ncNonceLen);
+    try {
+      final status = _generateNonces(nullptr, ncNonceRandom, outPtr, count);
+      if (status < 0) {
+        print("FFI C function nc_aead_generate_nonces returned error code: $status");
+        return null;
+      }
+      return Uint8List.fromList(outPtr.asTypedList(count * ncNonceLen));
+    } finally {
+      _releaseBuffer(outPtr);
+    }
+  }
+
+  /// Encrypts data with a natively generated random nonce, returned together
+  /// with the ciphertext so no separate nonce call is needed.
+  ///
+  /// Random nonces are used because the context only lives for this call; a
+  /// per-context counter (NC_NONCE_COUNTER) needs a long-lived context.
+  (Uint8List nonce, Uint8List ciphertextTag)? encryptWithGeneratedNonce(
+      AlgorithmType algoType, Uint8List plainText, Uint8List key,
+      {Uint8List? aad}) {
+    if (key.length != 32) {
+      print("FFI Error (Auto nonce): Invalid key length.");
+      return null;
+    }
+
+    // 1. Allocate C memory; the seal runs in place with room for the tag
+    final bufferPtr =
+        _allocatePointerFromList(plainText, capacity: plainText.length + 16);
+    final keyPtr = _allocatePointerFromList(key);
+    final noncePtr = _allocateBuffer(ncNonceLen);
+    Pointer<Uint8> aadPtr = nullptr;
+    int aadLen = 0;
+    if (aad != null && aad.isNotEmpty) {
+      aadPtr = _allocatePointerFromList(aad);
+      aadLen = aad.length;
+    }
+    final algorithm = algoType == AlgorithmType.aesGcm
+        ? ncAlgAes256Gcm
+        : ncAlgChaCha20Poly1305;
+    final ctx = _aeadCtxNew(algorithm, keyPtr, key.length);
+
+    (Uint8List, Uint8List)? result;
+
+    try {
+      if (ctx == nullptr) {
+        print("FFI C function nc_aead_ctx_new failed.");
+        return null;
+      }
+
+      // 2. One call generates the nonce and seals
+      final resultLen = _measuredCall(() => _sealAutoNonce(ctx, ncNonceRandom,
+          bufferPtr, plainText.length, aadPtr, aadLen, noncePtr, bufferPtr));
+      if (resultLen < 0) {
+        print(
+            "FFI C function nc_aead_seal_auto_nonce returned error code: $resultLen");
+        return null;
+      }
+      result = (
+        Uint8List.fromList(noncePtr.asTypedList(ncNonceLen)),
+        Uint8List.fromList(bufferPtr.asTypedList(resultLen)),
+      );
+    } catch (e) {
+      print("FFI call error (encryptWithGeneratedNonce): $e");
+      result = null;
+    } finally {
+      // 3. Free the context and all C memory
+      if (ctx != nullptr) {
+        _aeadCtxFree(ctx);
+      }
+      // The buffer still holds the plaintext unless the seal succeeded.
+      _releaseBuffer(bufferPtr,
+          wipeLength: result == null ? plainText.length : 0);
+      _releaseBuffer(keyPtr, wipeLength: key.length);
+      _releaseBuffer(noncePtr);
+      _releaseBuffer(aadPtr);
+    }
+    return result;
+  }
+
+  /// Returns [length] random bytes generated natively in one call.
+  ///
+  /// With a [seed], the bytes come from the seeded fast generator and are the
+  /// same on every device (for reproducible test inputs, never for keys);
+  /// without one they come from the system CSPRNG (RAND_bytes).
+  /// Returns null if the native generator failed.
+  Uint8List? randomBytes(int length, {int? seed}) {
+    if (length < 0) throw ArgumentError("Length cannot be negative");
+    final bufPtr = _allocateBuffer(length);
+    try {
+      final status = _fillRandom(bufPtr, length,
+          seed == null ? ncRandomCrypto : ncRandomSeeded, seed ?? 0);
+      if (status < 0) {
+        print("FFI C function nc_fill_random returned error code: $status");
+        return null;
+      }
+      return Uint8List.fromList(bufPtr.asTypedList(length));
+    } finally {
+      _releaseBuffer(bufPtr);
+    }
+  }
+
+  /// Describes the CPU features BoringSSL dispatches on and the AES-GCM and
+  /// ChaCha20 code paths they select, as one line for the benchmark log.
+  /// Returns null if the native query failed.
+  String? cpuFeatureReport() {
+    final featuresPtr = calloc<NcCpuFeatures>();
+    try {
+      if (_cpuFeaturesGet(featuresPtr) != 0) return null;
+      final f = featuresPtr.ref;
+      final flags = <String, int>{
+        "aes_hw": f.aesHardware,
+        "aesni": f.aesni,
+        "pclmulqdq": f.pclmulqdq,
+        "avx2": f.avx2,
+        "avx512": f.avx512,
+        "vaes": f.vaes,
+        "vpclmulqdq": f.vpclmulqdq,
+        "neon": f.neon,
+        "armv8_aes": f.armv8Aes,
+        "armv8_pmull": f.armv8Pmull,
+      }.entries.where((e) => e.value != 0).map((e) => e.key).join(",");
+      // The path names are inferred from the flags, not reported by BoringSSL.
+      return "expected AES-GCM: ${f.expectedAesGcmPath.toDartString()}, "
+          "expected ChaCha20: ${f.expectedChachaPath.toDartString()}, "
+          "asm: ${f.asmEnabled != 0}, features: [$flags]";
+    } finally {
+      calloc.free(featuresPtr);
+    }
+  }
+
+  /// Returns the algorithm NC_ALG_AUTO resolves to on this device: the faster
+  /// of AES-256-GCM and ChaCha20-Poly1305 in a short native calibration that
+  /// runs once per process (the first call takes a few milliseconds).
+  AlgorithmType autoAlgorithm() {
+    final selectionPtr = calloc<NcAutoSelection>();
+    try {
+      final algorithm = _algorithmAuto(selectionPtr);
+      final selection = selectionPtr.ref;
+      if (selection.calibrated != 0) {
+        final aes = selection.aesGcmMibPerS.toStringAsFixed(0);
+        final chacha = selection.chachaMibPerS.toStringAsFixed(0);
+        print("NC_ALG_AUTO calibration: AES-256-GCM $aes MiB/s, "
+            "ChaCha20-Poly1305 $chacha MiB/s");
+      }
+      return algorithm == ncAlgAes256Gcm
+          ? AlgorithmType.aesGcm
+          : AlgorithmType.chaChaPoly;
+    } finally {
+      calloc.free(selectionPtr);
+    }
+  }
+
+  // --- Wrappers for C functions (asynchronous) ---
+
+  /// Encrypts data on the native worker pool without blocking this isolate.
+  ///
+  /// Completes with the ciphertext (or null on failure) and the usage of the
+  /// worker thread during the crypto call itself.
+  Future<(Uint8List?, NativeThreadUsage?)> encryptAsync(
+      AlgorithmType algoType, Uint8List plainText, Uint8List key,
+      Uint8List nonce,
+      {Uint8List? aad}) {
+    return _runAsync(true, algoType, plainText, key, nonce, aad);
+  }
+
+  /// Decrypts data on the native worker pool without blocking this isolate.
+  ///
+  /// Completes with the plaintext (or null on failure, e.g. a wrong tag) and
+  /// the usage of the worker thread during the crypto call itself.
+  Future<(Uint8List?, NativeThreadUsage?)> decryptAsync(
+      AlgorithmType algoType, Uint8List ciphertextTag, Uint8List key,
+      Uint8List nonce,
+      {Uint8List? aad}) {
+    return _runAsync(false, algoType, ciphertextTag, key, nonce, aad);
+  }
+
+  /// Shared implementation of [encryptAsync] and [decryptAsync].
+  Future<(Uint8List?, NativeThreadUsage?)> _runAsync(
+      bool isEncrypt,
+      AlgorithmType algoType,
+      Uint8List input,
+      Uint8List key,
+      Uint8List nonce,
+      Uint8List? aad) {
+    if (key.length != 32 ||
+        nonce.length != 12 ||
+        (!isEncrypt && input.length < 16)) {
+      print("FFI Error (Async): Invalid key/nonce/ciphertextTag length.");
+      return Future.value((null, null));
+    }
+
+    // 1. Allocate C memory; the operation runs in place in one buffer with
+    // room for the tag. The context keeps its own copy of the key schedule,
+    // so the key buffer is released right away.
+    final bufferPtr = _allocatePointerFromList(input,
+        capacity: isEncrypt ? input.length + 16 : input.length);
+    final noncePtr = _allocatePointerFromList(nonce);
+    final keyPtr = _allocatePointerFromList(key);
+    Pointer<Uint8> aadPtr = nullptr;
+    int aadLen = 0;
+    if (aad != null && aad.isNotEmpty) {
+      aadPtr = _allocatePointerFromList(aad);
+      aadLen = aad.length;
+    }
+    final algorithm = algoType == AlgorithmType.aesGcm
+        ? ncAlgAes256Gcm
+        : ncAlgChaCha20Poly1305;
+    final ctx = _aeadCtxNew(algorithm, keyPtr, key.length);
+    _releaseBuffer(keyPtr, wipeLength: key.length);
+
+    final request = _AsyncRequest(
+        ctx, bufferPtr, noncePtr, aadPtr, isEncrypt, input.length);
+    if (ctx == nullptr) {
+      print("FFI C function nc_aead_ctx_new failed.");
+      _freeAsyncRequest(request);
+      return Future.value((null, null));
+    }
+
+    // 2. Queue the operation; the completion is posted to _asyncPort
+    final port = _asyncPort ??= RawReceivePort(_onAsyncCompletion);
+    final requestId = _nextAsyncRequestId++;
+    final status = _asyncSubmitPort(
+        ctx,
+        isEncrypt ? ncAsyncSeal : ncAsyncOpen,
+        bufferPtr,
+        input.length,
+        noncePtr,
+        nonce.length,
+        aadPtr,
+        aadLen,
+        bufferPtr,
+        requestId,
+        port.sendPort.nativePort);
+    if (status < 0) {
+      print("FFI C function nc_async_submit_port returned error code: $status");
+      _freeAsyncRequest(request);
+      _closeIdleAsyncPort();
+      return Future.value((null, null));
+    }
+    _asyncRequests[requestId] = request;
+    return request.completer.future;
+  }
+
+  /// Handles one completion message: [request_id, result, usage_status,
+  /// cpu_time_ns, minor_faults, major_faults, voluntary_switches,
+  /// involuntary_switches].
+  void _onAsyncCompletion(dynamic message) {
+    final values = (message as List).cast<int>();
+    final request = _asyncRequests.remove(values[0]);
+    if (request == null) return;
+
+    // 3. Copy the result back to Dart and release the C memory
+    final resultLen = values[1];
+    final usageStatus = values[2];
+    Uint8List? resultData;
+    if (resultLen >= 0) {
+      resultData =
+          Uint8List.fromList(request.buffer.asTypedList(resultLen));
+    } else {
+      print("FFI C async operation returned error code: $resultLen");
+    }
+    final usage = (usageStatus == 0 || usageStatus == ncErrUnsupported)
+        ? NativeThreadUsage(
+            cpuTimeNs: values[3],
+            minorFaults: values[4],
+            majorFaults: values[5],
+            voluntarySwitches: values[6],
+            involuntarySwitches: values[7],
+            hasRusage: usageStatus == 0,
+          )
+        : null;
+    _freeAsyncRequest(request, sealed: request.isEncrypt && resultLen >= 0);
+    _closeIdleAsyncPort();
+    request.completer.complete((resultData, usage));
+  }
+
+  /// Frees the context and C memory of an asynchronous operation. The buffer
+  /// is wiped unless a successful seal [sealed] replaced the plaintext.
+  void _freeAsyncRequest(_AsyncRequest request, {bool sealed = false}) {
+    if (request.ctx != nullptr) {
+      _aeadCtxFree(request.ctx);
+    }
+    _releaseBuffer(request.buffer, wipeLength: sealed ? 0 : request.length);
+    _releaseBuffer(request.nonce);
+    _releaseBuffer(request.aad);
+  }
+
+  /// Closes the completion port once nothing is in flight, so it does not
+  /// keep the isolate alive.
+  void _closeIdleAsyncPort() {
+    if (_asyncRequests.isNotEmpty) return;
+    _asyncPort?.close();
+    _asyncPort = null;
+  }
+
+  // --- Wrappers for C functions (files) ---
+
+  /// Encrypts the file at [inPath] into [outPath] in the segmented format.
+  /// The file is memory-mapped natively and never copied into the Dart heap.
+  ///
+  /// Returns the size of the output file, or null on failure.
+  int? encryptFile(AlgorithmType algoType, String inPath, String outPath,
+      Uint8List key, Uint8List noncePrefix,
+      {Uint8List? aad, int segmentSize = 0}) {
+    return _runFile(true, algoType, inPath, outPath, key, noncePrefix, aad,
+        segmentSize);
+  }
+
+  /// Decrypts and verifies a file produced by [encryptFile] into [outPath].
+  /// On failure the native side removes [outPath].
+  ///
+  /// Returns the size of the plaintext file, or null on failure.
+  int? decryptFile(AlgorithmType algoType, String inPath, String outPath,
+      Uint8List key, Uint8List noncePrefix,
+      {Uint8List? aad, int segmentSize = 0}) {
+    return _runFile(false, algoType, inPath, outPath, key, noncePrefix, aad,
+        segmentSize);
+  }
+
+  /// Shared implementation of [encryptFile] and [decryptFile].
+  int? _runFile(bool isEncrypt, AlgorithmType algoType, String inPath,
+      String outPath, Uint8List key, Uint8List noncePrefix, Uint8List? aad,
+      int segmentSize) {
+    if (key.length != 32 || noncePrefix.length != ncSegmentNoncePrefixLen) {
+      print("FFI Error (File): Invalid key/nonce prefix length.");
+      return null;
+    }
+
+    // 1. Allocate C memory for the paths, key, nonce prefix and AAD
+    final inPathPtr = inPath.toNativeUtf8(allocator: calloc);
+    final outPathPtr = outPath.toNativeUtf8(allocator: calloc);
+    final keyPtr = _allocatePointerFromList(key);
+    final prefixPtr = _allocatePointerFromList(noncePrefix);
+    final outLenPtr = calloc<Uint64>();
+    Pointer<Uint8> aadPtr = nullptr;
+    int aadLen = 0;
+    if (aad != null && aad.isNotEmpty) {
+      aadPtr = _allocatePointerFromList(aad);
+      aadLen = aad.length;
+    }
+    final algorithm = algoType == AlgorithmType.aesGcm
+        ? ncAlgAes256Gcm
+        : ncAlgChaCha20Poly1305;
+    final ctx = _aeadCtxNew(algorithm, keyPtr, key.length);
+
+    int? result;
+
+    try {
+      if (ctx == nullptr) {
+        print("FFI C function nc_aead_ctx_new failed.");
+        return null;
+      }
+
+      // 2. One call processes the whole file natively
+      final status = (isEncrypt ? _fileSeal : _fileOpen)(ctx, inPathPtr,
+          outPathPtr, prefixPtr, aadPtr, aadLen, segmentSize, outLenPtr);
+      if (status < 0) {
+        print("FFI C file function returned error code: $status");
+        return null;
+      }
+      result = outLenPtr.value;
+    } catch (e) {
+      print("FFI call error (file): $e");
+      result = null;
+    } finally {
+      // 3. Free the context and all C memory
+      if (ctx != nullptr) {
+        _aeadCtxFree(ctx);
+      }
+      calloc.free(inPathPtr);
+      calloc.free(outPathPtr);
+      _releaseBuffer(keyPtr, wipeLength: key.length);
+      _releaseBuffer(prefixPtr);
+      calloc.free(outLenPtr);
+      _releaseBuffer(aadPtr);
+    }
+    return result;
+  }
 }
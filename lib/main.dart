@@ -1,7 +1,6 @@
 // ignore_for_file: avoid_print // For logs from BenchmarkService
 
 import 'dart:developer';
-import 'dart:math' show Random;
 
 import 'package:cryptography_benchmark_flutter/benchmark/benchmark_service.dart';
 // Imports of our files
@@ -202,7 +201,7 @@ class _BenchmarkPageState extends State<BenchmarkPage> {
     ];
 
     // Generate one set of random data for this suite
-    final testData = _generateRandomData(dataSize);
+    final testData = _benchmarkService.generateRandomData(dataSize);
 
     setState(() {
       _isLoading = true;
@@ -298,7 +297,7 @@ class _BenchmarkPageState extends State<BenchmarkPage> {
       for (int i = 0; i < repetitions; i++) {
         for (final size in dataSizes) {
           // For a given data size, generate the test data once per repetition
-          final testData = _generateRandomData(size);
+          final testData = _benchmarkService.generateRandomData(size);
 
           for (final impl in implementations) {
             for (final algo in algorithms) {
@@ -563,7 +562,7 @@ class _BenchmarkPageState extends State<BenchmarkPage> {
     // Add header row for the CSV
     // [ENGLISH] Updated the CSV header to include the new columns.
     buffer.writeln(
-        "Implementation;Algorithm;DataSize_B;Iterations;WallTime_Encrypt_ms;Stdev_Encrypt_ms;WallTime_Decrypt_ms;Stdev_Decrypt_ms;WallTime_Sum_ms;CPUTime_ms;RAM_Avg_MB;RAM_Peak_MB");
+        "Implementation;Algorithm;DataSize_B;Iterations;WallTime_Encrypt_ms;Stdev_Encrypt_ms;WallTime_Decrypt_ms;Stdev_Decrypt_ms;WallTime_Sum_ms;CPUTime_ms;RAM_Avg_MB;RAM_Peak_MB;NativeCPUTime_ms");
 
     // Reverse the list to show oldest results first in the export
     final reversedHistory = _resultsHistory.reversed;
@@ -575,11 +574,4 @@ class _BenchmarkPageState extends State<BenchmarkPage> {
     }
     return buffer.toString();
   }
-
-  // Generate random data for tests
-  Uint8List _generateRandomData(int sizeInBytes) {
-    final random = Random.secure();
-    return Uint8List.fromList(
-        List.generate(sizeInBytes, (_) => random.nextInt(256)));
-  }
 }
@@ -0,0 +1,177 @@
+// Asynchronous queue: submit -> complete round trip through the lock-free rings.
+//
+// Usage: native_crypto_async_bench [total_ops] [payload_bytes] [submit_batch] [queue_depth]
+//
+// 1, 2, 4 and 8 producer threads submit AES-256-GCM seals of payload_bytes (default 64, so the
+// queue rather than the cipher dominates) in batches of submit_batch requests; the main thread
+// reaps the completions. Latency is measured per request from just before its submit call to the
+// moment it was reaped; throughput counts completed operations per second of wall time.
+
+#include "native_crypto.h"
+#include "bench_common.h"
+
+#include <pthread.h> // For the producer threads
+#include <sched.h>   // For sched_yield
+#include <stdio.h>   // For printf, fprintf
+#include <stdlib.h>  // For malloc, free, qsort, strtoul
+
+static const size_t kProducerCounts[] = {1, 2, 4, 8};
+
+/**
+ * @brief State shared by the producers and the reaper of one run.
+ */
+typedef struct {
+    nc_aead_ctx* ctx;
+    nc_async_queue* queue;
+    const uint8_t* payload;
+    size_t payload_len;
+    uint8_t* outputs;       // payload_len + 16 bytes per operation.
+    uint64_t* submit_ns;    // Submit timestamp per operation.
+    size_t total_ops;
+    size_t num_producers;
+    size_t batch;
+} run_state;
+
+typedef struct {
+    run_state* run;
+    size_t index;
+} producer_arg;
+
+static void* producer_main(void* opaque) {
+    producer_arg* arg = (producer_arg*)opaque;
+    run_state* run = arg->run;
+    // Each producer owns a contiguous range of operation ids.
+    size_t first = arg->index * run->total_ops / run->num_producers;
+    size_t last = (arg->index + 1) * run->total_ops / run->num_producers;
+    uint8_t nonce[12] = {0};
+    nc_async_request* requests = (nc_async_request*)calloc(run->batch, sizeof(nc_async_request));
+    size_t next = first;
+
+    if (!requests) return NULL;
+    while (next < last) {
+        size_t count = last - next < run->batch ? last - next : run->batch;
+        uint64_t now = bench_now_ns();
+        size_t submitted;
+        size_t i;
+
+        for (i = 0; i < count; i++) {
+            nc_async_request* request = &requests[i];
+            request->ctx = run->ctx;
+            request->operation = NC_ASYNC_SEAL;
+            request->in = run->payload;
+            request->in_len = run->payload_len;
+            request->nonce = nonce;
+            request->nonce_len = sizeof(nonce);
+            request->aad = NULL;
+            request->aad_len = 0;
+            request->out = run->outputs + (next + i) * (run->payload_len + NC_AEAD_TAG_LEN);
+            request->request_id = (int64_t)(next + i);
+            run->submit_ns[next + i] = now;
+        }
+        submitted = nc_async_queue_submit(run->queue, requests, count);
+        next += submitted;
+        // The queue is full: let the dispatcher and the reaper catch up.
+        if (submitted < count) sched_yield();
+    }
+    free(requests);
+    return NULL;
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+int main(int argc, char** argv) {
+    size_t total_ops = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 200000;
+    size_t payload_len = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : 64;
+    size_t batch = argc > 3 ? (size_t)strtoul(argv[3], NULL, 10) : 16;
+    size_t depth = argc > 4 ? (size_t)strtoul(argv[4], NULL, 10) : NC_ASYNC_DEFAULT_QUEUE_DEPTH;
+    uint8_t key[32];
+    uint8_t* payload;
+    uint64_t* latency_ns;
+    nc_async_completion completions[256];
+    run_state run;
+    size_t p;
+    int status = 0;
+
+    if (total_ops == 0 || batch == 0) {
+        fprintf(stderr, "usage: %s [total_ops] [payload_bytes] [submit_batch] [queue_depth]\n", argv[0]);
+        return 2;
+    }
+    bench_fill_pattern(key, sizeof(key), 1);
+    payload = (uint8_t*)malloc(payload_len ? payload_len : 1);
+    run.outputs = (uint8_t*)malloc(total_ops * (payload_len + NC_AEAD_TAG_LEN));
+    run.submit_ns = (uint64_t*)malloc(total_ops * sizeof(uint64_t));
+    latency_ns = (uint64_t*)malloc(total_ops * sizeof(uint64_t));
+    run.ctx = nc_aead_ctx_new(NC_ALG_AES_256_GCM, key, sizeof(key));
+    if (!payload || !run.outputs || !run.submit_ns || !latency_ns || !run.ctx) {
+        fprintf(stderr, "setup failed\n");
+        return 1;
+    }
+    bench_fill_pattern(payload, payload_len, 2);
+    run.payload = payload;
+    run.payload_len = payload_len;
+    run.total_ops = total_ops;
+    run.batch = batch;
+
+    printf("Producers;Ops;PayloadBytes;SubmitBatch;QueueDepth;OpsPerSec;LatencyMean_us;LatencyP50_us;LatencyP99_us\n");
+    for (p = 0; p < sizeof(kProducerCounts) / sizeof(kProducerCounts[0]); p++) {
+        pthread_t threads[8];
+        producer_arg args[8];
+        size_t reaped = 0;
+        size_t failed = 0;
+        double sum_ns = 0;
+        uint64_t start;
+        uint64_t elapsed;
+        size_t i;
+
+        run.num_producers = kProducerCounts[p];
+        run.queue = nc_async_queue_new(depth);
+        if (!run.queue) {
+            fprintf(stderr, "nc_async_queue_new failed\n");
+            return 1;
+        }
+
+        start = bench_now_ns();
+        for (i = 0; i < run.num_producers; i++) {
+            args[i].run = &run;
+            args[i].index = i;
+            pthread_create(&threads[i], NULL, producer_main, &args[i]);
+        }
+        while (reaped < total_ops) {
+            size_t n = nc_async_queue_reap(run.queue, completions, 256, 1);
+            uint64_t now = bench_now_ns();
+
+            for (i = 0; i < n; i++) {
+                if (completions[i].result < 0) failed++;
+                latency_ns[reaped + i] = now - run.submit_ns[completions[i].request_id];
+            }
+            reaped += n;
+            // Nothing in flight yet: the producers are still starting.
+            if (n == 0) sched_yield();
+        }
+        elapsed = bench_now_ns() - start;
+        for (i = 0; i < run.num_producers; i++) pthread_join(threads[i], NULL);
+        nc_async_queue_free(run.queue);
+
+        if (failed > 0) {
+            fprintf(stderr, "%zu operations failed with %zu producers\n", failed, run.num_producers);
+            status = 1;
+            continue;
+        }
+        for (i = 0; i < total_ops; i++) sum_ns += (double)latency_ns[i];
+        qsort(latency_ns, total_ops, sizeof(uint64_t), compare_u64);
+        printf("%zu;%zu;%zu;%zu;%zu;%.0f;%.2f;%.2f;%.2f\n", run.num_producers, total_ops, payload_len, batch,
+               depth, (double)total_ops / ((double)elapsed / 1e9), sum_ns / (double)total_ops / 1e3,
+               (double)latency_ns[total_ops / 2] / 1e3, (double)latency_ns[total_ops * 99 / 100] / 1e3);
+    }
+
+    nc_aead_ctx_free(run.ctx);
+    free(latency_ns);
+    free(run.submit_ns);
+    free(run.outputs);
+    free(payload);
+    return status;
+}
@@ -0,0 +1,120 @@
+#ifndef NATIVE_CRYPTO_BENCH_COMMON_H
+#define NATIVE_CRYPTO_BENCH_COMMON_H
+
+// Small helpers shared by the standalone native benchmark executables.
+
+#include <math.h>   // For sqrt
+#include <stddef.h> // For size_t
+#include <stdint.h> // For uint8_t, uint64_t
+#include <stdio.h>  // For fopen, fgets, snprintf
+#include <string.h> // For strncmp, strchr, strlen
+#include <time.h>   // For clock_gettime
+#include <unistd.h> // For sysconf
+
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds.
+ */
+static inline uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Returns the CPU time consumed by the whole process, in nanoseconds.
+ */
+static inline uint64_t bench_process_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Returns the resident set size of the process in bytes (0 if /proc is unavailable).
+ */
+static inline uint64_t bench_rss_bytes(void) {
+    unsigned long size_pages = 0;
+    unsigned long resident_pages = 0;
+    FILE* file = fopen("/proc/self/statm", "r");
+
+    if (!file) return 0;
+    if (fscanf(file, "%lu %lu", &size_pages, &resident_pages) != 2) resident_pages = 0;
+    fclose(file);
+    return (uint64_t)resident_pages * (uint64_t)sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * @brief Writes a human-readable CPU model name from /proc/cpuinfo into buf ("unknown" if not found).
+ *
+ * x86 kernels report "model name"; ARM kernels usually only report "Hardware" or the CPU part number.
+ * Semicolons are replaced so the value can be used as a CSV field.
+ */
+static inline void bench_cpu_model(char* buf, size_t buf_len) {
+    static const char* kKeys[] = {"model name", "Hardware", "CPU part"};
+    char line[256];
+    size_t k;
+
+    snprintf(buf, buf_len, "unknown");
+    for (k = 0; k < sizeof(kKeys) / sizeof(kKeys[0]); k++) {
+        FILE* file = fopen("/proc/cpuinfo", "r");
+        int found = 0;
+
+        if (!file) return;
+        while (!found && fgets(line, sizeof(line), file)) {
+            char* value;
+            char* p;
+
+            if (strncmp(line, kKeys[k], strlen(kKeys[k])) != 0) continue;
+            value = strchr(line, ':');
+            if (!value) continue;
+            value++;
+            while (*value == ' ' || *value == '\t') value++;
+            value[strcspn(value, "\n")] = '\0';
+            for (p = value; *p; p++) {
+                if (*p == ';') *p = ',';
+            }
+            snprintf(buf, buf_len, "%s%s", k == 2 ? "CPU part " : "", value);
+            found = 1;
+        }
+        fclose(file);
+        if (found) return;
+    }
+}
+
+/**
+ * @brief Fills a buffer with a cheap deterministic pattern (the content does not affect AEAD speed).
+ */
+static inline void bench_fill_pattern(uint8_t* buf, size_t len, uint32_t seed) {
+    size_t i;
+    for (i = 0; i < len; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        buf[i] = (uint8_t)(seed >> 24);
+    }
+}
+
+/**
+ * @brief Converts bytes processed in a number of nanoseconds to MiB/s.
+ */
+static inline double bench_mib_per_s(size_t bytes, uint64_t ns) {
+    return ns ? ((double)bytes / (1024.0 * 1024.0)) / ((double)ns / 1e9) : 0.0;
+}
+
+/**
+ * @brief Computes the mean and the sample standard deviation (n - 1), matching BenchmarkService.
+ */
+static inline void bench_mean_stdev(const double* samples, size_t count, double* mean, double* stdev) {
+    double sum = 0.0;
+    double squares = 0.0;
+    size_t i;
+
+    *mean = 0.0;
+    *stdev = 0.0;
+    if (count == 0) return;
+    for (i = 0; i < count; i++) sum += samples[i];
+    *mean = sum / (double)count;
+    if (count < 2) return;
+    for (i = 0; i < count; i++) squares += (samples[i] - *mean) * (samples[i] - *mean);
+    *stdev = sqrt(squares / (double)(count - 1));
+}
+
+#endif // NATIVE_CRYPTO_BENCH_COMMON_H
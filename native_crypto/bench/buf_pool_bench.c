@@ -0,0 +1,116 @@
+// Per-call allocation overhead: calloc/free versus the native buffer pool.
+//
+// Usage: native_crypto_buf_pool_bench [iterations]
+//
+// Mirrors what the FFI wrappers do around every single-shot call: allocate the in-place
+// plaintext+tag buffer, the key and the nonce, copy the inputs in, encrypt with AES-256-GCM and
+// free everything again. "Alloc" columns time only the allocate/copy/free part; "Call" columns
+// time the whole sequence. Every size is warmed up first so the pool serves from its free lists.
+
+#include "native_crypto.h"
+#include "bench_common.h"
+
+#include <stdio.h>  // For printf, fprintf
+#include <stdlib.h> // For calloc, malloc, free, strtoul
+#include <string.h> // For memcpy
+
+static const size_t kSizes[] = {16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024, 4 * 1024 * 1024};
+
+// Allocation strategies under test.
+#define STRATEGY_CALLOC 0
+#define STRATEGY_POOL 1
+
+static void* strategy_alloc(int strategy, size_t size) {
+    return strategy == STRATEGY_POOL ? nc_buf_acquire(size) : calloc(1, size);
+}
+
+static void strategy_free(int strategy, void* buf) {
+    if (strategy == STRATEGY_POOL) {
+        nc_buf_release(buf);
+    } else {
+        free(buf);
+    }
+}
+
+/**
+ * @brief Runs `iterations` wrapper-like calls and returns the mean time per call in ns.
+ *
+ * @param encrypt 0 to skip the encryption and only time the buffer handling.
+ * @return The mean time, or 0 if an allocation or the encryption failed.
+ */
+static uint64_t time_calls(int strategy, int encrypt, const uint8_t* plaintext, size_t size,
+                           const uint8_t key[32], const uint8_t nonce[12], int iterations) {
+    uint64_t start = bench_now_ns();
+    int i;
+
+    for (i = 0; i < iterations; i++) {
+        uint8_t* buffer = (uint8_t*)strategy_alloc(strategy, size + NC_AEAD_TAG_LEN);
+        uint8_t* key_buf = (uint8_t*)strategy_alloc(strategy, 32);
+        uint8_t* nonce_buf = (uint8_t*)strategy_alloc(strategy, 12);
+        int failed = !buffer || !key_buf || !nonce_buf;
+
+        if (!failed) {
+            memcpy(buffer, plaintext, size);
+            memcpy(key_buf, key, 32);
+            memcpy(nonce_buf, nonce, 12);
+            if (encrypt) {
+                failed = encrypt_aes_gcm_256(buffer, size, key_buf, nonce_buf, 12, NULL, 0, buffer) < 0;
+            }
+        }
+        strategy_free(strategy, buffer);
+        strategy_free(strategy, key_buf);
+        strategy_free(strategy, nonce_buf);
+        if (failed) return 0;
+    }
+    return (bench_now_ns() - start) / (uint64_t)iterations;
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? (int)strtoul(argv[1], NULL, 10) : 200;
+    const size_t max_size = kSizes[sizeof(kSizes) / sizeof(kSizes[0]) - 1];
+    const uint8_t nonce[12] = {0};
+    uint8_t key[32];
+    uint8_t* plaintext;
+    size_t s;
+    int status = 0;
+
+    if (iterations <= 0) {
+        fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+        return 2;
+    }
+    plaintext = (uint8_t*)malloc(max_size);
+    if (!plaintext) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    bench_fill_pattern(key, sizeof(key), 1);
+    bench_fill_pattern(plaintext, max_size, 2);
+
+    printf("DataSize_B;Calloc_Alloc_ns;Pool_Alloc_ns;Calloc_Call_ns;Pool_Call_ns;Call_Speedup\n");
+    for (s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); s++) {
+        size_t size = kSizes[s];
+        uint64_t ns[2][2]; // [strategy][encrypt]
+        int strategy, encrypt;
+
+        for (strategy = 0; strategy < 2; strategy++) {
+            for (encrypt = 0; encrypt < 2; encrypt++) {
+                // Warm-up: fills the pool's free lists and faults in the allocator's arenas.
+                time_calls(strategy, encrypt, plaintext, size, key, nonce, 3);
+                ns[strategy][encrypt] = time_calls(strategy, encrypt, plaintext, size, key, nonce, iterations);
+            }
+        }
+        if (!ns[0][0] || !ns[0][1] || !ns[1][0] || !ns[1][1]) {
+            fprintf(stderr, "allocation or encryption failed at %zu B\n", size);
+            status = 1;
+            continue;
+        }
+        printf("%zu;%llu;%llu;%llu;%llu;%.2f\n", size,
+               (unsigned long long)ns[STRATEGY_CALLOC][0], (unsigned long long)ns[STRATEGY_POOL][0],
+               (unsigned long long)ns[STRATEGY_CALLOC][1], (unsigned long long)ns[STRATEGY_POOL][1],
+               (double)ns[STRATEGY_CALLOC][1] / (double)ns[STRATEGY_POOL][1]);
+    }
+
+    nc_buf_pool_trim();
+    free(plaintext);
+    return status;
+}
@@ -0,0 +1,161 @@
+// Fused seal-and-digest versus sealing and then hashing the plaintext in a second pass.
+//
+// Usage: native_crypto_digest_bench [max_mib] [min_seconds]
+//
+// For each algorithm and digest, messages of 64 KiB up to max_mib MiB (default 256) are sealed
+// into a separate output buffer by:
+//   - "two-pass": the _ex seal function, then nc_digest() over the plaintext,
+//   - "fused": nc_seal_digest() at several tile sizes.
+// Both produce identical ciphertexts and digests (checked once per size). Each mode is repeated
+// until min_seconds (default 0.25) have elapsed; throughput counts plaintext bytes.
+
+#include "native_crypto.h"
+#include "bench_common.h"
+
+#include <stdio.h>  // For printf, fprintf
+#include <stdlib.h> // For malloc, free, strtod, strtoul
+#include <string.h> // For memcmp
+
+#define KIB ((size_t)1024)
+#define MIB (KIB * KIB)
+
+typedef struct {
+    const char* name;
+    int id;
+} named_id;
+
+static const named_id kAlgorithms[] = {
+    {"AES-256-GCM", NC_ALG_AES_256_GCM},
+    {"ChaCha20-Poly1305", NC_ALG_CHACHA20_POLY1305},
+};
+
+static const named_id kDigests[] = {
+    {"SHA-256", NC_DIGEST_SHA256},
+    {"BLAKE2b-256", NC_DIGEST_BLAKE2B_256},
+};
+
+static const size_t kTileSizes[] = {4 * KIB, 16 * KIB, 64 * KIB, 256 * KIB};
+
+/**
+ * @brief Seals with the stateless _ex function of the algorithm, then digests the plaintext.
+ */
+static int two_pass(int algorithm, int digest, const uint8_t* key, const uint8_t* plaintext, size_t len,
+                    const uint8_t* nonce, uint8_t* out, uint8_t* out_digest) {
+    size_t out_len = 0;
+    int status = algorithm == NC_ALG_AES_256_GCM
+                 ? encrypt_aes_gcm_256_ex(plaintext, len, key, nonce, 12, NULL, 0, out, &out_len)
+                 : encrypt_chacha20_poly1305_ex(plaintext, len, key, nonce, 12, NULL, 0, out, &out_len);
+
+    if (status < 0) return status;
+    return nc_digest(digest, plaintext, len, out_digest);
+}
+
+static int fused(int algorithm, int digest, size_t tile_size, const uint8_t* key, const uint8_t* plaintext,
+                 size_t len, const uint8_t* nonce, uint8_t* out, uint8_t* out_digest) {
+    size_t out_len = 0;
+    return nc_seal_digest(algorithm, key, 32, plaintext, len, nonce, 12, NULL, 0, digest, tile_size, out,
+                          &out_len, out_digest);
+}
+
+/**
+ * @brief Runs one mode (tile_size 0 = two-pass) until min_seconds have elapsed and prints a row.
+ *
+ * @return 0 on success, or the first negative error code.
+ */
+static int run_mode(const named_id* alg, const named_id* dig, size_t tile_size, const uint8_t* key,
+                    const uint8_t* plaintext, size_t len, uint8_t* out, double min_seconds) {
+    uint8_t nonce[12] = {0};
+    uint8_t digest[NC_DIGEST_LEN];
+    uint64_t start = bench_now_ns();
+    uint64_t elapsed = 0;
+    size_t reps = 0;
+
+    while (reps == 0 || (double)elapsed / 1e9 < min_seconds) {
+        int status = tile_size == 0
+                     ? two_pass(alg->id, dig->id, key, plaintext, len, nonce, out, digest)
+                     : fused(alg->id, dig->id, tile_size, key, plaintext, len, nonce, out, digest);
+        if (status < 0) {
+            fprintf(stderr, "%s/%s failed at %zu bytes (%d)\n", alg->name, dig->name, len, status);
+            return status;
+        }
+        reps++;
+        elapsed = bench_now_ns() - start;
+    }
+    printf("%s;%s;%zu;%s;%zu;%zu;%.2f\n", alg->name, dig->name, len, tile_size == 0 ? "two-pass" : "fused",
+           tile_size, reps, bench_mib_per_s(len * reps, elapsed));
+    fflush(stdout);
+    return 0;
+}
+
+/**
+ * @brief Checks that the fused pass reproduces the two-pass ciphertext and digest.
+ */
+static int check_equal(const named_id* alg, const named_id* dig, const uint8_t* key, const uint8_t* plaintext,
+                       size_t len, uint8_t* out_a, uint8_t* out_b) {
+    uint8_t nonce[12] = {0};
+    uint8_t digest_a[NC_DIGEST_LEN];
+    uint8_t digest_b[NC_DIGEST_LEN];
+
+    if (two_pass(alg->id, dig->id, key, plaintext, len, nonce, out_a, digest_a) < 0 ||
+        fused(alg->id, dig->id, 0, key, plaintext, len, nonce, out_b, digest_b) < 0 ||
+        memcmp(out_a, out_b, len + NC_AEAD_TAG_LEN) != 0 || memcmp(digest_a, digest_b, NC_DIGEST_LEN) != 0) {
+        fprintf(stderr, "%s/%s: fused output differs at %zu bytes\n", alg->name, dig->name, len);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    size_t max_len = (argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 256) * MIB;
+    double min_seconds = argc > 2 ? strtod(argv[2], NULL) : 0.25;
+    uint8_t key[32];
+    uint8_t* plaintext;
+    uint8_t* out;
+    uint8_t* check;
+    size_t a;
+    size_t d;
+    int status = 0;
+
+    if (max_len < 64 * KIB || min_seconds < 0) {
+        fprintf(stderr, "usage: %s [max_mib] [min_seconds]\n", argv[0]);
+        return 2;
+    }
+    plaintext = (uint8_t*)malloc(max_len);
+    out = (uint8_t*)malloc(max_len + NC_AEAD_TAG_LEN);
+    check = (uint8_t*)malloc(max_len + NC_AEAD_TAG_LEN);
+    if (!plaintext || !out || !check) {
+        fprintf(stderr, "cannot allocate the %zu MiB buffers\n", max_len / MIB);
+        return 1;
+    }
+    bench_fill_pattern(key, sizeof(key), 1);
+    nc_fill_random(plaintext, max_len, NC_RANDOM_SEEDED, 2);
+    // Fault the output pages in before the first timed run.
+    nc_fill_random(out, max_len + NC_AEAD_TAG_LEN, NC_RANDOM_SEEDED, 3);
+    nc_fill_random(check, max_len + NC_AEAD_TAG_LEN, NC_RANDOM_SEEDED, 4);
+
+    printf("Algorithm;Digest;Bytes;Mode;TileBytes;Reps;MiBps\n");
+    for (a = 0; a < sizeof(kAlgorithms) / sizeof(kAlgorithms[0]) && status == 0; a++) {
+        for (d = 0; d < sizeof(kDigests) / sizeof(kDigests[0]) && status == 0; d++) {
+            size_t len;
+
+            for (len = 64 * KIB; len <= max_len && status == 0; len *= 16) {
+                size_t t;
+
+                status = check_equal(&kAlgorithms[a], &kDigests[d], key, plaintext, len, out, check);
+                if (status == 0) {
+                    status = run_mode(&kAlgorithms[a], &kDigests[d], 0, key, plaintext, len, out, min_seconds);
+                }
+                for (t = 0; t < sizeof(kTileSizes) / sizeof(kTileSizes[0]) && status == 0; t++) {
+                    status = run_mode(&kAlgorithms[a], &kDigests[d], kTileSizes[t], key, plaintext, len, out,
+                                      min_seconds);
+                }
+                if (len > max_len / 16) break;
+            }
+        }
+    }
+
+    free(check);
+    free(out);
+    free(plaintext);
+    return status == 0 ? 0 : 1;
+}
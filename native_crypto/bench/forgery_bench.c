@@ -0,0 +1,150 @@
+// Rejection benchmark for forged records: how fast ciphertexts with a corrupted tag are refused.
+//
+// Usage: native_crypto_forgery_bench [iterations] [ring_capacity]
+//
+// For every algorithm and record size a valid record is opened, then the same record with its
+// last tag byte flipped, through the single-shot functions (key setup per call) and through a
+// reusable nc_aead_ctx. Rejections are silent; the per-thread failure counters are checked to
+// confirm every forgery was counted. A non-zero ring_capacity also enables the error ring, to
+// measure its cost on the failure path.
+
+#include "native_crypto.h"
+#include "bench_common.h"
+
+#include <stdio.h>  // For printf, fprintf
+#include <stdlib.h> // For malloc, free, strtoul
+
+static const size_t kSizes[] = {64, 1024, 16384, 65536};
+
+// Signature shared by decrypt_aes_gcm_256 and decrypt_chacha20_poly1305.
+typedef int (*decrypt_fn)(const uint8_t*, size_t, const uint8_t*, const uint8_t*, size_t,
+                          const uint8_t*, size_t, uint8_t*);
+
+/** @brief An algorithm under test. */
+typedef struct {
+    const char* name;
+    int id;             // NC_ALG_* identifier.
+    decrypt_fn decrypt; // Single-shot decryption entry point.
+} forgery_algorithm;
+
+static const forgery_algorithm kAlgorithms[] = {
+        {"AES-256-GCM", NC_ALG_AES_256_GCM, decrypt_aes_gcm_256},
+        {"ChaCha20-Poly1305", NC_ALG_CHACHA20_POLY1305, decrypt_chacha20_poly1305},
+};
+
+/**
+ * @brief Opens the record `iterations` times and returns the mean time per open in ns.
+ *
+ * @param ctx Handle to use, or NULL to call the single-shot function.
+ * @param out_failures Set to the number of opens that failed.
+ */
+static uint64_t time_opens(const forgery_algorithm* alg, const nc_aead_ctx* ctx, const uint8_t key[32],
+                           const uint8_t nonce[12], const uint8_t* record, size_t record_len,
+                           uint8_t* out, int iterations, int* out_failures) {
+    uint64_t start = bench_now_ns();
+    int failures = 0;
+    int i;
+
+    for (i = 0; i < iterations; i++) {
+        int result = ctx ? nc_aead_open(ctx, record, record_len, nonce, 12, NULL, 0, out)
+                         : alg->decrypt(record, record_len, key, nonce, 12, NULL, 0, out);
+        if (result < 0) failures++;
+    }
+    *out_failures = failures;
+    return (bench_now_ns() - start) / (uint64_t)iterations;
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? (int)strtoul(argv[1], NULL, 10) : 20000;
+    size_t ring_capacity = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : 0;
+    const size_t max_size = kSizes[sizeof(kSizes) / sizeof(kSizes[0]) - 1];
+    const uint8_t nonce[12] = {0};
+    uint8_t key[32];
+    uint8_t* plaintext;
+    uint8_t* record;
+    uint8_t* forged;
+    uint8_t* out;
+    size_t a, s;
+    int api;
+    int status = 0;
+
+    if (iterations <= 0) {
+        fprintf(stderr, "usage: %s [iterations] [ring_capacity]\n", argv[0]);
+        return 2;
+    }
+    if (nc_error_ring_configure(ring_capacity) != 0) {
+        fprintf(stderr, "cannot allocate an error ring of %zu entries\n", ring_capacity);
+        return 1;
+    }
+
+    plaintext = (uint8_t*)malloc(max_size);
+    record = (uint8_t*)malloc(max_size + NC_AEAD_TAG_LEN);
+    forged = (uint8_t*)malloc(max_size + NC_AEAD_TAG_LEN);
+    out = (uint8_t*)malloc(max_size + NC_AEAD_TAG_LEN);
+    if (!plaintext || !record || !forged || !out) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    bench_fill_pattern(key, sizeof(key), 1);
+    bench_fill_pattern(plaintext, max_size, 2);
+
+    printf("Algorithm;API;DataSize_B;Valid_ns;Forged_ns;Valid_Opens_per_s;Forged_Rejects_per_s;Forged_MiBps\n");
+    for (a = 0; a < sizeof(kAlgorithms) / sizeof(kAlgorithms[0]); a++) {
+        const forgery_algorithm* alg = &kAlgorithms[a];
+        nc_aead_ctx* ctx = nc_aead_ctx_new(alg->id, key, sizeof(key));
+        if (!ctx) {
+            fprintf(stderr, "nc_aead_ctx_new failed for %s\n", alg->name);
+            status = 1;
+            continue;
+        }
+
+        for (s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); s++) {
+            size_t size = kSizes[s];
+            int sealed = nc_aead_seal(ctx, plaintext, size, nonce, sizeof(nonce), NULL, 0, record);
+            size_t i;
+
+            if (sealed != (int)(size + NC_AEAD_TAG_LEN)) {
+                fprintf(stderr, "seal failed: %s, %zu B\n", alg->name, size);
+                status = 1;
+                continue;
+            }
+            for (i = 0; i < (size_t)sealed; i++) forged[i] = record[i];
+            forged[sealed - 1] ^= 0x01; // Flip one bit of the tag.
+
+            // API 0: single-shot function, API 1: reusable handle.
+            for (api = 0; api < 2; api++) {
+                const nc_aead_ctx* use_ctx = api ? ctx : NULL;
+                nc_error_counters counters;
+                uint64_t valid_ns, forged_ns;
+                int valid_failures, forged_failures;
+
+                valid_ns = time_opens(alg, use_ctx, key, nonce, record, (size_t)sealed, out, iterations,
+                                      &valid_failures);
+                nc_error_counters_reset();
+                forged_ns = time_opens(alg, use_ctx, key, nonce, forged, (size_t)sealed, out, iterations,
+                                       &forged_failures);
+                nc_error_counters_get(&counters);
+
+                if (valid_failures != 0 || forged_failures != iterations ||
+                    counters.auth_failures != (uint64_t)iterations) {
+                    fprintf(stderr, "%s, %zu B: %d valid opens failed, %d of %d forgeries rejected "
+                                    "(%llu counted)\n", alg->name, size, valid_failures, forged_failures,
+                            iterations, (unsigned long long)counters.auth_failures);
+                    status = 1;
+                }
+                printf("%s;%s;%zu;%llu;%llu;%.0f;%.0f;%.1f\n", alg->name, api ? "handle" : "single-shot",
+                       size, (unsigned long long)valid_ns, (unsigned long long)forged_ns,
+                       valid_ns ? 1e9 / (double)valid_ns : 0.0, forged_ns ? 1e9 / (double)forged_ns : 0.0,
+                       bench_mib_per_s(size, forged_ns));
+            }
+        }
+        nc_aead_ctx_free(ctx);
+    }
+
+    nc_error_ring_configure(0);
+    free(out);
+    free(forged);
+    free(record);
+    free(plaintext);
+    return status;
+}
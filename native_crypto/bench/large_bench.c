@@ -0,0 +1,145 @@
+// Single-message throughput from 64 KiB up to several GiB, through the 64-bit length API.
+//
+// Usage: native_crypto_large_bench [max_gib] [min_seconds]
+//
+// Each algorithm seals and then opens one message in place, at every power of two (and the
+// point halfway to the next one) up to max_gib GiB (default 4), so the sweep crosses the cache
+// sizes, the 2 GiB limit of the int-returning API and the 4 GiB mark. Small sizes are repeated
+// until min_seconds (default 0.25) have elapsed. The largest size is capped at three quarters
+// of the memory currently available, so the sweep measures the cipher rather than swapping.
+
+#include "native_crypto.h"
+#include "bench_common.h"
+
+#include <stdio.h>  // For printf, fprintf
+#include <stdlib.h> // For malloc, free, strtod
+#include <unistd.h> // For sysconf
+
+#define KIB ((size_t)1024)
+#define GIB (KIB * KIB * KIB)
+
+typedef struct {
+    const char* name;
+    int algorithm;
+} algorithm_case;
+
+static const algorithm_case kAlgorithms[] = {
+    {"AES-256-GCM", NC_ALG_AES_256_GCM},
+    {"ChaCha20-Poly1305", NC_ALG_CHACHA20_POLY1305},
+};
+
+/**
+ * @brief Returns three quarters of the memory currently available, or SIZE_MAX if unknown.
+ */
+static size_t usable_memory(void) {
+    long pages = sysconf(_SC_AVPHYS_PAGES);
+    long page_size = sysconf(_SC_PAGESIZE);
+
+    if (pages <= 0 || page_size <= 0) return SIZE_MAX;
+    return (size_t)pages / 4 * 3 * (size_t)page_size;
+}
+
+/**
+ * @brief Seals then opens buf in place reps times and reports both throughputs.
+ *
+ * @return 0 on success, or the first negative error code.
+ */
+static int run_size(const algorithm_case* alg, nc_aead_ctx* ctx, uint8_t* buf, size_t len,
+                    double min_seconds) {
+    uint8_t nonce[12] = {0};
+    uint64_t seal_ns = 0;
+    uint64_t open_ns = 0;
+    size_t reps = 0;
+
+    // Repeat until the seals alone have run for min_seconds; large sizes run once.
+    while (reps == 0 || (double)seal_ns / 1e9 < min_seconds) {
+        size_t out_len = 0;
+        uint64_t start;
+        int status;
+
+        nonce[0] = (uint8_t)reps;
+        start = bench_now_ns();
+        status = nc_aead_seal_ex(ctx, buf, len, nonce, sizeof(nonce), NULL, 0, buf, &out_len);
+        seal_ns += bench_now_ns() - start;
+        if (status < 0 || out_len != len + NC_AEAD_TAG_LEN) {
+            fprintf(stderr, "%s seal of %zu bytes failed (%d)\n", alg->name, len, status);
+            return status < 0 ? status : NC_ERR_INVALID_ARGUMENT;
+        }
+
+        start = bench_now_ns();
+        status = nc_aead_open_ex(ctx, buf, out_len, nonce, sizeof(nonce), NULL, 0, buf, &out_len);
+        open_ns += bench_now_ns() - start;
+        if (status < 0 || out_len != len) {
+            fprintf(stderr, "%s open of %zu bytes failed (%d)\n", alg->name, len, status);
+            return status < 0 ? status : NC_ERR_AUTHENTICATION;
+        }
+        reps++;
+    }
+
+    printf("%s;%zu;%.3f;%zu;%.2f;%.2f\n", alg->name, len, (double)len / (double)GIB, reps,
+           bench_mib_per_s(len * reps, seal_ns), bench_mib_per_s(len * reps, open_ns));
+    fflush(stdout);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    double max_gib = argc > 1 ? strtod(argv[1], NULL) : 4.0;
+    double min_seconds = argc > 2 ? strtod(argv[2], NULL) : 0.25;
+    size_t max_len;
+    size_t usable = usable_memory();
+    uint8_t key[32];
+    uint8_t* buf;
+    size_t a;
+    int status = 0;
+
+    if (max_gib <= 0 || min_seconds < 0 || max_gib * (double)GIB >= (double)SIZE_MAX) {
+        fprintf(stderr, "usage: %s [max_gib] [min_seconds]\n", argv[0]);
+        return 2;
+    }
+    max_len = (size_t)(max_gib * (double)GIB);
+    if (max_len + NC_AEAD_TAG_LEN > usable) {
+        fprintf(stderr, "capping the sweep at %zu MiB (available memory)\n", usable / (KIB * KIB));
+        max_len = usable - NC_AEAD_TAG_LEN;
+    }
+    if (max_len < 64 * KIB) {
+        fprintf(stderr, "not enough memory for the sweep\n");
+        return 1;
+    }
+
+    // One buffer for every size: sealing in place needs room for the tag only.
+    buf = (uint8_t*)malloc(max_len + NC_AEAD_TAG_LEN);
+    if (!buf) {
+        fprintf(stderr, "cannot allocate %zu bytes\n", max_len + NC_AEAD_TAG_LEN);
+        return 1;
+    }
+    // Also faults every page in, so first-touch costs stay out of the timings.
+    bench_fill_pattern(key, sizeof(key), 1);
+    if (nc_fill_random(buf, max_len + NC_AEAD_TAG_LEN, NC_RANDOM_SEEDED, 2) != 0) {
+        fprintf(stderr, "nc_fill_random failed\n");
+        free(buf);
+        return 1;
+    }
+
+    printf("Algorithm;Bytes;GiB;Reps;SealMiBps;OpenMiBps\n");
+    for (a = 0; a < sizeof(kAlgorithms) / sizeof(kAlgorithms[0]) && status == 0; a++) {
+        nc_aead_ctx* ctx = nc_aead_ctx_new(kAlgorithms[a].algorithm, key, sizeof(key));
+        size_t len;
+
+        if (!ctx) {
+            fprintf(stderr, "nc_aead_ctx_new failed for %s\n", kAlgorithms[a].name);
+            status = 1;
+            break;
+        }
+        for (len = 64 * KIB; len <= max_len && status == 0; len *= 2) {
+            status = run_size(&kAlgorithms[a], ctx, buf, len, min_seconds);
+            if (status == 0 && len / 2 * 3 <= max_len) {
+                status = run_size(&kAlgorithms[a], ctx, buf, len / 2 * 3, min_seconds);
+            }
+            if (len > max_len / 2) break; // The next doubling would overflow or exceed the cap.
+        }
+        nc_aead_ctx_free(ctx);
+    }
+
+    free(buf);
+    return status == 0 ? 0 : 1;
+}
@@ -0,0 +1,522 @@
+// Standalone benchmark for the stateless seal/open functions of native_crypto.
+//
+// Usage: native_crypto_bench [-i iterations] [-w warmup] [-s size]... [-a aes|chacha|auto|name] [-o file.csv] [-P]
+//                            [-m sample_hz]
+//
+// Runs the same matrix as the app's planned test suite (16 KiB to 4 MiB) without isolates, Dart
+// copies or platform channels in the measurement, for every AEAD in the library's algorithm
+// registry (nc_algorithm_info_at) through nc_seal/nc_open. -a selects one algorithm by its
+// registry name, by the aliases "aes" and "chacha" for the two the app implements, or as "auto"
+// (whichever of those two the NC_ALG_AUTO calibration picks). The CPU features BoringSSL
+// dispatches on and the calibration result are written to stderr before the first case.
+// Every iteration uses a fresh nonce, times one encryption and one decryption and verifies the
+// round trip, exactly like BenchmarkService.runBenchmark.
+//
+// Results use the semicolon-separated schema of BenchmarkResult.toCsvRow() (the files read by the
+// scripts in plots/) with the implementation tag "ImplementationType.native", followed by host
+// metadata columns. With -o the rows are appended to a file (the header is written once).
+//
+// Each phase is also measured with hardware performance counters (see perf_counters.h): cycles per
+// byte, IPC and per-iteration cache misses, branch misses and stalled cycles are appended to every
+// row. Counters that the CPU, kernel or perf_event_paranoid setting do not allow are written as
+// "N/A"; -P disables counter collection altogether.
+//
+// CPUTime_ms is the CPU time of the whole process over the measured iterations, as in the app.
+// NativeCPUTime_ms is the CPU time of the benchmark thread inside the encryption and decryption
+// calls only (nc_thread_usage_get); the page faults and context switches of those calls follow at
+// the end of the row.
+//
+// Memory is sampled by a background nc_mem_sampler (-m, default 1000 Hz, 0 to disable) during each
+// phase, so RAM_Avg_MB and RAM_Peak_MB include transient peaks inside a single call. The largest
+// rise of RSS and malloc'd bytes above the start of each phase is appended to every row. Without
+// the sampler, RSS is read between iterations like BenchmarkService does.
+
+#include "native_crypto.h"
+#include "bench_common.h"
+#include "perf_counters.h"
+
+#include <stdio.h>  // For fprintf, fopen
+#include <stdlib.h> // For malloc, free, strtoul
+#include <string.h> // For memcmp, memcpy, strcmp
+#include <unistd.h> // For getopt, sysconf
+
+/** @brief An algorithm under test, taken from the library's algorithm registry. */
+typedef struct {
+    nc_algorithm_info info; // Registry entry: id, name and key/nonce lengths.
+    const char* csv_name;   // Algorithm column value, matching the app's AlgorithmType where it has one.
+    const char* option;     // Short alias accepted by -a besides the registry name, or NULL.
+} bench_algorithm;
+
+// Algorithms the app also implements keep its AlgorithmType names and the historic -a aliases;
+// every other registered algorithm is reported under its registry name.
+static const struct {
+    int id;
+    const char* csv_name;
+    const char* option;
+} kAppAlgorithms[] = {
+        {NC_ALG_AES_256_GCM, "AlgorithmType.aesGcm", "aes"},
+        {NC_ALG_CHACHA20_POLY1305, "AlgorithmType.chaChaPoly", "chacha"},
+};
+
+// Upper bounds over the registered algorithms, for stack buffers.
+#define MAX_KEY_LEN 32
+#define MAX_NONCE_LEN 24
+
+// Implementation column value for rows produced by this harness.
+#define IMPLEMENTATION_TAG "ImplementationType.native"
+
+// Commit of the BoringSSL checkout the library was built against (set by CMake).
+#ifndef NATIVE_CRYPTO_BORINGSSL_COMMIT
+#define NATIVE_CRYPTO_BORINGSSL_COMMIT "unknown"
+#endif
+
+// Header matching BenchmarkResult.toCsvRow(), plus the host metadata columns.
+static const char kCsvHeader[] =
+        "Implementation;Algorithm;DataSize_B;Iterations;WallTime_Encrypt_ms;Stdev_Encrypt_ms;"
+        "WallTime_Decrypt_ms;Stdev_Decrypt_ms;WallTime_Sum_ms;CPUTime_ms;RAM_Avg_MB;RAM_Peak_MB;NativeCPUTime_ms;"
+        "Host_CPU;Host_Cores;BoringSSL_Commit;"
+        "Encrypt_CyclesPerByte;Encrypt_IPC;Encrypt_CacheMisses;Encrypt_BranchMisses;"
+        "Encrypt_StalledFrontend;Encrypt_StalledBackend;"
+        "Decrypt_CyclesPerByte;Decrypt_IPC;Decrypt_CacheMisses;Decrypt_BranchMisses;"
+        "Decrypt_StalledFrontend;Decrypt_StalledBackend;"
+        "Minor_Faults;Major_Faults;Voluntary_Switches;Involuntary_Switches;"
+        "Encrypt_RSS_PeakDelta_KB;Encrypt_Heap_PeakDelta_KB;Decrypt_RSS_PeakDelta_KB;Decrypt_Heap_PeakDelta_KB;"
+        "Mem_Samples\n";
+
+// Same data sizes as the planned test suite in lib/main.dart.
+static const size_t kDefaultSizes[] = {16384, 65536, 262144, 1048576, 4194304};
+
+#define MAX_SIZES 32
+
+/** @brief Memory sampler totals of one phase over the measured iterations. */
+typedef struct {
+    uint64_t samples;         // Sampler samples over all iterations.
+    double rss_sum;           // Sum of all RSS samples, in bytes.
+    uint64_t rss_peak;        // Highest RSS sample.
+    uint64_t rss_peak_delta;  // Largest rise of RSS above the start of the phase.
+    uint64_t heap_peak_delta; // Largest rise of malloc'd bytes above the start of the phase.
+    int heap_supported;       // 0 if the C library has no mallinfo.
+} bench_phase_memory;
+
+/** @brief Results of one (algorithm, size) case, in the units of the CSV schema. */
+typedef struct {
+    double encrypt_mean_ms;
+    double encrypt_stdev_ms;
+    double decrypt_mean_ms;
+    double decrypt_stdev_ms;
+    double sum_ms;          // Total encryption + decryption time of the measured iterations.
+    double cpu_time_ms;     // Process CPU time consumed by the measured iterations.
+    double native_cpu_time_ms; // Thread CPU time spent in the measured encryptions and decryptions.
+    double ram_avg_mb;      // Average RSS (sampler samples, or one sample after every iteration).
+    double ram_peak_mb;     // Peak RSS (sampler samples, or one sample after every iteration).
+    bench_perf_totals encrypt_perf; // Counter totals of the measured encryptions.
+    bench_perf_totals decrypt_perf; // Counter totals of the measured decryptions.
+    nc_thread_usage usage;          // Thread usage of the measured calls (cpu_time_ns included).
+    int usage_supported;            // 0 if the platform has no per-thread rusage.
+    bench_phase_memory encrypt_mem; // Sampler totals of the measured encryptions.
+    bench_phase_memory decrypt_mem; // Sampler totals of the measured decryptions.
+} bench_result;
+
+/**
+ * @brief Writes a per-iteration nonce (a big-endian counter in the last 8 bytes), so no nonce
+ * repeats under one key.
+ */
+static void make_nonce(uint8_t* nonce, size_t nonce_len, uint64_t counter) {
+    int i;
+    memset(nonce, 0, nonce_len);
+    for (i = 0; i < 8; i++) nonce[nonce_len - 1 - i] = (uint8_t)(counter >> (8 * i));
+}
+
+/**
+ * @brief Describes the registered algorithm at index, with its CSV name and -a alias.
+ */
+static int bench_algorithm_at(size_t index, bench_algorithm* out) {
+    size_t i;
+
+    if (nc_algorithm_info_at(index, &out->info) != 0) return -1;
+    out->csv_name = out->info.name;
+    out->option = NULL;
+    for (i = 0; i < sizeof(kAppAlgorithms) / sizeof(kAppAlgorithms[0]); i++) {
+        if (kAppAlgorithms[i].id == out->info.id) {
+            out->csv_name = kAppAlgorithms[i].csv_name;
+            out->option = kAppAlgorithms[i].option;
+        }
+    }
+    // The stack buffers of run_case must fit every registered algorithm.
+    return out->info.key_len <= MAX_KEY_LEN && out->info.nonce_len <= MAX_NONCE_LEN ? 0 : -1;
+}
+
+/**
+ * @brief Returns 1 if the -a value selects alg (its alias, its registry name, or "auto" for the
+ * algorithm nc_algorithm_auto() picks on this CPU).
+ */
+static int matches_filter(const bench_algorithm* alg, const char* filter) {
+    if (!filter) return 1;
+    if (strcmp(filter, "auto") == 0) return alg->info.id == nc_algorithm_auto(NULL);
+    return (alg->option && strcmp(filter, alg->option) == 0) || strcmp(filter, alg->info.name) == 0;
+}
+
+/**
+ * @brief Adds the difference of two thread usage samples to a total.
+ */
+static void add_usage_delta(nc_thread_usage* total, const nc_thread_usage* before, const nc_thread_usage* after) {
+    total->cpu_time_ns += after->cpu_time_ns - before->cpu_time_ns;
+    total->minor_faults += after->minor_faults - before->minor_faults;
+    total->major_faults += after->major_faults - before->major_faults;
+    total->voluntary_switches += after->voluntary_switches - before->voluntary_switches;
+    total->involuntary_switches += after->involuntary_switches - before->involuntary_switches;
+}
+
+/**
+ * @brief Adds the sampler statistics of one phase to the phase totals.
+ */
+static void add_mem_stats(bench_phase_memory* total, const nc_mem_stats* stats) {
+    uint64_t rss_delta = stats->rss_peak_bytes - stats->rss_start_bytes;
+    uint64_t heap_delta = stats->heap_peak_bytes - stats->heap_start_bytes;
+
+    total->samples += stats->samples;
+    total->rss_sum += (double)stats->rss_avg_bytes * (double)stats->samples;
+    if (stats->rss_peak_bytes > total->rss_peak) total->rss_peak = stats->rss_peak_bytes;
+    if (rss_delta > total->rss_peak_delta) total->rss_peak_delta = rss_delta;
+    if (heap_delta > total->heap_peak_delta) total->heap_peak_delta = heap_delta;
+    total->heap_supported = stats->heap_supported;
+}
+
+/**
+ * @brief Runs warmup + measured iterations of one case.
+ *
+ * @return 0 on success, -1 if an operation failed or a round trip did not match.
+ */
+static int run_case(const bench_algorithm* alg, size_t size, int iterations, int warmup,
+                    const uint8_t key[MAX_KEY_LEN], const bench_perf_counters* counters, nc_mem_sampler* sampler,
+                    bench_result* result) {
+    uint8_t* plaintext = (uint8_t*)malloc(size);
+    uint8_t* ciphertext = (uint8_t*)malloc(size + 16);
+    uint8_t* decrypted = (uint8_t*)malloc(size > 0 ? size : 1);
+    double* encrypt_ms = (double*)malloc((size_t)iterations * sizeof(double));
+    double* decrypt_ms = (double*)malloc((size_t)iterations * sizeof(double));
+    uint64_t counter = 0;
+    uint64_t cpu_start = 0;
+    uint64_t rss_sum = 0;
+    uint64_t rss_peak = 0;
+    double sum_ms = 0.0;
+    int status = -1;
+    int i;
+
+    memset(result, 0, sizeof(*result));
+    result->usage_supported = 1;
+    if (!plaintext || !ciphertext || !decrypted || !encrypt_ms || !decrypt_ms) goto done;
+    bench_fill_pattern(plaintext, size, (uint32_t)size);
+
+    for (i = -warmup; i < iterations; i++) {
+        uint8_t nonce[MAX_NONCE_LEN];
+        size_t nonce_len = alg->info.nonce_len;
+        // Warmup iterations are counted into a scratch total that is discarded.
+        bench_perf_totals scratch;
+        bench_perf_totals* encrypt_perf = i >= 0 ? &result->encrypt_perf : &scratch;
+        bench_perf_totals* decrypt_perf = i >= 0 ? &result->decrypt_perf : &scratch;
+        nc_thread_usage usage[4]; // Before/after encryption, before/after decryption.
+        nc_mem_stats mem[2];      // Encryption and decryption phase.
+        uint64_t t0, t1, t2, t3;
+        size_t sealed_len = 0, opened_len = 0;
+        int sealed, opened;
+
+        memset(&scratch, 0, sizeof(scratch));
+        make_nonce(nonce, nonce_len, counter++);
+        if (i == 0) cpu_start = bench_process_cpu_ns();
+
+        // --- Encryption Phase ---
+        // The sampler, counter ioctls and usage samples stay outside the timed region of each phase.
+        if (sampler) nc_mem_sampler_begin(sampler);
+        if (nc_thread_usage_get(&usage[0]) != 0) result->usage_supported = 0;
+        bench_perf_start(counters);
+        t0 = bench_now_ns();
+        sealed = nc_seal(alg->info.id, key, alg->info.key_len, plaintext, size, nonce, nonce_len, NULL, 0,
+                         ciphertext, &sealed_len);
+        t1 = bench_now_ns();
+        bench_perf_stop(counters, encrypt_perf);
+        nc_thread_usage_get(&usage[1]);
+        if (sampler) nc_mem_sampler_end(sampler, &mem[0]);
+        // --- Decryption Phase ---
+        if (sampler) nc_mem_sampler_begin(sampler);
+        nc_thread_usage_get(&usage[2]);
+        bench_perf_start(counters);
+        t2 = bench_now_ns();
+        opened = sealed < 0 ? -1 : nc_open(alg->info.id, key, alg->info.key_len, ciphertext, sealed_len,
+                                           nonce, nonce_len, NULL, 0, decrypted, &opened_len);
+        t3 = bench_now_ns();
+        bench_perf_stop(counters, decrypt_perf);
+        nc_thread_usage_get(&usage[3]);
+        if (sampler) nc_mem_sampler_end(sampler, &mem[1]);
+
+        if (sealed < 0 || opened < 0 || sealed_len != size + NC_AEAD_TAG_LEN || opened_len != size ||
+            memcmp(plaintext, decrypted, size) != 0) {
+            fprintf(stderr, "%s, %zu B: round trip failed in iteration %d\n", alg->info.name, size, i);
+            goto done;
+        }
+        if (i >= 0) {
+            encrypt_ms[i] = (double)(t1 - t0) / 1e6;
+            decrypt_ms[i] = (double)(t3 - t2) / 1e6;
+            sum_ms += encrypt_ms[i] + decrypt_ms[i];
+            if (sampler) {
+                add_mem_stats(&result->encrypt_mem, &mem[0]);
+                add_mem_stats(&result->decrypt_mem, &mem[1]);
+            } else {
+                // Without the sampler, memory is sampled between iterations like BenchmarkService does.
+                uint64_t rss = bench_rss_bytes();
+                rss_sum += rss;
+                if (rss > rss_peak) rss_peak = rss;
+            }
+            add_usage_delta(&result->usage, &usage[0], &usage[1]);
+            add_usage_delta(&result->usage, &usage[2], &usage[3]);
+        }
+    }
+
+    result->cpu_time_ms = (double)(bench_process_cpu_ns() - cpu_start) / 1e6;
+    result->native_cpu_time_ms = (double)result->usage.cpu_time_ns / 1e6;
+    bench_mean_stdev(encrypt_ms, (size_t)iterations, &result->encrypt_mean_ms, &result->encrypt_stdev_ms);
+    bench_mean_stdev(decrypt_ms, (size_t)iterations, &result->decrypt_mean_ms, &result->decrypt_stdev_ms);
+    result->sum_ms = sum_ms;
+    if (sampler) {
+        const bench_phase_memory* enc = &result->encrypt_mem;
+        const bench_phase_memory* dec = &result->decrypt_mem;
+        result->ram_avg_mb = (enc->rss_sum + dec->rss_sum) / (double)(enc->samples + dec->samples) /
+                             (1024.0 * 1024.0);
+        result->ram_peak_mb = (double)(enc->rss_peak > dec->rss_peak ? enc->rss_peak : dec->rss_peak) /
+                              (1024.0 * 1024.0);
+    } else {
+        result->ram_avg_mb = (double)rss_sum / (double)iterations / (1024.0 * 1024.0);
+        result->ram_peak_mb = (double)rss_peak / (1024.0 * 1024.0);
+    }
+    status = 0;
+
+    done:
+    free(decrypt_ms);
+    free(encrypt_ms);
+    free(decrypted);
+    free(ciphertext);
+    free(plaintext);
+    return status;
+}
+
+/**
+ * @brief Writes the counter columns of one phase: cycles/byte, IPC and per-iteration event counts.
+ */
+static void print_perf_columns(FILE* out, const bench_perf_totals* totals, size_t size, int iterations) {
+    const uint64_t* v = totals->values;
+    const int* ok = totals->valid;
+    int e;
+
+    // Cycles per byte (an empty payload has none).
+    if (ok[BENCH_PERF_CYCLES] && size > 0) {
+        fprintf(out, ";%.3f", (double)v[BENCH_PERF_CYCLES] / ((double)size * iterations));
+    } else {
+        fputs(";N/A", out);
+    }
+    // Instructions per cycle.
+    if (ok[BENCH_PERF_CYCLES] && ok[BENCH_PERF_INSTRUCTIONS] && v[BENCH_PERF_CYCLES] > 0) {
+        fprintf(out, ";%.3f", (double)v[BENCH_PERF_INSTRUCTIONS] / (double)v[BENCH_PERF_CYCLES]);
+    } else {
+        fputs(";N/A", out);
+    }
+    // Remaining events as means per iteration.
+    for (e = BENCH_PERF_CACHE_MISSES; e < BENCH_PERF_NUM_EVENTS; e++) {
+        if (ok[e]) {
+            fprintf(out, ";%.1f", (double)v[e] / iterations);
+        } else {
+            fputs(";N/A", out);
+        }
+    }
+}
+
+/**
+ * @brief Writes the sampler columns of one phase: peak RSS and heap rise in KiB.
+ */
+static void print_memory_columns(FILE* out, const bench_phase_memory* mem, int sampled) {
+    if (!sampled) {
+        fputs(";N/A;N/A", out);
+        return;
+    }
+    fprintf(out, ";%.1f", (double)mem->rss_peak_delta / 1024.0);
+    if (mem->heap_supported) {
+        fprintf(out, ";%.1f", (double)mem->heap_peak_delta / 1024.0);
+    } else {
+        fputs(";N/A", out);
+    }
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "usage: %s [-i iterations] [-w warmup] [-s size]... [-a aes|chacha|auto|name] [-o file.csv] [-P] [-m sample_hz]\n",
+            program);
+}
+
+/**
+ * @brief Writes the CPU capability report and the NC_ALG_AUTO choice to stderr.
+ */
+static void print_cpu_report(void) {
+    nc_cpu_features features;
+    nc_auto_selection selection;
+    nc_algorithm_info info;
+
+    if (nc_cpu_features_get(&features) == 0) {
+        fprintf(stderr,
+                "cpu: asm=%d aes_hw=%d aesni=%d pclmulqdq=%d ssse3=%d avx=%d avx2=%d avx512=%d vaes=%d "
+                "vpclmulqdq=%d neon=%d armv8_aes=%d armv8_pmull=%d\n",
+                features.asm_enabled, features.aes_hardware, features.aesni, features.pclmulqdq, features.ssse3,
+                features.avx, features.avx2, features.avx512, features.vaes, features.vpclmulqdq, features.neon,
+                features.armv8_aes, features.armv8_pmull);
+        fprintf(stderr, "cpu: expected AES-GCM path %s, ChaCha20 path %s\n", features.expected_aes_gcm_path,
+                features.expected_chacha_path);
+    }
+    nc_algorithm_auto(&selection);
+    if (nc_algorithm_info_get(selection.algorithm, &info) != 0) return;
+    if (selection.calibrated) {
+        fprintf(stderr, "auto: %s (AES-256-GCM %.0f MiB/s, ChaCha20-Poly1305 %.0f MiB/s at %d B)\n", info.name,
+                selection.aes_gcm_mib_per_s, selection.chacha_mib_per_s, NC_AUTO_CALIBRATION_SIZE);
+    } else {
+        fprintf(stderr, "auto: %s (not calibrated, from aes_hw)\n", info.name);
+    }
+}
+
+/**
+ * @brief Opens the output: stdout, or a CSV file in append mode.
+ *
+ * @param out_needs_header Set to 1 when the output is empty and the header must be written.
+ */
+static FILE* open_output(const char* path, int* out_needs_header) {
+    FILE* file;
+
+    *out_needs_header = 1;
+    if (!path) return stdout;
+    file = fopen(path, "a");
+    if (file && fseek(file, 0, SEEK_END) == 0 && ftell(file) > 0) *out_needs_header = 0;
+    return file;
+}
+
+int main(int argc, char** argv) {
+    int iterations = 100; // Same default as the app.
+    int warmup = 3;
+    size_t sizes[MAX_SIZES];
+    size_t num_sizes = 0;
+    const char* algorithm_filter = NULL;
+    const char* output_path = NULL;
+    int use_counters = 1;
+    bench_perf_counters counters;
+    unsigned int sample_hz = NC_MEM_SAMPLER_DEFAULT_HZ;
+    nc_mem_sampler* sampler = NULL;
+    char cpu_model[128];
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint8_t key[MAX_KEY_LEN];
+    FILE* out;
+    int needs_header;
+    size_t a, s;
+    int status = 0;
+    int opt, e;
+
+    while ((opt = getopt(argc, argv, "i:w:s:a:o:Pm:h")) != -1) {
+        switch (opt) {
+            case 'i':
+                iterations = (int)strtoul(optarg, NULL, 10);
+                break;
+            case 'w':
+                warmup = (int)strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                if (num_sizes == MAX_SIZES) {
+                    fprintf(stderr, "at most %d sizes are supported\n", MAX_SIZES);
+                    return 2;
+                }
+                sizes[num_sizes++] = (size_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'a':
+                algorithm_filter = optarg;
+                break;
+            case 'o':
+                output_path = optarg;
+                break;
+            case 'P':
+                use_counters = 0;
+                break;
+            case 'm':
+                sample_hz = (unsigned int)strtoul(optarg, NULL, 10);
+                break;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    if (iterations <= 0 || warmup < 0) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (num_sizes == 0) {
+        num_sizes = sizeof(kDefaultSizes) / sizeof(kDefaultSizes[0]);
+        memcpy(sizes, kDefaultSizes, sizeof(kDefaultSizes));
+    }
+    bench_fill_pattern(key, sizeof(key), 1);
+    bench_cpu_model(cpu_model, sizeof(cpu_model));
+
+    out = open_output(output_path, &needs_header);
+    if (!out) {
+        fprintf(stderr, "cannot open %s\n", output_path);
+        return 1;
+    }
+    if (needs_header) fputs(kCsvHeader, out);
+
+    // Counters are optional: without them every counter column is written as N/A.
+    if (!use_counters) {
+        for (e = 0; e < BENCH_PERF_NUM_EVENTS; e++) counters.fds[e] = -1;
+    } else if (bench_perf_open(&counters) == 0) {
+        fprintf(stderr, "hardware performance counters unavailable, reporting N/A\n");
+    }
+    if (sample_hz > 0) {
+        sampler = nc_mem_sampler_new(sample_hz);
+        if (!sampler) fprintf(stderr, "memory sampler unavailable, sampling RSS between iterations\n");
+    }
+
+    print_cpu_report();
+    for (a = 0; a < nc_algorithm_count(); a++) {
+        bench_algorithm entry;
+        const bench_algorithm* alg = &entry;
+        if (bench_algorithm_at(a, &entry) != 0) {
+            status = 1;
+            continue;
+        }
+        if (!matches_filter(alg, algorithm_filter)) continue;
+
+        for (s = 0; s < num_sizes; s++) {
+            bench_result result;
+            if (run_case(alg, sizes[s], iterations, warmup, key, &counters, sampler, &result) != 0) {
+                status = 1;
+                continue;
+            }
+            fprintf(out, "%s;%s;%zu;%d;%.3f;%.3f;%.3f;%.3f;%.3f;%.3f;%.3f;%.3f;%.3f;%s;%ld;%s",
+                    IMPLEMENTATION_TAG, alg->csv_name, sizes[s], iterations,
+                    result.encrypt_mean_ms, result.encrypt_stdev_ms,
+                    result.decrypt_mean_ms, result.decrypt_stdev_ms, result.sum_ms,
+                    result.cpu_time_ms, result.ram_avg_mb, result.ram_peak_mb, result.native_cpu_time_ms,
+                    cpu_model, cores, NATIVE_CRYPTO_BORINGSSL_COMMIT);
+            print_perf_columns(out, &result.encrypt_perf, sizes[s], iterations);
+            print_perf_columns(out, &result.decrypt_perf, sizes[s], iterations);
+            if (result.usage_supported) {
+                fprintf(out, ";%llu;%llu;%llu;%llu",
+                        (unsigned long long)result.usage.minor_faults,
+                        (unsigned long long)result.usage.major_faults,
+                        (unsigned long long)result.usage.voluntary_switches,
+                        (unsigned long long)result.usage.involuntary_switches);
+            } else {
+                fputs(";N/A;N/A;N/A;N/A", out);
+            }
+            print_memory_columns(out, &result.encrypt_mem, sampler != NULL);
+            print_memory_columns(out, &result.decrypt_mem, sampler != NULL);
+            fprintf(out, ";%llu\n",
+                    (unsigned long long)(result.encrypt_mem.samples + result.decrypt_mem.samples));
+            fflush(out);
+        }
+    }
+    nc_mem_sampler_free(sampler);
+    bench_perf_close(&counters);
+    if (out != stdout) fclose(out);
+    return status;
+}
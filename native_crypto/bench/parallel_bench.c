@@ -0,0 +1,138 @@
+// Scaling benchmark for the parallel segmented mode (nc_parallel_seal / nc_parallel_open).
+//
+// Usage: native_crypto_parallel_bench [iterations] [max_threads] [segment_size]
+//
+// For every algorithm and payload size the buffer is sealed and opened with 1, 2, 4, ...
+// threads (up to max_threads, default: online CPUs) and the throughput and speedup over
+// the single-threaded run are printed as semicolon-separated rows.
+
+#include "native_crypto.h"
+#include "bench_common.h"
+
+#include <stdio.h>  // For printf, fprintf
+#include <stdlib.h> // For malloc, free, strtoul
+#include <string.h> // For memcmp
+#include <unistd.h> // For sysconf
+
+static const size_t kSizes[] = {1024 * 1024, 4 * 1024 * 1024, 16 * 1024 * 1024};
+static const int kAlgorithms[] = {NC_ALG_AES_256_GCM, NC_ALG_CHACHA20_POLY1305};
+static const char* kAlgorithmNames[] = {"AES-256-GCM", "ChaCha20-Poly1305"};
+
+/**
+ * @brief Runs one (algorithm, size, threads) configuration.
+ *
+ * @return 0 on success, -1 if an operation failed or the round trip did not match.
+ */
+static int run_config(const nc_aead_ctx* ctx, const uint8_t* plaintext, size_t size,
+                      uint8_t* sealed, uint8_t* opened, size_t segment_size, size_t threads,
+                      int iterations, uint64_t* seal_ns, uint64_t* open_ns) {
+    const uint8_t prefix[NC_SEGMENT_NONCE_PREFIX_LEN] = {0};
+    size_t sealed_len = 0;
+    size_t opened_len = 0;
+    uint64_t start;
+    int i;
+
+    // Warm-up round trip, also used to verify correctness.
+    if (nc_parallel_seal(ctx, plaintext, size, prefix, NULL, 0, segment_size, threads,
+                         sealed, &sealed_len) != 0 ||
+        nc_parallel_open(ctx, sealed, sealed_len, prefix, NULL, 0, segment_size, threads,
+                         opened, &opened_len) != 0 ||
+        opened_len != size || memcmp(plaintext, opened, size) != 0) {
+        return -1;
+    }
+
+    start = bench_now_ns();
+    for (i = 0; i < iterations; i++) {
+        nc_parallel_seal(ctx, plaintext, size, prefix, NULL, 0, segment_size, threads,
+                         sealed, &sealed_len);
+    }
+    *seal_ns = (bench_now_ns() - start) / (uint64_t)iterations;
+
+    start = bench_now_ns();
+    for (i = 0; i < iterations; i++) {
+        nc_parallel_open(ctx, sealed, sealed_len, prefix, NULL, 0, segment_size, threads,
+                         opened, &opened_len);
+    }
+    *open_ns = (bench_now_ns() - start) / (uint64_t)iterations;
+    return 0;
+}
+
+/**
+ * @brief Returns the next thread count to measure (powers of two, then max_threads), or 0 when done.
+ */
+static size_t next_thread_count(size_t threads, size_t max_threads) {
+    if (threads >= max_threads) return 0;
+    return threads * 2 < max_threads ? threads * 2 : max_threads;
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? (int)strtoul(argv[1], NULL, 10) : 20;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max_threads = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : (size_t)(cpus > 0 ? cpus : 1);
+    size_t segment_size = argc > 3 ? (size_t)strtoul(argv[3], NULL, 10) : NC_DEFAULT_SEGMENT_SIZE;
+    const size_t max_size = kSizes[sizeof(kSizes) / sizeof(kSizes[0]) - 1];
+    uint8_t key[32];
+    uint8_t* plaintext;
+    uint8_t* sealed;
+    uint8_t* opened;
+    size_t a, s, threads;
+    int status = 0;
+
+    if (iterations <= 0 || max_threads == 0 || segment_size == 0) {
+        fprintf(stderr, "usage: %s [iterations] [max_threads] [segment_size]\n", argv[0]);
+        return 2;
+    }
+
+    plaintext = (uint8_t*)malloc(max_size);
+    sealed = (uint8_t*)malloc(nc_segmented_ciphertext_len(max_size, segment_size));
+    opened = (uint8_t*)malloc(nc_segmented_ciphertext_len(max_size, segment_size));
+    if (!plaintext || !sealed || !opened) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    bench_fill_pattern(key, sizeof(key), 1);
+    bench_fill_pattern(plaintext, max_size, 2);
+
+    printf("Algorithm;DataSize_B;SegmentSize_B;Threads;Seal_MiBps;Open_MiBps;Seal_Speedup;Open_Speedup\n");
+    for (a = 0; a < sizeof(kAlgorithms) / sizeof(kAlgorithms[0]); a++) {
+        nc_aead_ctx* ctx = nc_aead_ctx_new(kAlgorithms[a], key, sizeof(key));
+        if (!ctx) {
+            fprintf(stderr, "nc_aead_ctx_new failed for %s\n", kAlgorithmNames[a]);
+            status = 1;
+            continue;
+        }
+        for (s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); s++) {
+            uint64_t base_seal_ns = 0;
+            uint64_t base_open_ns = 0;
+
+            // Powers of two up to max_threads, plus max_threads itself.
+            for (threads = 1; threads != 0; threads = next_thread_count(threads, max_threads)) {
+                uint64_t seal_ns = 0;
+                uint64_t open_ns = 0;
+
+                if (run_config(ctx, plaintext, kSizes[s], sealed, opened, segment_size, threads,
+                               iterations, &seal_ns, &open_ns) != 0) {
+                    fprintf(stderr, "round trip failed: %s, %zu B, %zu threads\n",
+                            kAlgorithmNames[a], kSizes[s], threads);
+                    status = 1;
+                    break;
+                }
+                if (threads == 1) {
+                    base_seal_ns = seal_ns;
+                    base_open_ns = open_ns;
+                }
+                printf("%s;%zu;%zu;%zu;%.1f;%.1f;%.2f;%.2f\n", kAlgorithmNames[a], kSizes[s],
+                       segment_size, threads,
+                       bench_mib_per_s(kSizes[s], seal_ns), bench_mib_per_s(kSizes[s], open_ns),
+                       seal_ns ? (double)base_seal_ns / (double)seal_ns : 0.0,
+                       open_ns ? (double)base_open_ns / (double)open_ns : 0.0);
+            }
+        }
+        nc_aead_ctx_free(ctx);
+    }
+
+    free(opened);
+    free(sealed);
+    free(plaintext);
+    return status;
+}
@@ -0,0 +1,114 @@
+#include "perf_counters.h"
+
+#include <string.h> // For memset
+
+#ifdef __linux__
+#include <linux/perf_event.h> // For perf_event_attr and PERF_* constants
+#include <sys/ioctl.h>        // For ioctl
+#include <sys/syscall.h>      // For __NR_perf_event_open
+#include <unistd.h>           // For syscall, read, close
+#endif
+
+static const char* kEventNames[BENCH_PERF_NUM_EVENTS] = {
+        "Cycles", "Instructions", "CacheMisses", "BranchMisses", "StalledFrontend", "StalledBackend",
+};
+
+const char* bench_perf_event_name(bench_perf_event event) {
+    return (event >= 0 && event < BENCH_PERF_NUM_EVENTS) ? kEventNames[event] : "Unknown";
+}
+
+#ifdef __linux__
+
+// Generic hardware event id of every bench_perf_event.
+static const uint64_t kEventConfigs[BENCH_PERF_NUM_EVENTS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,
+        PERF_COUNT_HW_STALLED_CYCLES_FRONTEND,
+        PERF_COUNT_HW_STALLED_CYCLES_BACKEND,
+};
+
+int bench_perf_open(bench_perf_counters* counters) {
+    int opened = 0;
+    int i;
+
+    for (i = 0; i < BENCH_PERF_NUM_EVENTS; i++) {
+        struct perf_event_attr attr;
+
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = kEventConfigs[i];
+        attr.disabled = 1;
+        // Kernel and hypervisor events usually need privileges (perf_event_paranoid >= 2).
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // Lets the values be scaled when the kernel multiplexes more events than there are counters.
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        counters->fds[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if (counters->fds[i] >= 0) opened++;
+    }
+    return opened;
+}
+
+void bench_perf_close(bench_perf_counters* counters) {
+    int i;
+    for (i = 0; i < BENCH_PERF_NUM_EVENTS; i++) {
+        if (counters->fds[i] >= 0) close(counters->fds[i]);
+        counters->fds[i] = -1;
+    }
+}
+
+void bench_perf_start(const bench_perf_counters* counters) {
+    int i;
+    for (i = 0; i < BENCH_PERF_NUM_EVENTS; i++) {
+        if (counters->fds[i] < 0) continue;
+        ioctl(counters->fds[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(counters->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void bench_perf_stop(const bench_perf_counters* counters, bench_perf_totals* totals) {
+    int i;
+
+    for (i = 0; i < BENCH_PERF_NUM_EVENTS; i++) {
+        if (counters->fds[i] >= 0) ioctl(counters->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (i = 0; i < BENCH_PERF_NUM_EVENTS; i++) {
+        uint64_t data[3]; // value, time enabled, time running
+        uint64_t value;
+
+        if (counters->fds[i] < 0) continue;
+        if (read(counters->fds[i], data, sizeof(data)) != (ssize_t)sizeof(data)) continue;
+        if (data[2] == 0) continue; // Never scheduled on a hardware counter.
+        value = data[0];
+        if (data[2] < data[1]) value = (uint64_t)((double)value * (double)data[1] / (double)data[2]);
+        totals->values[i] += value;
+        totals->valid[i] = 1;
+    }
+}
+
+#else // !__linux__
+
+int bench_perf_open(bench_perf_counters* counters) {
+    int i;
+    for (i = 0; i < BENCH_PERF_NUM_EVENTS; i++) counters->fds[i] = -1;
+    return 0;
+}
+
+void bench_perf_close(bench_perf_counters* counters) {
+    (void)counters;
+}
+
+void bench_perf_start(const bench_perf_counters* counters) {
+    (void)counters;
+}
+
+void bench_perf_stop(const bench_perf_counters* counters, bench_perf_totals* totals) {
+    (void)counters;
+    (void)totals;
+}
+
+#endif // __linux__
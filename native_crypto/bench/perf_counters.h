@@ -0,0 +1,52 @@
+#ifndef NATIVE_CRYPTO_BENCH_PERF_COUNTERS_H
+#define NATIVE_CRYPTO_BENCH_PERF_COUNTERS_H
+
+// Hardware performance counters for the native benchmark, based on perf_event_open (Linux/Android).
+// Every event is opened on its own, so a CPU or kernel that lacks one event (stalled cycles are
+// often missing on ARM cores) still reports the others. Unavailable events are reported as such
+// instead of failing the benchmark.
+
+#include <stdint.h> // For uint64_t
+
+/** @brief Events collected per benchmark phase. */
+typedef enum {
+    BENCH_PERF_CYCLES = 0,
+    BENCH_PERF_INSTRUCTIONS,
+    BENCH_PERF_CACHE_MISSES,
+    BENCH_PERF_BRANCH_MISSES,
+    BENCH_PERF_STALLED_FRONTEND,
+    BENCH_PERF_STALLED_BACKEND,
+    BENCH_PERF_NUM_EVENTS
+} bench_perf_event;
+
+/** @brief Open counter file descriptors (-1 for events that could not be opened). */
+typedef struct {
+    int fds[BENCH_PERF_NUM_EVENTS];
+} bench_perf_counters;
+
+/** @brief Accumulated counts of one phase. */
+typedef struct {
+    uint64_t values[BENCH_PERF_NUM_EVENTS]; // Event counts, scaled if the kernel multiplexed them.
+    int valid[BENCH_PERF_NUM_EVENTS];       // 1 if the event was counted.
+} bench_perf_totals;
+
+/**
+ * @brief Opens every event for the calling thread (user space only), initially disabled.
+ *
+ * @return The number of events that could be opened (0 if perf events are unavailable).
+ */
+int bench_perf_open(bench_perf_counters* counters);
+
+/** @brief Closes all open counters. */
+void bench_perf_close(bench_perf_counters* counters);
+
+/** @brief Resets and enables all open counters. */
+void bench_perf_start(const bench_perf_counters* counters);
+
+/** @brief Disables all open counters and adds their values to totals. */
+void bench_perf_stop(const bench_perf_counters* counters, bench_perf_totals* totals);
+
+/** @brief Returns the CSV column suffix of an event (e.g. "Cycles"). */
+const char* bench_perf_event_name(bench_perf_event event);
+
+#endif // NATIVE_CRYPTO_BENCH_PERF_COUNTERS_H
@@ -20,7 +20,9 @@ extern "C" {
  * @param aad Pointer to the Additional Associated Data (AAD). Can be NULL if aad_len is 0.
  * @param aad_len Length of the AAD.
  * @param out_ciphertext_tag Pointer to the output buffer where the ciphertext and authentication tag will be written.
+ * May be the same pointer as plaintext (in-place), but must not partially overlap it.
  * @return The total number of bytes written (ciphertext + tag) on success, or a negative error code.
+ * Outputs above INT_MAX are refused with -1; use the _ex variant for those.
  */
 int encrypt_aes_gcm_256(
         const uint8_t* plaintext, size_t plaintext_len,
@@ -41,7 +43,9 @@ int encrypt_aes_gcm_256(
  * @param aad Pointer to the Additional Associated Data (AAD) used during encryption. Can be NULL if aad_len is 0.
  * @param aad_len Length of the AAD.
  * @param out_plaintext Pointer to the output buffer where the decrypted plaintext will be written.
+ * May be the same pointer as ciphertext_tag (in-place), but must not partially overlap it.
  * @return The number of bytes written to out_plaintext on success (plaintext length), or a negative error code.
+ * Outputs above INT_MAX are refused with -1; use the _ex variant for those.
  */
 int decrypt_aes_gcm_256(
         const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
@@ -62,7 +66,9 @@ int decrypt_aes_gcm_256(
  * @param aad Pointer to the Additional Associated Data (AAD). Can be NULL if aad_len is 0.
  * @param aad_len Length of the AAD.
  * @param out_ciphertext_tag Pointer to the output buffer where the ciphertext and authentication tag will be written.
+ * May be the same pointer as plaintext (in-place), but must not partially overlap it.
  * @return The total number of bytes written (ciphertext + tag) on success, or a negative error code.
+ * Outputs above INT_MAX are refused with -1; use the _ex variant for those.
  */
 int encrypt_chacha20_poly1305(
         const uint8_t* plaintext, size_t plaintext_len,
@@ -83,7 +89,9 @@ int encrypt_chacha20_poly1305(
  * @param aad Pointer to the Additional Associated Data (AAD) used during encryption. Can be NULL if aad_len is 0.
  * @param aad_len Length of the AAD.
  * @param out_plaintext Pointer to the output buffer where the decrypted plaintext will be written.
+ * May be the same pointer as ciphertext_tag (in-place), but must not partially overlap it.
  * @return The number of bytes written to out_plaintext on success (plaintext length), or a negative error code.
+ * Outputs above INT_MAX are refused with -1; use the _ex variant for those.
  */
 int decrypt_chacha20_poly1305(
         const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
@@ -93,6 +101,1298 @@ int decrypt_chacha20_poly1305(
         uint8_t* out_plaintext
 );
 
+// --- Handle-based API ---
+// The functions above initialize and destroy a BoringSSL AEAD context on every call.
+// The handle API below keeps one initialized context per key so the key schedule
+// (and, for AES-GCM, the GHASH tables) is computed only once.
+
+/** @brief Algorithm identifier for AES-256-GCM. */
+#define NC_ALG_AES_256_GCM 0
+/** @brief Algorithm identifier for ChaCha20-Poly1305. */
+#define NC_ALG_CHACHA20_POLY1305 1
+/** @brief Algorithm identifier for AES-128-GCM (16-byte key). */
+#define NC_ALG_AES_128_GCM 2
+/** @brief Algorithm identifier for AES-256-GCM-SIV (nonce-misuse resistant, RFC 8452). */
+#define NC_ALG_AES_256_GCM_SIV 3
+/** @brief Algorithm identifier for XChaCha20-Poly1305 (24-byte nonce). */
+#define NC_ALG_XCHACHA20_POLY1305 4
+
+/** @brief Returned for invalid parameters or initialization errors. */
+#define NC_ERR_INVALID_ARGUMENT (-1)
+/** @brief Returned when the authentication tag does not match or the input is too short. */
+#define NC_ERR_AUTHENTICATION (-2)
+/** @brief Returned when a feature or measurement is not available on this platform. */
+#define NC_ERR_UNSUPPORTED (-3)
+/** @brief Returned when a file could not be opened, sized, mapped or written. */
+#define NC_ERR_IO (-4)
+
+/**
+ * @brief Opaque AEAD context bound to a single algorithm and key.
+ *
+ * A context can be used for both sealing and opening. Once created only its nonce
+ * counter changes (atomically, see nc_aead_generate_nonces()), so it may be shared
+ * between threads that call any of the nc_aead_* functions concurrently.
+ */
+typedef struct nc_aead_ctx nc_aead_ctx;
+
+/**
+ * @brief Creates an AEAD context and expands the key once.
+ *
+ * @param algorithm One of the NC_ALG_* identifiers, or NC_ALG_AUTO for a seal-only context.
+ * @param key Pointer to the key bytes.
+ * @param key_len Length of the key (must match the algorithm, see nc_algorithm_info_get()).
+ * @return A new context on success, or NULL for an unknown algorithm, a bad key length or an allocation failure.
+ * The context must be released with nc_aead_ctx_free().
+ */
+nc_aead_ctx* nc_aead_ctx_new(int algorithm, const uint8_t* key, size_t key_len);
+
+/**
+ * @brief Wipes the key material held by a context and releases it.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new(). NULL is ignored.
+ */
+void nc_aead_ctx_free(nc_aead_ctx* ctx);
+
+/**
+ * @brief Returns the NC_ALG_* identifier a context seals and opens with.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new().
+ * @return The algorithm identifier, or NC_ERR_INVALID_ARGUMENT if ctx is NULL.
+ */
+int nc_aead_ctx_algorithm(const nc_aead_ctx* ctx);
+
+/**
+ * @brief Encrypts plaintext with a previously created context.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new().
+ * @param plaintext Pointer to the plaintext data to encrypt.
+ * @param plaintext_len Length of the plaintext data.
+ * @param nonce Pointer to the nonce (must be unique for every message sealed with this context).
+ * @param nonce_len Length of the nonce (the context algorithm's nonce length, see nc_algorithm_info_get()).
+ * @param aad Pointer to the Additional Associated Data (AAD). Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @param out_ciphertext_tag Pointer to the output buffer (plaintext_len + 16 bytes).
+ * May be the same pointer as plaintext (in-place), but must not partially overlap it.
+ * @return The total number of bytes written (ciphertext + tag) on success, or NC_ERR_INVALID_ARGUMENT
+ * (also for outputs above INT_MAX; see nc_aead_seal_ex()).
+ */
+int nc_aead_seal(
+        const nc_aead_ctx* ctx,
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* nonce,     size_t nonce_len,
+        const uint8_t* aad,       size_t aad_len,
+        uint8_t* out_ciphertext_tag
+);
+
+/**
+ * @brief Decrypts and verifies ciphertext with a previously created context.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new().
+ * @param ciphertext_tag Pointer to the combined ciphertext and authentication tag.
+ * @param ciphertext_tag_len Length of the combined ciphertext and tag.
+ * @param nonce Pointer to the nonce used during encryption.
+ * @param nonce_len Length of the nonce (the context algorithm's nonce length, see nc_algorithm_info_get()).
+ * @param aad Pointer to the AAD used during encryption. Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @param out_plaintext Pointer to the output buffer (ciphertext_tag_len - 16 bytes).
+ * May be the same pointer as ciphertext_tag (in-place), but must not partially overlap it.
+ * @return The number of plaintext bytes written on success, NC_ERR_INVALID_ARGUMENT (also for outputs
+ * above INT_MAX; see nc_aead_open_ex()), NC_ERR_AUTHENTICATION, or NC_ERR_UNSUPPORTED for a context
+ * created from NC_ALG_AUTO.
+ */
+int nc_aead_open(
+        const nc_aead_ctx* ctx,
+        const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
+        const uint8_t* nonce,          size_t nonce_len,
+        const uint8_t* aad,            size_t aad_len,
+        uint8_t* out_plaintext
+);
+
+// --- Nonce generation API ---
+// Generates 12-byte nonces natively instead of in the caller, in bulk and without a separate
+// call before every seal.
+//   - NC_NONCE_COUNTER: a random 4-byte prefix fixed at context creation followed by a 64-bit
+//     big-endian counter, advanced atomically. Unique for the lifetime of the context, but only
+//     across contexts by chance of the prefix: for many messages under one key, keep one long-lived
+//     context rather than creating one per message.
+//   - NC_NONCE_RANDOM: RAND_bytes. No state, so it also works without a context, but a key should
+//     seal fewer than 2^32 messages with random 96-bit nonces.
+// Generated nonces must not be mixed with caller-chosen ones under the same key.
+
+/** @brief Length of every generated nonce. */
+#define NC_NONCE_LEN 12
+/** @brief Nonce mode: per-context prefix || atomic 64-bit counter. */
+#define NC_NONCE_COUNTER 0
+/** @brief Nonce mode: random bytes from the system CSPRNG. */
+#define NC_NONCE_RANDOM 1
+/** @brief Largest count accepted by nc_aead_generate_nonces(). */
+#define NC_MAX_NONCES_PER_CALL ((size_t)1 << 24)
+
+/**
+ * @brief Writes count nonces of NC_NONCE_LEN bytes each to out_nonces.
+ *
+ * @param ctx Context whose counter is used; may be NULL for NC_NONCE_RANDOM.
+ * @param mode NC_NONCE_COUNTER or NC_NONCE_RANDOM.
+ * @param out_nonces Output buffer of count * NC_NONCE_LEN bytes.
+ * @param count Number of nonces, at most NC_MAX_NONCES_PER_CALL.
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT (also when the counter is exhausted or the
+ *         random generator fails), or NC_ERR_UNSUPPORTED for NC_NONCE_COUNTER with an algorithm
+ *         whose nonce is not NC_NONCE_LEN bytes (XChaCha20-Poly1305). A refused request does not
+ *         advance the counter.
+ */
+int nc_aead_generate_nonces(nc_aead_ctx* ctx, int mode, uint8_t* out_nonces, size_t count);
+
+/**
+ * @brief Generates a nonce, seals plaintext with it and returns the nonce, in one call.
+ *
+ * @param out_nonce Receives the NC_NONCE_LEN-byte nonce, needed by nc_aead_open().
+ * @param out_ciphertext_tag As for nc_aead_seal() (plaintext_len + 16 bytes, in-place allowed).
+ * @return The number of bytes written (ciphertext + tag) on success, NC_ERR_INVALID_ARGUMENT, or
+ *         NC_ERR_UNSUPPORTED for an algorithm whose nonce is not NC_NONCE_LEN bytes
+ *         (XChaCha20-Poly1305, in either mode). A counter value is only consumed once the nonce
+ *         has been generated; if the seal itself then fails, that value is not reused.
+ */
+int nc_aead_seal_auto_nonce(
+        nc_aead_ctx* ctx, int mode,
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* aad,       size_t aad_len,
+        uint8_t* out_nonce, uint8_t* out_ciphertext_tag
+);
+
+// --- In-place API ---
+// Encrypts and decrypts within a single buffer, halving memory traffic and footprint compared to
+// separate input and output buffers.
+
+/**
+ * @brief Encrypts a buffer in place and appends the tag.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new().
+ * @param buffer Holds the plaintext on input and the ciphertext + tag on output.
+ * It must have room for plaintext_len + 16 bytes.
+ * @param plaintext_len Length of the plaintext at the start of buffer.
+ * @param nonce Pointer to the nonce (must be unique for every message sealed with this context).
+ * @param nonce_len Length of the nonce (the context algorithm's nonce length, see nc_algorithm_info_get()).
+ * @param aad Pointer to the AAD. Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @return The total number of bytes in buffer (ciphertext + tag) on success, or NC_ERR_INVALID_ARGUMENT.
+ */
+int nc_aead_seal_in_place(
+        const nc_aead_ctx* ctx,
+        uint8_t* buffer, size_t plaintext_len,
+        const uint8_t* nonce,     size_t nonce_len,
+        const uint8_t* aad,       size_t aad_len
+);
+
+/**
+ * @brief Decrypts and verifies a buffer in place.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new().
+ * @param buffer Holds the ciphertext + tag on input and the plaintext (at its start) on output.
+ * @param ciphertext_tag_len Length of the ciphertext and tag in buffer.
+ * @param nonce Pointer to the nonce used during encryption.
+ * @param nonce_len Length of the nonce (the context algorithm's nonce length, see nc_algorithm_info_get()).
+ * @param aad Pointer to the AAD used during encryption. Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @return The number of plaintext bytes at the start of buffer on success, NC_ERR_INVALID_ARGUMENT or NC_ERR_AUTHENTICATION.
+ */
+int nc_aead_open_in_place(
+        const nc_aead_ctx* ctx,
+        uint8_t* buffer, size_t ciphertext_tag_len,
+        const uint8_t* nonce,          size_t nonce_len,
+        const uint8_t* aad,            size_t aad_len
+);
+
+// --- Batch API ---
+// Processes many small records in a single call (and a single FFI crossing) with one context.
+
+/**
+ * @brief Describes one record of a batch seal or open call.
+ *
+ * For sealing, `input` is the plaintext and `output` must hold input_len + 16 bytes.
+ * For opening, `input` is the ciphertext with its tag and `output` must hold input_len - 16 bytes.
+ */
+typedef struct nc_aead_batch_item {
+    const uint8_t* input;  // Plaintext (seal) or ciphertext + tag (open).
+    size_t input_len;      // Length of the input.
+    const uint8_t* nonce;  // Nonce for this record (the context algorithm's nonce length).
+    size_t nonce_len;      // Length of the nonce.
+    const uint8_t* aad;    // Additional Associated Data. Can be NULL if aad_len is 0.
+    size_t aad_len;        // Length of the AAD.
+    uint8_t* output;       // Output buffer for this record.
+} nc_aead_batch_item;
+
+/**
+ * @brief Encrypts every record of a batch with the same context.
+ *
+ * A failing record does not stop the batch; its status is recorded and processing continues.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new().
+ * @param items Array of `count` record descriptors.
+ * @param count Number of records in the batch.
+ * @param out_status Array of `count` entries that receives, per record, the same value nc_aead_seal() would return.
+ * @return The number of records sealed successfully, or NC_ERR_INVALID_ARGUMENT if ctx, items or out_status is NULL.
+ */
+int nc_aead_seal_batch(
+        const nc_aead_ctx* ctx,
+        const nc_aead_batch_item* items, size_t count,
+        int* out_status
+);
+
+/**
+ * @brief Decrypts and verifies every record of a batch with the same context.
+ *
+ * A failing record does not stop the batch; its status is recorded and processing continues.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new().
+ * @param items Array of `count` record descriptors.
+ * @param count Number of records in the batch.
+ * @param out_status Array of `count` entries that receives, per record, the same value nc_aead_open() would return.
+ * @return The number of records opened successfully, or NC_ERR_INVALID_ARGUMENT if ctx, items or out_status is NULL.
+ */
+int nc_aead_open_batch(
+        const nc_aead_ctx* ctx,
+        const nc_aead_batch_item* items, size_t count,
+        int* out_status
+);
+
+// --- Parallel segmented API ---
+// Large buffers are split into fixed-size segments that are sealed independently on an
+// internal thread pool (a STREAM construction). Every segment carries its own 16-byte tag and
+// is sealed under the nonce  prefix (7 bytes) || segment index (4 bytes, big-endian) || last flag (1 byte),
+// so segments cannot be reordered, dropped or truncated without detection.
+// The output format is not compatible with the single-shot functions above.
+
+/** @brief Length of the caller-supplied nonce prefix for the segmented API. */
+#define NC_SEGMENT_NONCE_PREFIX_LEN 7
+/** @brief Segment size used when 0 is passed as segment_size. */
+#define NC_DEFAULT_SEGMENT_SIZE (64 * 1024)
+
+/**
+ * @brief Returns the size of the segmented ciphertext for a given plaintext length.
+ *
+ * @param plaintext_len Length of the plaintext.
+ * @param segment_size Plaintext bytes per segment (0 selects NC_DEFAULT_SEGMENT_SIZE).
+ * @return plaintext_len plus 16 bytes per segment (an empty plaintext still produces one segment).
+ */
+size_t nc_segmented_ciphertext_len(size_t plaintext_len, size_t segment_size);
+
+/**
+ * @brief Encrypts a large buffer as independent segments on multiple threads.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new().
+ * @param plaintext Pointer to the plaintext data to encrypt.
+ * @param plaintext_len Length of the plaintext data.
+ * @param nonce_prefix Pointer to NC_SEGMENT_NONCE_PREFIX_LEN bytes, unique per message sealed with this context.
+ * @param aad Pointer to the AAD, authenticated with every segment. Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @param segment_size Plaintext bytes per segment (0 selects NC_DEFAULT_SEGMENT_SIZE).
+ * @param num_threads Maximum number of threads to use (0 uses one per online CPU, 1 runs on the calling thread).
+ * @param out Output buffer of nc_segmented_ciphertext_len(plaintext_len, segment_size) bytes.
+ * @param out_len Receives the number of bytes written to out.
+ * @return 0 on success, or NC_ERR_INVALID_ARGUMENT.
+ */
+int nc_parallel_seal(
+        const nc_aead_ctx* ctx,
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size, size_t num_threads,
+        uint8_t* out, size_t* out_len
+);
+
+/**
+ * @brief Decrypts and verifies a buffer produced by nc_parallel_seal() on multiple threads.
+ *
+ * If any segment fails verification the whole output buffer is zeroed, so no unauthenticated
+ * plaintext is released.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new().
+ * @param ciphertext Pointer to the segmented ciphertext.
+ * @param ciphertext_len Length of the segmented ciphertext.
+ * @param nonce_prefix Pointer to the NC_SEGMENT_NONCE_PREFIX_LEN bytes used during encryption.
+ * @param aad Pointer to the AAD used during encryption. Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @param segment_size Segment size used during encryption (0 selects NC_DEFAULT_SEGMENT_SIZE).
+ * @param num_threads Maximum number of threads to use (0 uses one per online CPU, 1 runs on the calling thread).
+ * @param out_plaintext Output buffer large enough for the plaintext (ciphertext_len bytes is always sufficient).
+ * @param out_plaintext_len Receives the number of plaintext bytes written.
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT or NC_ERR_AUTHENTICATION.
+ */
+int nc_parallel_open(
+        const nc_aead_ctx* ctx,
+        const uint8_t* ciphertext, size_t ciphertext_len,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size, size_t num_threads,
+        uint8_t* out_plaintext, size_t* out_plaintext_len
+);
+
+// --- Streaming API ---
+// Seals or opens a payload that arrives in arbitrary pieces, producing the same segmented format
+// as nc_parallel_seal(). Only one segment is buffered internally, so memory use is bounded by the
+// segment size rather than the payload size.
+
+/** @brief Opaque incremental seal or open operation. */
+typedef struct nc_stream nc_stream;
+
+/**
+ * @brief Starts an incremental seal.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new(). It must outlive the stream.
+ * @param nonce_prefix Pointer to NC_SEGMENT_NONCE_PREFIX_LEN bytes, unique per message sealed with this context.
+ * @param aad Pointer to the AAD, authenticated with every segment (copied). Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @param segment_size Plaintext bytes per segment (0 selects NC_DEFAULT_SEGMENT_SIZE).
+ * @return A new stream, or NULL for invalid parameters or an allocation failure. Release it with nc_stream_free().
+ */
+nc_stream* nc_stream_seal_new(
+        const nc_aead_ctx* ctx,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size
+);
+
+/**
+ * @brief Starts an incremental open of data produced by nc_stream_seal_new() or nc_parallel_seal().
+ *
+ * Plaintext is released one authenticated segment at a time. Truncation is only detected by
+ * nc_stream_final(), so the payload must be treated as invalid unless nc_stream_final() succeeds.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new(). It must outlive the stream.
+ * @param nonce_prefix Pointer to the NC_SEGMENT_NONCE_PREFIX_LEN bytes used during encryption.
+ * @param aad Pointer to the AAD used during encryption (copied). Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @param segment_size Segment size used during encryption (0 selects NC_DEFAULT_SEGMENT_SIZE).
+ * @return A new stream, or NULL for invalid parameters or an allocation failure. Release it with nc_stream_free().
+ */
+nc_stream* nc_stream_open_new(
+        const nc_aead_ctx* ctx,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size
+);
+
+/**
+ * @brief Returns the largest number of bytes nc_stream_update() may write for a given input length.
+ *
+ * @param stream Stream returned by nc_stream_seal_new() or nc_stream_open_new().
+ * @param in_len Length of the next piece of input.
+ * @return Upper bound on the bytes written by the next nc_stream_update() call.
+ */
+size_t nc_stream_max_output(const nc_stream* stream, size_t in_len);
+
+/**
+ * @brief Feeds the next piece of input and writes every segment that is now complete.
+ *
+ * @param stream Stream returned by nc_stream_seal_new() or nc_stream_open_new().
+ * @param in Pointer to the next piece of plaintext (seal) or ciphertext (open). Can be NULL if in_len is 0.
+ * @param in_len Length of the piece.
+ * @param out Output buffer of at least nc_stream_max_output(stream, in_len) bytes.
+ * @param out_len Receives the number of bytes written (may be 0).
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT or NC_ERR_AUTHENTICATION. After an error the stream only fails.
+ */
+int nc_stream_update(nc_stream* stream, const uint8_t* in, size_t in_len, uint8_t* out, size_t* out_len);
+
+/**
+ * @brief Processes the buffered last segment and completes the stream.
+ *
+ * @param stream Stream returned by nc_stream_seal_new() or nc_stream_open_new().
+ * @param out Output buffer of at least the segment size + 16 bytes.
+ * @param out_len Receives the number of bytes written.
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT or NC_ERR_AUTHENTICATION (including a truncated stream).
+ */
+int nc_stream_final(nc_stream* stream, uint8_t* out, size_t* out_len);
+
+/**
+ * @brief Wipes the buffered data of a stream and releases it.
+ *
+ * @param stream Stream to release. NULL is ignored.
+ */
+void nc_stream_free(nc_stream* stream);
+
+// --- Scatter/gather API ---
+// Keeps the ciphertext and the tag in separate buffers so record formats that store header,
+// body and tag in different places need no reassembly copy.
+
+/** @brief Length of the authentication tag written by the detached-tag functions. */
+#define NC_AEAD_TAG_LEN 16
+
+/** @brief One piece of a gathered input. */
+typedef struct nc_iovec {
+    const uint8_t* base; // Start of the piece. Can be NULL if len is 0.
+    size_t len;          // Length of the piece.
+} nc_iovec;
+
+/**
+ * @brief Encrypts gathered input, writing the ciphertext and the tag to separate buffers.
+ *
+ * A single piece is encrypted straight from its buffer. The AEAD primitives need contiguous input,
+ * so several pieces are first gathered directly into out_ciphertext and then encrypted in place there.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new().
+ * @param in Array of input pieces, concatenated in order to form the plaintext.
+ * @param in_count Number of pieces.
+ * @param nonce Pointer to the nonce (must be unique for every message sealed with this context).
+ * @param nonce_len Length of the nonce (the context algorithm's nonce length, see nc_algorithm_info_get()).
+ * @param aad Pointer to the AAD. Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @param out_ciphertext Output buffer for the ciphertext (total input length). May be the base of a
+ * single input piece (in-place), but must not otherwise overlap the input.
+ * @param out_tag Output buffer for the NC_AEAD_TAG_LEN-byte tag.
+ * @return The number of ciphertext bytes written on success, or NC_ERR_INVALID_ARGUMENT.
+ */
+int nc_aead_seal_scatter(
+        const nc_aead_ctx* ctx,
+        const nc_iovec* in, size_t in_count,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad,   size_t aad_len,
+        uint8_t* out_ciphertext,
+        uint8_t* out_tag
+);
+
+/**
+ * @brief Decrypts gathered ciphertext and verifies a tag stored in a separate buffer.
+ *
+ * Several input pieces are gathered directly into out_plaintext and decrypted in place there.
+ * On failure the output buffer is wiped.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new().
+ * @param in Array of ciphertext pieces (without the tag), concatenated in order.
+ * @param in_count Number of pieces.
+ * @param tag Pointer to the authentication tag.
+ * @param tag_len Length of the tag (must be NC_AEAD_TAG_LEN).
+ * @param nonce Pointer to the nonce used during encryption.
+ * @param nonce_len Length of the nonce (the context algorithm's nonce length, see nc_algorithm_info_get()).
+ * @param aad Pointer to the AAD used during encryption. Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @param out_plaintext Output buffer for the plaintext (total input length). May be the base of a
+ * single input piece (in-place), but must not otherwise overlap the input.
+ * @return The number of plaintext bytes written on success, NC_ERR_INVALID_ARGUMENT,
+ * NC_ERR_AUTHENTICATION, or NC_ERR_UNSUPPORTED for a context created from NC_ALG_AUTO.
+ */
+int nc_aead_open_gather(
+        const nc_aead_ctx* ctx,
+        const nc_iovec* in, size_t in_count,
+        const uint8_t* tag,   size_t tag_len,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad,   size_t aad_len,
+        uint8_t* out_plaintext
+);
+
+// --- Thread resource usage API ---
+// Lets a caller attribute CPU time, page faults and context switches to the work done on its own
+// thread (e.g. around a single FFI call), without a platform channel round trip and without the
+// noise of other threads in the process.
+
+/** @brief Resource usage of the calling thread, as cumulative counters since the thread started. */
+typedef struct nc_thread_usage {
+    uint64_t cpu_time_ns;          // User + system CPU time (CLOCK_THREAD_CPUTIME_ID).
+    uint64_t minor_faults;         // Page faults served without I/O.
+    uint64_t major_faults;         // Page faults that required I/O.
+    uint64_t voluntary_switches;   // Context switches because the thread blocked or yielded.
+    uint64_t involuntary_switches; // Context switches because the thread was preempted.
+} nc_thread_usage;
+
+/**
+ * @brief Returns the CPU time consumed by the calling thread.
+ *
+ * @return CPU time in nanoseconds, or 0 if the thread clock is unavailable.
+ */
+uint64_t nc_thread_cpu_time_ns(void);
+
+/**
+ * @brief Samples the resource usage of the calling thread.
+ *
+ * Take one sample before and one after the measured work and subtract them field by field.
+ *
+ * @param out_usage Output structure.
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT if out_usage is NULL, or NC_ERR_UNSUPPORTED if the
+ * platform has no per-thread rusage (only cpu_time_ns is filled in and the other fields are 0).
+ */
+int nc_thread_usage_get(nc_thread_usage* out_usage);
+
+// --- Memory sampler API ---
+// A background thread samples the resident set size (/proc/self/statm) and the bytes in use by
+// malloc (mallinfo2) at a fixed rate while a phase runs, so transient peaks inside a single large
+// seal or open are seen instead of only the values between operations.
+
+/** @brief Sampling rate used when 0 is passed to nc_mem_sampler_new(). */
+#define NC_MEM_SAMPLER_DEFAULT_HZ 1000
+
+/** @brief Opaque background memory sampler. */
+typedef struct nc_mem_sampler nc_mem_sampler;
+
+/** @brief Memory statistics of one phase, in bytes. */
+typedef struct nc_mem_stats {
+    uint64_t samples;          // Number of samples, including the ones taken at begin and end.
+    uint64_t rss_start_bytes;  // RSS when the phase began.
+    uint64_t rss_end_bytes;    // RSS when the phase ended.
+    uint64_t rss_avg_bytes;    // Mean RSS over all samples.
+    uint64_t rss_peak_bytes;   // Highest RSS sample.
+    uint64_t heap_start_bytes; // Heap bytes in use (small blocks + mmapped chunks) when the phase began.
+    uint64_t heap_end_bytes;   // Heap bytes in use when the phase ended.
+    uint64_t heap_avg_bytes;   // Mean heap bytes in use over all samples.
+    uint64_t heap_peak_bytes;  // Highest heap sample.
+    int heap_supported;        // 0 if the C library has no mallinfo (heap fields are then 0).
+} nc_mem_stats;
+
+/**
+ * @brief Starts a sampler thread. The thread sleeps until nc_mem_sampler_begin() is called.
+ *
+ * Reading mallinfo briefly takes the malloc arena locks, so very high rates slow down
+ * allocation-heavy code under measurement.
+ *
+ * @param rate_hz Samples per second while a phase runs (0 for NC_MEM_SAMPLER_DEFAULT_HZ).
+ * @return The sampler, or NULL on failure or on platforms without /proc (e.g. Windows).
+ */
+nc_mem_sampler* nc_mem_sampler_new(unsigned int rate_hz);
+
+/**
+ * @brief Resets the statistics, takes the first sample on the calling thread and starts sampling.
+ *
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT if the sampler is NULL or a phase is already running.
+ */
+int nc_mem_sampler_begin(nc_mem_sampler* sampler);
+
+/**
+ * @brief Takes the last sample on the calling thread, stops sampling and returns the phase statistics.
+ *
+ * @param sampler Sampler with a running phase.
+ * @param out_stats Output statistics.
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT if no phase is running or an argument is NULL.
+ */
+int nc_mem_sampler_end(nc_mem_sampler* sampler, nc_mem_stats* out_stats);
+
+/**
+ * @brief Stops the sampler thread and releases the sampler.
+ *
+ * @param sampler Sampler to release. NULL is ignored.
+ */
+void nc_mem_sampler_free(nc_mem_sampler* sampler);
+
+// --- Error reporting API ---
+// Failures reported by BoringSSL are never printed. They are counted per thread and, when enabled,
+// kept in a bounded in-memory ring, so rejecting a flood of forged records stays as cheap as the
+// tag check itself. Building with NATIVE_CRYPTO_LOG_ERRORS defined prints one line per failure.
+
+/** @brief Failure counts of the calling thread since it started or since the last reset. */
+typedef struct nc_error_counters {
+    uint64_t init_failures; // Key setups rejected by BoringSSL (EVP_AEAD_CTX_init).
+    uint64_t seal_failures; // Seal operations that failed inside BoringSSL.
+    uint64_t auth_failures; // Open operations that rejected their input (tag mismatch or malformed length).
+} nc_error_counters;
+
+/** @brief One recorded failure. */
+typedef struct nc_error_entry {
+    uint64_t sequence;      // Number of the failure since the ring was configured.
+    uint32_t library_error; // First packed BoringSSL error code (ERR_get_error()), 0 if none.
+    int code;               // NC_ERR_* value returned to the caller.
+    const char* context;    // Static description of the failing operation.
+} nc_error_entry;
+
+/**
+ * @brief Copies the failure counters of the calling thread.
+ *
+ * @param out_counters Output counters. NULL is ignored.
+ */
+void nc_error_counters_get(nc_error_counters* out_counters);
+
+/** @brief Resets the failure counters of the calling thread. */
+void nc_error_counters_reset(void);
+
+/**
+ * @brief Enables, resizes or disables (capacity 0) the process-wide error ring.
+ *
+ * The ring keeps the last capacity failures of all threads and is cleared by every call.
+ * It is disabled by default.
+ *
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT if the ring could not be allocated.
+ */
+int nc_error_ring_configure(size_t capacity);
+
+/**
+ * @brief Copies the most recent failures in the ring, oldest first.
+ *
+ * @param out_entries Output array.
+ * @param max_entries Capacity of out_entries.
+ * @return The number of entries written.
+ */
+size_t nc_error_ring_snapshot(nc_error_entry* out_entries, size_t max_entries);
+
+// --- Key-schedule cache API ---
+// Opt-in cache behind the stateless encrypt_* / decrypt_* functions: every thread keeps its most
+// recently used initialized contexts keyed on (algorithm, key), so repeated calls with the same
+// key skip the key setup without any change to those signatures. Evicted entries are wiped.
+// Note that enabling the cache keeps copies of recently used keys in memory until they are
+// evicted, flushed or the thread exits.
+
+/** @brief Largest supported per-thread cache capacity. */
+#define NC_KEY_CACHE_MAX_ENTRIES 64
+
+/**
+ * @brief Enables (capacity > 0), resizes or disables (capacity 0, the default) the key-schedule cache.
+ *
+ * The setting applies to all threads. Each thread drops (and wipes) its current cache and starts
+ * with the new capacity on its next stateless call; the calling thread does so immediately.
+ *
+ * @param capacity Entries per thread, at most NC_KEY_CACHE_MAX_ENTRIES.
+ * @return 0 on success, or NC_ERR_INVALID_ARGUMENT if capacity is too large.
+ */
+int nc_key_cache_configure(size_t capacity);
+
+/** @brief Wipes every cached context of the calling thread. */
+void nc_key_cache_flush(void);
+
+// --- Buffer pool API ---
+// Aligned buffers for FFI callers that would otherwise allocate and free their input, key, nonce
+// and output buffers around every call. Released buffers are kept on per-thread free lists, one
+// per power-of-two size class from 64 B up to NC_BUF_MAX_POOLED_SIZE, and are handed out again
+// without a system allocation. Each class has room for a payload of its size plus an AEAD tag.
+// Buffers are not zeroed on acquire, and nc_buf_release() does not wipe them: release buffers that
+// held a key or plaintext with nc_buf_release_wipe().
+
+/** @brief Alignment, in bytes, of every buffer returned by nc_buf_acquire(). */
+#define NC_BUF_ALIGNMENT 64
+/** @brief Largest payload size class; larger requests bypass the free lists. */
+#define NC_BUF_MAX_POOLED_SIZE (4 * 1024 * 1024)
+
+/**
+ * @brief Returns an uninitialized buffer of at least size bytes, aligned to NC_BUF_ALIGNMENT.
+ *
+ * @param size Requested size in bytes (0 returns a buffer of the smallest class).
+ * @return The buffer, to be passed to nc_buf_release(), or NULL if memory is exhausted.
+ */
+void* nc_buf_acquire(size_t size);
+
+/**
+ * @brief Returns a buffer obtained from nc_buf_acquire() to the calling thread's free list.
+ *
+ * Buffers may be released on any thread. Releasing NULL does nothing. Releasing a buffer twice,
+ * or any pointer not returned by nc_buf_acquire(), is undefined behaviour: once a free list is
+ * full, or for buffers above NC_BUF_MAX_POOLED_SIZE, the memory goes back to the system allocator,
+ * and a second release would touch freed memory or a block that has since been handed out again.
+ */
+void nc_buf_release(void* buf);
+
+/**
+ * @brief Clears the first wipe_len bytes of a buffer (OPENSSL_cleanse), then releases it.
+ *
+ * For buffers that held a key or plaintext. wipe_len is capped at the buffer's capacity; the same
+ * rules as nc_buf_release() apply otherwise.
+ */
+void nc_buf_release_wipe(void* buf, size_t wipe_len);
+
+/**
+ * @brief Returns the usable size of a buffer obtained from nc_buf_acquire() and not yet released (0 if buf is NULL).
+ */
+size_t nc_buf_capacity(const void* buf);
+
+/** @brief Returns every buffer cached by the calling thread to the system allocator. */
+void nc_buf_pool_trim(void);
+
+// --- File API ---
+// Seals or opens a file on disk without the caller ever holding it in memory. Both files are
+// memory-mapped and processed in the segmented format of nc_parallel_seal(), so a sealed file can
+// also be opened with nc_parallel_open() or the streaming API. Input is read ahead and output is
+// written back window by window while the segments are processed. Not available on Windows.
+// The output's blocks are reserved up front, so a full disk or quota fails with NC_ERR_IO before
+// any segment is written. The input must not be truncated while a call runs: reading a mapped
+// page past the new end raises SIGBUS, which terminates the process.
+
+/**
+ * @brief Encrypts the file at in_path into the file at out_path (created or replaced, mode 0600).
+ *
+ * @param ctx Context returned by nc_aead_ctx_new().
+ * @param in_path Path of the plaintext file.
+ * @param out_path Path of the segmented ciphertext file; it must not be the input file.
+ * @param nonce_prefix Pointer to NC_SEGMENT_NONCE_PREFIX_LEN bytes, unique per message sealed with this context.
+ * @param aad Pointer to the AAD, authenticated with every segment. Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @param segment_size Plaintext bytes per segment (0 selects NC_DEFAULT_SEGMENT_SIZE).
+ * @param out_len Receives the size of the output file. Can be NULL.
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT, NC_ERR_IO, or NC_ERR_UNSUPPORTED (the file is too
+ *         large to map on this platform, or Windows). On failure the output file is removed.
+ */
+int nc_file_seal(
+        const nc_aead_ctx* ctx,
+        const char* in_path, const char* out_path,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size, uint64_t* out_len
+);
+
+/**
+ * @brief Decrypts and verifies a file produced by nc_file_seal() into the file at out_path.
+ *
+ * Segments are verified as they are written; if any segment fails, or the file was truncated,
+ * the output file is removed, so no unauthenticated plaintext is left behind.
+ *
+ * @param ctx Context returned by nc_aead_ctx_new().
+ * @param in_path Path of the segmented ciphertext file.
+ * @param out_path Path of the plaintext file (created or replaced, mode 0600); it must not be the input file.
+ * @param nonce_prefix Pointer to the NC_SEGMENT_NONCE_PREFIX_LEN bytes used during encryption.
+ * @param aad Pointer to the AAD used during encryption. Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @param segment_size Segment size used during encryption (0 selects NC_DEFAULT_SEGMENT_SIZE).
+ * @param out_plaintext_len Receives the size of the output file. Can be NULL.
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT, NC_ERR_AUTHENTICATION, NC_ERR_IO or NC_ERR_UNSUPPORTED.
+ */
+int nc_file_open(
+        const nc_aead_ctx* ctx,
+        const char* in_path, const char* out_path,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size, uint64_t* out_plaintext_len
+);
+
+// --- io_uring file API ---
+// Linux engine for bulk file workloads, with the same inputs and output format as the file API.
+// Reads and writes are submitted through io_uring into a fixed set of registered buffers (one per
+// queue slot); every completed read is sealed or opened in place on the worker threads while the
+// kernel keeps the other slots' reads and writes in flight. Elsewhere, or where io_uring is
+// disabled (older kernels, seccomp sandboxes such as Android apps), NC_ERR_UNSUPPORTED is returned.
+
+/** @brief Queue depth (segments in flight) used when 0 is passed as queue_depth. */
+#define NC_URING_DEFAULT_QUEUE_DEPTH 32
+/** @brief Largest accepted queue depth. */
+#define NC_URING_MAX_QUEUE_DEPTH 1024
+
+/**
+ * @brief Returns 1 if io_uring can be used in this process, 0 otherwise.
+ */
+int nc_uring_available(void);
+
+/**
+ * @brief Encrypts the file at in_path into out_path using io_uring (see nc_file_seal()).
+ *
+ * @param queue_depth Segments in flight at once, at most NC_URING_MAX_QUEUE_DEPTH (0 selects
+ *        NC_URING_DEFAULT_QUEUE_DEPTH). Each needs segment_size + 16 bytes of buffer.
+ * @param num_threads Maximum number of crypto threads (0 uses one per online CPU, 1 runs on the calling thread).
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT, NC_ERR_IO or NC_ERR_UNSUPPORTED. On failure the
+ *         output file is removed.
+ */
+int nc_uring_file_seal(
+        const nc_aead_ctx* ctx,
+        const char* in_path, const char* out_path,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size, size_t queue_depth, size_t num_threads,
+        uint64_t* out_len
+);
+
+/**
+ * @brief Decrypts and verifies a file produced by nc_file_seal() or nc_uring_file_seal() using io_uring.
+ *
+ * Only verified segments are written; on any failure the output file is removed.
+ *
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT, NC_ERR_AUTHENTICATION, NC_ERR_IO or NC_ERR_UNSUPPORTED.
+ */
+int nc_uring_file_open(
+        const nc_aead_ctx* ctx,
+        const char* in_path, const char* out_path,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size, size_t queue_depth, size_t num_threads,
+        uint64_t* out_plaintext_len
+);
+
+// --- Asynchronous API ---
+// Submits single seal/open calls to the library's long-lived worker pool and returns at once, so a
+// caller (e.g. a Dart isolate) does not need a thread or isolate of its own per operation. Each
+// completion carries the result and the worker thread's resource usage for that call, and is
+// delivered to a C callback, as a message to a Dart native port, or into a completion ring.
+//
+// Requests travel through lock-free rings: any thread pushes into a queue's submission ring
+// (multi-producer, single-consumer) and its dispatcher thread drains it in batches onto the
+// workers, then publishes the batch's completions (single-producer, single-consumer) with one
+// wake-up. Threads only sleep on a mutex when a ring is empty, never to exchange entries.
+
+/** @brief Operation code for nc_async_submit(): nc_aead_seal(). */
+#define NC_ASYNC_SEAL 0
+/** @brief Operation code for nc_async_submit(): nc_aead_open(). */
+#define NC_ASYNC_OPEN 1
+
+/** @brief Outcome of one asynchronous operation. */
+typedef struct nc_async_completion {
+    int64_t request_id;    // Value passed at submission.
+    int result;            // Return value of nc_aead_seal()/nc_aead_open().
+    int usage_status;      // Return value of nc_thread_usage_get() on the worker.
+    nc_thread_usage usage; // Worker usage during the call (difference of two samples).
+} nc_async_completion;
+
+/**
+ * @brief Completion callback. Runs on the dispatcher thread; the completion is only valid during the call.
+ *
+ * Callbacks are called one at a time and delay the next batch while they run. They must not call
+ * nc_async_submit(), nc_async_submit_port() or nc_async_drain(), which may wait for the dispatcher.
+ */
+typedef void (*nc_async_callback)(const nc_async_completion* completion, void* user_data);
+
+/**
+ * @brief Queues nc_aead_seal() or nc_aead_open() on the worker pool.
+ *
+ * The arguments have the same meaning as for nc_aead_seal()/nc_aead_open() and must stay valid
+ * (and out unread) until the completion is delivered. Requests go through one process-wide queue;
+ * when all of its entries are in flight, this waits for a completion first. Where the library has
+ * no worker threads (Windows), the operation runs on the calling thread and completes before this
+ * returns.
+ *
+ * @param operation NC_ASYNC_SEAL or NC_ASYNC_OPEN.
+ * @param request_id Caller-chosen identifier, copied into the completion.
+ * @return 0 if the operation was queued (its own result is in the completion), or
+ *         NC_ERR_INVALID_ARGUMENT if ctx, operation or callback is invalid or memory is exhausted.
+ */
+int nc_async_submit(
+        const nc_aead_ctx* ctx, int operation,
+        const uint8_t* in, size_t in_len,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len,
+        uint8_t* out,
+        int64_t request_id, nc_async_callback callback, void* user_data
+);
+
+/**
+ * @brief Installs the Dart_PostCObject function used by nc_async_submit_port().
+ *
+ * Pass NativeApi.postCObject from dart:ffi; it stays valid for the lifetime of the process.
+ *
+ * @return 0 on success, or NC_ERR_INVALID_ARGUMENT if post_cobject is NULL.
+ */
+int nc_async_set_dart_post(void* post_cobject);
+
+/**
+ * @brief Like nc_async_submit(), but posts the completion to a Dart native port.
+ *
+ * The message is a List<int> of [request_id, result, usage_status, cpu_time_ns, minor_faults,
+ * major_faults, voluntary_switches, involuntary_switches].
+ *
+ * @param dart_port ReceivePort.sendPort.nativePort of the receiving isolate.
+ * @return 0 if the operation was queued, or NC_ERR_INVALID_ARGUMENT (also when
+ *         nc_async_set_dart_post() has not been called).
+ */
+int nc_async_submit_port(
+        const nc_aead_ctx* ctx, int operation,
+        const uint8_t* in, size_t in_len,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len,
+        uint8_t* out,
+        int64_t request_id, int64_t dart_port
+);
+
+/**
+ * @brief Blocks until every operation submitted so far through nc_async_submit() or
+ * nc_async_submit_port() has delivered its completion.
+ */
+void nc_async_drain(void);
+
+/** @brief Queue depth (operations in flight) used when 0 is passed to nc_async_queue_new(). */
+#define NC_ASYNC_DEFAULT_QUEUE_DEPTH 256
+/** @brief Largest accepted queue depth. */
+#define NC_ASYNC_MAX_QUEUE_DEPTH 65536
+
+/** @brief One operation for nc_async_queue_submit(); the fields match nc_async_submit(). */
+typedef struct nc_async_request {
+    const nc_aead_ctx* ctx;
+    int operation;          // NC_ASYNC_SEAL or NC_ASYNC_OPEN.
+    const uint8_t* in;
+    size_t in_len;
+    const uint8_t* nonce;
+    size_t nonce_len;
+    const uint8_t* aad;
+    size_t aad_len;
+    uint8_t* out;
+    int64_t request_id;     // Copied into the completion.
+} nc_async_request;
+
+/** @brief Opaque pair of submission and completion rings served by one dispatcher thread. */
+typedef struct nc_async_queue nc_async_queue;
+
+/**
+ * @brief Creates a queue with its own dispatcher thread.
+ *
+ * @param depth Maximum number of operations submitted but not yet reaped, at most
+ *        NC_ASYNC_MAX_QUEUE_DEPTH (0 selects NC_ASYNC_DEFAULT_QUEUE_DEPTH).
+ * @return The queue, or NULL on invalid depth, exhausted memory or where threads are unavailable (Windows).
+ */
+nc_async_queue* nc_async_queue_new(size_t depth);
+
+/**
+ * @brief Queues operations without blocking. Any number of threads may submit concurrently.
+ *
+ * The dispatcher is woken at most once per call. Submission stops at the first request with a
+ * NULL ctx or an unknown operation, or when the queue is full.
+ *
+ * @return The number of leading requests queued (0 to count).
+ */
+size_t nc_async_queue_submit(nc_async_queue* queue, const nc_async_request* requests, size_t count);
+
+/**
+ * @brief Moves up to max completions into out, oldest first, waiting until at least min_complete
+ * are available. Only one thread may reap a queue at a time.
+ *
+ * min_complete is capped at the number of operations in flight, so the call never waits forever.
+ *
+ * @return The number of completions written.
+ */
+size_t nc_async_queue_reap(nc_async_queue* queue, nc_async_completion* out, size_t max, size_t min_complete);
+
+/**
+ * @brief Runs every submitted operation, stops the dispatcher and releases the queue. Completions
+ * that were not reaped are discarded. NULL is ignored.
+ */
+void nc_async_queue_free(nc_async_queue* queue);
+
+// --- Random data API ---
+// Fills buffers with random bytes natively, e.g. benchmark payloads that would be slow to build
+// byte by byte in Dart.
+
+/** @brief Random mode: bytes from the system CSPRNG (RAND_bytes). */
+#define NC_RANDOM_CRYPTO 0
+/**
+ * @brief Random mode: deterministic xoshiro256** stream from a 64-bit seed. Not for keys or
+ * nonces; the same seed gives the same bytes on every platform, for reproducible test inputs.
+ */
+#define NC_RANDOM_SEEDED 1
+
+/**
+ * @brief Fills buf with len random bytes.
+ *
+ * @param mode NC_RANDOM_CRYPTO or NC_RANDOM_SEEDED.
+ * @param seed Seed of the NC_RANDOM_SEEDED mode (ignored by NC_RANDOM_CRYPTO).
+ * @return 0 on success, or NC_ERR_INVALID_ARGUMENT for a bad argument or a failing generator.
+ */
+int nc_fill_random(uint8_t* buf, size_t len, int mode, uint64_t seed);
+
+// --- 64-bit length API ---
+// Same operations as the functions above, with the output length reported through a size_t
+// out-parameter instead of the int return value, so single messages above 2 GiB (e.g. whole
+// archives) can be processed. The AEADs still bound one message: about 64 GiB for AES-256-GCM
+// and 256 GiB for ChaCha20-Poly1305; longer inputs fail with an error.
+// Every function returns 0 on success or the negative error code of its int counterpart, and
+// sets *out_len to the number of bytes written (0 on failure).
+
+/** @brief encrypt_aes_gcm_256() with a 64-bit output length. */
+int encrypt_aes_gcm_256_ex(
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* key,
+        const uint8_t* nonce,     size_t nonce_len,
+        const uint8_t* aad,       size_t aad_len,
+        uint8_t* out_ciphertext_tag,
+        size_t* out_len
+);
+
+/** @brief decrypt_aes_gcm_256() with a 64-bit output length. */
+int decrypt_aes_gcm_256_ex(
+        const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
+        const uint8_t* key,
+        const uint8_t* nonce,          size_t nonce_len,
+        const uint8_t* aad,            size_t aad_len,
+        uint8_t* out_plaintext,
+        size_t* out_len
+);
+
+/** @brief encrypt_chacha20_poly1305() with a 64-bit output length. */
+int encrypt_chacha20_poly1305_ex(
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* key,
+        const uint8_t* nonce,     size_t nonce_len,
+        const uint8_t* aad,       size_t aad_len,
+        uint8_t* out_ciphertext_tag,
+        size_t* out_len
+);
+
+/** @brief decrypt_chacha20_poly1305() with a 64-bit output length. */
+int decrypt_chacha20_poly1305_ex(
+        const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
+        const uint8_t* key,
+        const uint8_t* nonce,          size_t nonce_len,
+        const uint8_t* aad,            size_t aad_len,
+        uint8_t* out_plaintext,
+        size_t* out_len
+);
+
+/** @brief nc_aead_seal() with a 64-bit output length. */
+int nc_aead_seal_ex(
+        const nc_aead_ctx* ctx,
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* nonce,     size_t nonce_len,
+        const uint8_t* aad,       size_t aad_len,
+        uint8_t* out_ciphertext_tag,
+        size_t* out_len
+);
+
+/** @brief nc_aead_open() with a 64-bit output length. */
+int nc_aead_open_ex(
+        const nc_aead_ctx* ctx,
+        const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
+        const uint8_t* nonce,          size_t nonce_len,
+        const uint8_t* aad,            size_t aad_len,
+        uint8_t* out_plaintext,
+        size_t* out_len
+);
+
+// --- Verify-only API ---
+// Checks the authentication tag of a stored message without producing its plaintext, e.g. for
+// integrity scrubbing. Nothing is written to caller memory and the ciphertext is only hashed,
+// never decrypted: AES-GCM runs GHASH alone (no CTR keystream), ChaCha20-Poly1305 runs Poly1305
+// alone (one ChaCha20 block for the MAC key), so roughly half the work and bandwidth of an open.
+
+/**
+ * @brief Verifies an AES-256-GCM ciphertext and tag without decrypting it.
+ *
+ * @param ciphertext_tag Pointer to the combined ciphertext and authentication tag.
+ * @param ciphertext_tag_len Length of the combined ciphertext and tag.
+ * @param key Pointer to the 256-bit (32-byte) key.
+ * @param nonce Pointer to the nonce used during encryption.
+ * @param nonce_len Length of the nonce (must be 12 bytes).
+ * @param aad Pointer to the AAD used during encryption. Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @return 0 if the tag is valid, -1 for invalid parameters or initialization errors,
+ * -2 for a tag mismatch or if ciphertext_tag_len is too short.
+ */
+int verify_aes_gcm_256(
+        const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
+        const uint8_t* key,
+        const uint8_t* nonce,          size_t nonce_len,
+        const uint8_t* aad,            size_t aad_len
+);
+
+/**
+ * @brief Verifies a ChaCha20-Poly1305 ciphertext and tag without decrypting it.
+ *
+ * Parameters and return values are those of verify_aes_gcm_256().
+ */
+int verify_chacha20_poly1305(
+        const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
+        const uint8_t* key,
+        const uint8_t* nonce,          size_t nonce_len,
+        const uint8_t* aad,            size_t aad_len
+);
+
+// --- Seal-and-digest API ---
+// Seals a message and computes a digest of its plaintext in one pass over the input, for callers
+// that store a plaintext hash next to each ciphertext. The input is walked in cache-sized tiles
+// that are hashed and sealed while still in L1/L2, instead of hashing in a second full pass.
+
+/** @brief Digest: SHA-256. */
+#define NC_DIGEST_SHA256 0
+/** @brief Digest: BLAKE2b with a 256-bit output. */
+#define NC_DIGEST_BLAKE2B_256 1
+/** @brief Length of every supported digest (bytes). */
+#define NC_DIGEST_LEN 32
+/** @brief Default tile size of nc_seal_digest() (bytes); fits comfortably in a typical L2. */
+#define NC_DEFAULT_TILE_SIZE (16 * 1024)
+
+/**
+ * @brief Computes a digest of data in one call.
+ *
+ * @param digest NC_DIGEST_SHA256 or NC_DIGEST_BLAKE2B_256.
+ * @param data Pointer to the data. Can be NULL if len is 0.
+ * @param len Length of the data.
+ * @param out_digest Receives NC_DIGEST_LEN bytes.
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT or NC_ERR_UNSUPPORTED (unknown digest).
+ */
+int nc_digest(int digest, const uint8_t* data, size_t len, uint8_t* out_digest);
+
+/**
+ * @brief Seals plaintext and computes a digest of it in a single tiled pass.
+ *
+ * The output is the same ciphertext || tag as encrypt_aes_gcm_256() or encrypt_chacha20_poly1305()
+ * produce for the same inputs, and the digest equals nc_digest() over the plaintext.
+ *
+ * @param algorithm NC_ALG_AES_256_GCM or NC_ALG_CHACHA20_POLY1305.
+ * @param key Pointer to the 32-byte key.
+ * @param key_len Length of the key (must be 32 bytes).
+ * @param plaintext Pointer to the plaintext. Can be NULL if plaintext_len is 0.
+ * @param plaintext_len Length of the plaintext.
+ * @param nonce Pointer to the nonce.
+ * @param nonce_len Length of the nonce (must be 12 bytes).
+ * @param aad Pointer to the AAD. Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @param digest NC_DIGEST_SHA256 or NC_DIGEST_BLAKE2B_256.
+ * @param tile_size Bytes hashed and sealed per step, rounded down to a multiple of 64
+ * (0 selects NC_DEFAULT_TILE_SIZE).
+ * @param out_ciphertext_tag Output buffer of plaintext_len + 16 bytes. May be the same pointer as
+ * plaintext (in-place), but must not partially overlap it.
+ * @param out_len Receives the number of bytes written (plaintext_len + 16; 0 on failure).
+ * @param out_digest Receives the NC_DIGEST_LEN-byte digest of the plaintext.
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT or NC_ERR_UNSUPPORTED (unknown algorithm or digest).
+ */
+int nc_seal_digest(
+        int algorithm,
+        const uint8_t* key,       size_t key_len,
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* nonce,     size_t nonce_len,
+        const uint8_t* aad,       size_t aad_len,
+        int digest, size_t tile_size,
+        uint8_t* out_ciphertext_tag, size_t* out_len,
+        uint8_t* out_digest
+);
+
+// --- Algorithm registry API ---
+// Every NC_ALG_* algorithm is listed in one registry, which the handle-based API and the
+// functions below dispatch through. The segmented modes (parallel, streaming, file, io_uring)
+// and counter nonces build 12-byte nonces, so they reject XChaCha20-Poly1305 contexts.
+
+/**
+ * @brief Description of a registered algorithm.
+ */
+typedef struct {
+    int id;           // NC_ALG_* identifier.
+    const char* name; // Display name, e.g. "AES-256-GCM" (static storage).
+    size_t key_len;   // Required key length in bytes.
+    size_t nonce_len; // Required nonce length in bytes.
+    size_t tag_len;   // Bytes a seal adds to the plaintext.
+} nc_algorithm_info;
+
+/**
+ * @brief Returns the number of registered algorithms.
+ */
+size_t nc_algorithm_count(void);
+
+/**
+ * @brief Describes the registered algorithm at an index, for enumerating every algorithm.
+ *
+ * @param index Index below nc_algorithm_count().
+ * @param out_info Receives the description.
+ * @return 0 on success, or NC_ERR_INVALID_ARGUMENT for an index out of range.
+ */
+int nc_algorithm_info_at(size_t index, nc_algorithm_info* out_info);
+
+/**
+ * @brief Describes the algorithm with an NC_ALG_* identifier.
+ *
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT, or NC_ERR_UNSUPPORTED for an unknown identifier.
+ */
+int nc_algorithm_info_get(int algorithm, nc_algorithm_info* out_info);
+
+/**
+ * @brief Encrypts plaintext with any registered algorithm.
+ *
+ * encrypt_aes_gcm_256_ex() and encrypt_chacha20_poly1305_ex() are this function with a fixed algorithm.
+ *
+ * @param algorithm One of the NC_ALG_* identifiers.
+ * @param key Pointer to the key.
+ * @param key_len Length of the key (must match the algorithm).
+ * @param plaintext Pointer to the plaintext data to encrypt.
+ * @param plaintext_len Length of the plaintext data.
+ * @param nonce Pointer to the nonce.
+ * @param nonce_len Length of the nonce (must match the algorithm).
+ * @param aad Pointer to the AAD. Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @param out_ciphertext_tag Output buffer of plaintext_len + tag_len bytes. May be the same pointer as
+ * plaintext (in-place), but must not partially overlap it.
+ * @param out_len Receives the number of bytes written (0 on failure).
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT, or NC_ERR_UNSUPPORTED for an unknown algorithm.
+ */
+int nc_seal(
+        int algorithm,
+        const uint8_t* key,       size_t key_len,
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* nonce,     size_t nonce_len,
+        const uint8_t* aad,       size_t aad_len,
+        uint8_t* out_ciphertext_tag, size_t* out_len
+);
+
+/**
+ * @brief Decrypts and verifies ciphertext with any registered algorithm.
+ *
+ * Parameters mirror nc_seal(); out_plaintext needs ciphertext_tag_len - tag_len bytes.
+ *
+ * @return 0 on success, NC_ERR_INVALID_ARGUMENT, NC_ERR_AUTHENTICATION (tag mismatch or input
+ * shorter than the tag), or NC_ERR_UNSUPPORTED for an unknown algorithm.
+ */
+int nc_open(
+        int algorithm,
+        const uint8_t* key,            size_t key_len,
+        const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
+        const uint8_t* nonce,          size_t nonce_len,
+        const uint8_t* aad,            size_t aad_len,
+        uint8_t* out_plaintext, size_t* out_len
+);
+
+// --- CPU capability and automatic selection API ---
+// Which of the CPU features BoringSSL dispatches on are present, and an NC_ALG_AUTO identifier
+// that resolves to whichever of AES-256-GCM and ChaCha20-Poly1305 seals faster on this CPU.
+
+/**
+ * @brief Placeholder identifier for the faster of AES-256-GCM and ChaCha20-Poly1305 on this CPU.
+ *
+ * Accepted only by nc_aead_ctx_new(), which resolves it through nc_algorithm_auto() and pins the
+ * result in the context; every other function rejects it with NC_ERR_UNSUPPORTED. Both candidates
+ * take a 32-byte key and a 12-byte nonce. The choice is a per-process timing race, so a context
+ * created from NC_ALG_AUTO seals only: read the concrete identifier with nc_aead_ctx_algorithm(),
+ * store it with the ciphertext and open with a context created from that identifier.
+ */
+#define NC_ALG_AUTO 100
+
+/** @brief Message size of the NC_ALG_AUTO calibration (the smallest size of the app's test matrix). */
+#define NC_AUTO_CALIBRATION_SIZE (16 * 1024)
+
+/**
+ * @brief CPU features that select BoringSSL's AES-GCM and ChaCha20 code paths.
+ *
+ * Each feature flag is 1 if the CPU has the feature and the operating system saves the registers
+ * it needs, and 0 otherwise (always 0 on other architectures).
+ */
+typedef struct {
+    int asm_enabled;   // BoringSSL was built with its assembly (not OPENSSL_NO_ASM).
+    int aes_hardware;  // BoringSSL's AES-GCM runs on AES and carry-less multiply instructions.
+    // x86 and x86-64.
+    int aesni;         // AES-NI.
+    int pclmulqdq;     // PCLMULQDQ (GHASH).
+    int ssse3;         // SSSE3 (vector-permute AES, ChaCha20).
+    int avx;           // AVX.
+    int avx2;          // AVX2.
+    int avx512;        // AVX-512 F, BW and VL.
+    int vaes;          // VAES (AES on 256/512-bit vectors).
+    int vpclmulqdq;    // VPCLMULQDQ (GHASH on 256/512-bit vectors).
+    // ARM and AArch64.
+    int neon;          // NEON / Advanced SIMD.
+    int armv8_aes;     // ARMv8 AES instructions.
+    int armv8_pmull;   // ARMv8 PMULL (GHASH).
+    const char* expected_aes_gcm_path; // AES-GCM implementation inferred from the flags (static storage).
+    const char* expected_chacha_path;  // ChaCha20 implementation inferred from the flags (static storage).
+} nc_cpu_features;
+
+/**
+ * @brief Reports the CPU features of the running machine as BoringSSL sees them.
+ *
+ * The expected_* path names, e.g. "VAES/AVX-512" or "ARMv8 Crypto Extensions", are inferred
+ * here from the feature flags following BoringSSL's dispatch order at the time of writing
+ * ("generic C" without assembly). BoringSSL does not expose its choice, so they ignore the
+ * OPENSSL_ia32cap override and BoringSSL's own per-CPU adjustments, and can drift from the
+ * BoringSSL revision actually built; treat them as a hint, not a measurement.
+ *
+ * @param out_features Receives the report.
+ * @return 0 on success, or NC_ERR_INVALID_ARGUMENT.
+ */
+int nc_cpu_features_get(nc_cpu_features* out_features);
+
+/**
+ * @brief Outcome of the calibration behind NC_ALG_AUTO.
+ */
+typedef struct {
+    int algorithm;            // Selected NC_ALG_* identifier.
+    int calibrated;           // 1 if measured, 0 if chosen from aes_hardware alone (no usable clock).
+    double aes_gcm_mib_per_s; // Best AES-256-GCM seal throughput (0 if not calibrated).
+    double chacha_mib_per_s;  // Best ChaCha20-Poly1305 seal throughput (0 if not calibrated).
+} nc_auto_selection;
+
+/**
+ * @brief Resolves NC_ALG_AUTO for this process.
+ *
+ * The first call seals NC_AUTO_CALIBRATION_SIZE-byte messages with both candidates in
+ * alternating rounds (a few milliseconds in total) and compares the best round of each; later
+ * calls return the cached choice. Thread-safe. Calibration uses private contexts, so it never
+ * touches the key-schedule cache. Call this once at startup (off the UI thread) to keep the
+ * calibration latency out of the first nc_aead_ctx_new(NC_ALG_AUTO).
+ *
+ * @param out_selection Receives the measurements. Can be NULL.
+ * @return NC_ALG_AES_256_GCM or NC_ALG_CHACHA20_POLY1305.
+ */
+int nc_algorithm_auto(nc_auto_selection* out_selection);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
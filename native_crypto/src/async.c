@@ -0,0 +1,506 @@
+#include "native_crypto.h" // Public API (handle-based seal/open run by every request)
+#include "ring.h"          // Lock-free submission/completion rings and doorbells
+#include "thread_pool.h"   // Internal worker pool (the shared, long-lived pool)
+#include <stdbool.h>        // For bool (Dart_PostCObject's return type)
+#include <stdlib.h>         // For calloc, free
+#include <string.h>         // For memset
+
+#if !defined(_MSC_VER) || defined(__clang__)
+#include <stdatomic.h>      // For the Dart post function pointer
+#endif
+
+// --- Dart native ports ---
+// Minimal mirror of Dart_CObject from the Dart SDK's dart_native_api.h, which is a stable ABI.
+// Only the int64 and array cases are used, so the SDK headers (and dart_api_dl) are not needed:
+// Dart passes NativeApi.postCObject, a pointer to Dart_PostCObject, to nc_async_set_dart_post().
+#define DART_COBJECT_INT64 3
+#define DART_COBJECT_ARRAY 6
+
+typedef struct nc_dart_cobject {
+    int type; // Dart_CObject_Type
+    union {
+        int64_t as_int64;
+        struct {
+            intptr_t length;
+            struct nc_dart_cobject** values;
+        } as_array;
+    } value;
+} nc_dart_cobject;
+
+typedef bool (*dart_post_fn)(int64_t port, nc_dart_cobject* message);
+
+// Values per completion message: request_id, result, usage_status, then the usage fields.
+#define COMPLETION_MESSAGE_LEN 8
+
+#if defined(_MSC_VER) && !defined(__clang__)
+static void* volatile g_dart_post = NULL;
+#define LOAD_DART_POST() ((dart_post_fn)g_dart_post)
+#define STORE_DART_POST(fn) (g_dart_post = (fn))
+#else
+static _Atomic(void*) g_dart_post = NULL;
+#define LOAD_DART_POST() ((dart_post_fn)atomic_load_explicit(&g_dart_post, memory_order_acquire))
+#define STORE_DART_POST(fn) atomic_store_explicit(&g_dart_post, (fn), memory_order_release)
+#endif
+
+// Where a completion goes.
+#define DELIVER_QUEUE 0    // Completion ring of the queue, harvested by nc_async_queue_reap().
+#define DELIVER_CALLBACK 1 // C callback (nc_async_submit()).
+#define DELIVER_PORT 2     // Dart native port (nc_async_submit_port()).
+
+// Requests the dispatcher takes from the submission ring per wake-up.
+#define MAX_DISPATCH_BATCH 64
+// Depth of the process-wide queue behind nc_async_submit() and nc_async_submit_port().
+#define SHARED_QUEUE_DEPTH 1024
+
+/**
+ * @brief One submission ring entry: the request and where to deliver its completion.
+ */
+typedef struct {
+    nc_async_request request;
+    int deliver;                // DELIVER_*.
+    nc_async_callback callback;
+    void* user_data;
+    int64_t dart_port;
+} async_entry;
+
+/**
+ * @brief Runs one request and measures the usage of the thread that ran it.
+ */
+static void run_request(const nc_async_request* request, nc_async_completion* completion) {
+    nc_thread_usage before;
+    int before_status;
+    int after_status;
+
+    memset(completion, 0, sizeof(*completion));
+    completion->request_id = request->request_id;
+    before_status = nc_thread_usage_get(&before);
+    completion->result = request->operation == NC_ASYNC_SEAL
+                         ? nc_aead_seal(request->ctx, request->in, request->in_len, request->nonce,
+                                        request->nonce_len, request->aad, request->aad_len, request->out)
+                         : nc_aead_open(request->ctx, request->in, request->in_len, request->nonce,
+                                        request->nonce_len, request->aad, request->aad_len, request->out);
+    after_status = nc_thread_usage_get(&completion->usage);
+    // Report the weaker of the two samples: NC_ERR_UNSUPPORTED still carries the CPU time.
+    completion->usage_status = before_status < after_status ? before_status : after_status;
+    completion->usage.cpu_time_ns -= before.cpu_time_ns;
+    completion->usage.minor_faults -= before.minor_faults;
+    completion->usage.major_faults -= before.major_faults;
+    completion->usage.voluntary_switches -= before.voluntary_switches;
+    completion->usage.involuntary_switches -= before.involuntary_switches;
+}
+
+/**
+ * @brief Posts a completion to a Dart port as a list of integers.
+ */
+static void post_to_dart(int64_t port, const nc_async_completion* completion) {
+    dart_post_fn post = LOAD_DART_POST();
+    nc_dart_cobject items[COMPLETION_MESSAGE_LEN];
+    nc_dart_cobject* values[COMPLETION_MESSAGE_LEN];
+    nc_dart_cobject message;
+    const int64_t fields[COMPLETION_MESSAGE_LEN] = {
+            completion->request_id,
+            completion->result,
+            completion->usage_status,
+            (int64_t)completion->usage.cpu_time_ns,
+            (int64_t)completion->usage.minor_faults,
+            (int64_t)completion->usage.major_faults,
+            (int64_t)completion->usage.voluntary_switches,
+            (int64_t)completion->usage.involuntary_switches,
+    };
+    size_t i;
+
+    // Checked at submission; the message is copied by Dart_PostCObject before it returns.
+    if (!post) return;
+    for (i = 0; i < COMPLETION_MESSAGE_LEN; i++) {
+        items[i].type = DART_COBJECT_INT64;
+        items[i].value.as_int64 = fields[i];
+        values[i] = &items[i];
+    }
+    message.type = DART_COBJECT_ARRAY;
+    message.value.as_array.length = COMPLETION_MESSAGE_LEN;
+    message.value.as_array.values = values;
+    post(port, &message);
+}
+
+/**
+ * @brief Delivers a completion to a callback or Dart port.
+ */
+static void deliver(const async_entry* entry, const nc_async_completion* completion) {
+    if (entry->deliver == DELIVER_CALLBACK) {
+        entry->callback(completion, entry->user_data);
+    } else {
+        post_to_dart(entry->dart_port, completion);
+    }
+}
+
+/**
+ * @brief Checks the parts of a request that cannot be reported through its completion.
+ */
+static int request_valid(const nc_async_request* request) {
+    return request->ctx && (request->operation == NC_ASYNC_SEAL || request->operation == NC_ASYNC_OPEN);
+}
+
+#ifndef _WIN32
+
+/**
+ * @brief Submission ring, dispatcher thread and completion ring of one queue.
+ *
+ * Submitters reserve a credit per request (in_flight <= depth) before pushing, and the credit is
+ * only returned once the completion has been reaped or delivered, so neither ring can overflow.
+ */
+struct nc_async_queue {
+    nc_mpsc_ring sq;            // async_entry, pushed by any thread, popped by the dispatcher.
+    nc_spsc_ring cq;            // nc_async_completion, pushed by the dispatcher, popped by the reaper.
+    nc_doorbell sq_bell;        // Wakes the dispatcher.
+    nc_doorbell cq_bell;        // Wakes reapers, drainers and submitters waiting for a credit.
+    _Atomic size_t in_flight;   // Credits in use.
+    size_t depth;
+    _Atomic int stopping;
+    pthread_t dispatcher;
+};
+
+/**
+ * @brief Requests and completions of one dispatched batch.
+ */
+typedef struct {
+    async_entry entries[MAX_DISPATCH_BATCH];
+    nc_async_completion completions[MAX_DISPATCH_BATCH];
+} dispatch_batch;
+
+static void run_batch_task(void* arg, size_t index) {
+    dispatch_batch* batch = (dispatch_batch*)arg;
+    run_request(&batch->entries[index].request, &batch->completions[index]);
+}
+
+static int sq_ready(void* arg) {
+    nc_async_queue* queue = (nc_async_queue*)arg;
+    return !nc_mpsc_ring_empty(&queue->sq) || atomic_load_explicit(&queue->stopping, memory_order_relaxed);
+}
+
+/**
+ * @brief Dispatcher: drains the submission ring in batches until the queue is stopped and empty.
+ */
+static void* dispatcher_main(void* opaque) {
+    nc_async_queue* queue = (nc_async_queue*)opaque;
+    nc_thread_pool* pool = nc_shared_thread_pool();
+    dispatch_batch batch;
+    nc_async_completion queued[MAX_DISPATCH_BATCH];
+
+    for (;;) {
+        size_t num_queued = 0;
+        size_t delivered = 0;
+        size_t n;
+        size_t i;
+
+        n = nc_mpsc_ring_pop(&queue->sq, batch.entries, MAX_DISPATCH_BATCH);
+        if (n == 0) {
+            if (atomic_load_explicit(&queue->stopping, memory_order_relaxed)) {
+                if (nc_mpsc_ring_empty(&queue->sq)) break;
+                continue; // A submitter is still publishing its entry.
+            }
+            nc_doorbell_wait(&queue->sq_bell, sq_ready, queue);
+            continue;
+        }
+
+        // One pool round trip per batch; a single worker gains nothing over running here.
+        if (n > 1 && pool && nc_thread_pool_size(pool) > 1) {
+            nc_thread_pool_run(pool, run_batch_task, &batch, n);
+        } else {
+            for (i = 0; i < n; i++) run_batch_task(&batch, i);
+        }
+
+        for (i = 0; i < n; i++) {
+            if (batch.entries[i].deliver == DELIVER_QUEUE) {
+                queued[num_queued++] = batch.completions[i];
+            } else {
+                deliver(&batch.entries[i], &batch.completions[i]);
+                delivered++;
+            }
+        }
+        // Credits guarantee room for every queued completion.
+        if (num_queued > 0) nc_spsc_ring_push(&queue->cq, queued, num_queued);
+        if (delivered > 0) atomic_fetch_sub_explicit(&queue->in_flight, delivered, memory_order_release);
+        // One doorbell for the whole batch.
+        nc_doorbell_ring(&queue->cq_bell);
+    }
+    return NULL;
+}
+
+nc_async_queue* nc_async_queue_new(size_t depth) {
+    nc_async_queue* queue;
+
+    if (depth == 0) depth = NC_ASYNC_DEFAULT_QUEUE_DEPTH;
+    if (depth > NC_ASYNC_MAX_QUEUE_DEPTH) return NULL;
+    queue = (nc_async_queue*)calloc(1, sizeof(nc_async_queue));
+    if (!queue) return NULL;
+    queue->depth = depth;
+    atomic_init(&queue->in_flight, 0);
+    atomic_init(&queue->stopping, 0);
+    if (nc_mpsc_ring_init(&queue->sq, depth, sizeof(async_entry)) != 0) goto fail_sq;
+    if (nc_spsc_ring_init(&queue->cq, depth, sizeof(nc_async_completion)) != 0) goto fail_cq;
+    if (nc_doorbell_init(&queue->sq_bell) != 0) goto fail_sq_bell;
+    if (nc_doorbell_init(&queue->cq_bell) != 0) goto fail_cq_bell;
+    if (pthread_create(&queue->dispatcher, NULL, dispatcher_main, queue) != 0) goto fail_thread;
+    return queue;
+
+fail_thread:
+    nc_doorbell_destroy(&queue->cq_bell);
+fail_cq_bell:
+    nc_doorbell_destroy(&queue->sq_bell);
+fail_sq_bell:
+    nc_spsc_ring_destroy(&queue->cq);
+fail_cq:
+    nc_mpsc_ring_destroy(&queue->sq);
+fail_sq:
+    free(queue);
+    return NULL;
+}
+
+void nc_async_queue_free(nc_async_queue* queue) {
+    if (!queue) return;
+    atomic_store_explicit(&queue->stopping, 1, memory_order_relaxed);
+    nc_doorbell_ring(&queue->sq_bell);
+    pthread_join(queue->dispatcher, NULL);
+    nc_doorbell_destroy(&queue->cq_bell);
+    nc_doorbell_destroy(&queue->sq_bell);
+    nc_spsc_ring_destroy(&queue->cq);
+    nc_mpsc_ring_destroy(&queue->sq);
+    free(queue);
+}
+
+/**
+ * @brief Reserves up to count credits without blocking.
+ *
+ * @return The number of credits reserved.
+ */
+static size_t reserve_credits(nc_async_queue* queue, size_t count) {
+    size_t in_flight = atomic_load_explicit(&queue->in_flight, memory_order_relaxed);
+    size_t granted;
+
+    do {
+        granted = queue->depth - in_flight;
+        if (granted > count) granted = count;
+        if (granted == 0) return 0;
+    } while (!atomic_compare_exchange_weak_explicit(&queue->in_flight, &in_flight, in_flight + granted,
+                                                    memory_order_acquire, memory_order_relaxed));
+    return granted;
+}
+
+/**
+ * @brief Pushes entries that already hold credits and rings the dispatcher once.
+ */
+static void push_entries(nc_async_queue* queue, const async_entry* entries, size_t count) {
+    size_t i;
+
+    // The submission ring holds at least depth entries, so a credited push always finds a cell.
+    for (i = 0; i < count; i++) nc_mpsc_ring_push(&queue->sq, &entries[i]);
+    nc_doorbell_ring(&queue->sq_bell);
+}
+
+size_t nc_async_queue_submit(nc_async_queue* queue, const nc_async_request* requests, size_t count) {
+    async_entry entries[MAX_DISPATCH_BATCH];
+    size_t submitted = 0;
+    size_t valid = 0;
+
+    if (!queue || !requests) return 0;
+    while (valid < count && request_valid(&requests[valid])) valid++;
+
+    while (submitted < valid) {
+        size_t chunk = valid - submitted < MAX_DISPATCH_BATCH ? valid - submitted : MAX_DISPATCH_BATCH;
+        size_t granted = reserve_credits(queue, chunk);
+        size_t i;
+
+        if (granted == 0) break;
+        for (i = 0; i < granted; i++) {
+            memset(&entries[i], 0, sizeof(async_entry));
+            entries[i].request = requests[submitted + i];
+            entries[i].deliver = DELIVER_QUEUE;
+        }
+        push_entries(queue, entries, granted);
+        submitted += granted;
+    }
+    return submitted;
+}
+
+static int cq_ready(void* arg) {
+    return !nc_spsc_ring_empty(&((nc_async_queue*)arg)->cq);
+}
+
+size_t nc_async_queue_reap(nc_async_queue* queue, nc_async_completion* out, size_t max, size_t min_complete) {
+    size_t in_flight;
+    size_t reaped = 0;
+
+    if (!queue || !out || max == 0) return 0;
+    // Never wait for more completions than there are operations in flight.
+    in_flight = atomic_load_explicit(&queue->in_flight, memory_order_acquire);
+    if (min_complete > in_flight) min_complete = in_flight;
+    if (min_complete > max) min_complete = max;
+
+    for (;;) {
+        reaped += nc_spsc_ring_pop(&queue->cq, out + reaped, max - reaped);
+        if (reaped >= min_complete) break;
+        nc_doorbell_wait(&queue->cq_bell, cq_ready, queue);
+    }
+    if (reaped > 0) {
+        atomic_fetch_sub_explicit(&queue->in_flight, reaped, memory_order_release);
+        // Submitters of the shared queue may be waiting for these credits.
+        nc_doorbell_ring(&queue->cq_bell);
+    }
+    return reaped;
+}
+
+// --- Shared queue ---
+// nc_async_submit() and nc_async_submit_port() go through one process-wide queue whose
+// completions are delivered by its dispatcher instead of being reaped.
+
+static nc_async_queue* g_shared_queue = NULL;
+static pthread_once_t g_shared_queue_once = PTHREAD_ONCE_INIT;
+
+static void create_shared_queue(void) {
+    g_shared_queue = nc_async_queue_new(SHARED_QUEUE_DEPTH);
+}
+
+static int credit_available(void* arg) {
+    nc_async_queue* queue = (nc_async_queue*)arg;
+    return atomic_load_explicit(&queue->in_flight, memory_order_relaxed) < queue->depth;
+}
+
+static int queue_idle(void* arg) {
+    nc_async_queue* queue = (nc_async_queue*)arg;
+    return atomic_load_explicit(&queue->in_flight, memory_order_acquire) == 0;
+}
+
+/**
+ * @brief Queues one entry on the shared queue, waiting for a credit if all are in use.
+ *
+ * @return 0 if queued, or -1 if the shared queue could not be created.
+ */
+static int submit_shared(const async_entry* entry) {
+    pthread_once(&g_shared_queue_once, create_shared_queue);
+    if (!g_shared_queue) return -1;
+    while (reserve_credits(g_shared_queue, 1) == 0) {
+        nc_doorbell_wait(&g_shared_queue->cq_bell, credit_available, g_shared_queue);
+    }
+    push_entries(g_shared_queue, entry, 1);
+    return 0;
+}
+
+void nc_async_drain(void) {
+    pthread_once(&g_shared_queue_once, create_shared_queue);
+    if (!g_shared_queue) return;
+    nc_doorbell_wait(&g_shared_queue->cq_bell, queue_idle, g_shared_queue);
+}
+
+#else // _WIN32
+
+// Windows builds have no worker threads: there are no queues, and the shared entry points
+// run every request on the calling thread.
+
+nc_async_queue* nc_async_queue_new(size_t depth) {
+    (void)depth;
+    return NULL;
+}
+
+void nc_async_queue_free(nc_async_queue* queue) {
+    (void)queue;
+}
+
+size_t nc_async_queue_submit(nc_async_queue* queue, const nc_async_request* requests, size_t count) {
+    (void)queue;
+    (void)requests;
+    (void)count;
+    return 0;
+}
+
+size_t nc_async_queue_reap(nc_async_queue* queue, nc_async_completion* out, size_t max, size_t min_complete) {
+    (void)queue;
+    (void)out;
+    (void)max;
+    (void)min_complete;
+    return 0;
+}
+
+static int submit_shared(const async_entry* entry) {
+    (void)entry;
+    return -1;
+}
+
+void nc_async_drain(void) {}
+
+#endif // _WIN32
+
+/**
+ * @brief Shared implementation of nc_async_submit() and nc_async_submit_port().
+ */
+static int submit_delivered(const async_entry* entry) {
+    nc_async_completion completion;
+
+    if (!request_valid(&entry->request)) return NC_ERR_INVALID_ARGUMENT;
+    // Without the shared queue the request runs inline, and completes before this call returns.
+    if (submit_shared(entry) != 0) {
+        run_request(&entry->request, &completion);
+        deliver(entry, &completion);
+    }
+    return 0;
+}
+
+int nc_async_submit(
+        const nc_aead_ctx* ctx, int operation,
+        const uint8_t* in, size_t in_len,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len,
+        uint8_t* out,
+        int64_t request_id, nc_async_callback callback, void* user_data
+) {
+    async_entry entry;
+
+    if (!callback) return NC_ERR_INVALID_ARGUMENT;
+    memset(&entry, 0, sizeof(entry));
+    entry.request.ctx = ctx;
+    entry.request.operation = operation;
+    entry.request.in = in;
+    entry.request.in_len = in_len;
+    entry.request.nonce = nonce;
+    entry.request.nonce_len = nonce_len;
+    entry.request.aad = aad;
+    entry.request.aad_len = aad_len;
+    entry.request.out = out;
+    entry.request.request_id = request_id;
+    entry.deliver = DELIVER_CALLBACK;
+    entry.callback = callback;
+    entry.user_data = user_data;
+    return submit_delivered(&entry);
+}
+
+int nc_async_set_dart_post(void* post_cobject) {
+    if (!post_cobject) return NC_ERR_INVALID_ARGUMENT;
+    STORE_DART_POST(post_cobject);
+    return 0;
+}
+
+int nc_async_submit_port(
+        const nc_aead_ctx* ctx, int operation,
+        const uint8_t* in, size_t in_len,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len,
+        uint8_t* out,
+        int64_t request_id, int64_t dart_port
+) {
+    async_entry entry;
+
+    if (!LOAD_DART_POST()) return NC_ERR_INVALID_ARGUMENT;
+    memset(&entry, 0, sizeof(entry));
+    entry.request.ctx = ctx;
+    entry.request.operation = operation;
+    entry.request.in = in;
+    entry.request.in_len = in_len;
+    entry.request.nonce = nonce;
+    entry.request.nonce_len = nonce_len;
+    entry.request.aad = aad;
+    entry.request.aad_len = aad_len;
+    entry.request.out = out;
+    entry.request.request_id = request_id;
+    entry.deliver = DELIVER_PORT;
+    entry.dart_port = dart_port;
+    return submit_delivered(&entry);
+}
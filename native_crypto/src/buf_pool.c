@@ -0,0 +1,271 @@
+#include "native_crypto.h" // Public API (buffer pool)
+#include <openssl/mem.h>    // For OPENSSL_cleanse
+#include <stdint.h>         // For uintptr_t
+#include <stdlib.h>         // For calloc, free, posix_memalign
+
+#ifndef _WIN32
+#include <pthread.h>        // For the thread-exit destructor (thread-specific data)
+#else
+#include <malloc.h>         // For _aligned_malloc, _aligned_free
+#include <windows.h>        // For the thread-exit destructor (fiber local storage)
+#endif
+
+#if defined(_MSC_VER)
+#define NC_THREAD_LOCAL __declspec(thread)
+#else
+#define NC_THREAD_LOCAL _Thread_local
+#endif
+
+// --- Size classes ---
+// Powers of two from 64 B to NC_BUF_MAX_POOLED_SIZE (4 MiB). Every class carries BUF_TAIL_ROOM extra
+// bytes, so a power-of-two payload plus its AEAD tag still fits the payload's class instead of
+// doubling to the next one.
+#define BUF_MIN_CLASS_SHIFT 6
+#define BUF_MAX_CLASS_SHIFT 22
+#define BUF_CLASS_COUNT (BUF_MAX_CLASS_SHIFT - BUF_MIN_CLASS_SHIFT + 1)
+#define BUF_TAIL_ROOM 64
+#define BUF_UNPOOLED UINT32_MAX // Class of buffers larger than the largest class.
+
+// Each thread keeps at most BUF_CACHE_BYTES per class (but at least BUF_CACHE_MIN_ENTRIES and at
+// most BUF_CACHE_MAX_ENTRIES buffers); further releases go back to the system allocator.
+#define BUF_CACHE_BYTES (8u * 1024u * 1024u)
+#define BUF_CACHE_MIN_ENTRIES 2
+#define BUF_CACHE_MAX_ENTRIES 64
+
+// Header states. They only catch misuse while the block is still allocated (e.g. a second release
+// of a cached buffer); releasing twice is undefined behaviour, see nc_buf_release().
+#define BUF_MAGIC_IN_USE 0x6e634255u // "ncBU"
+#define BUF_MAGIC_CACHED 0x6e634246u // "ncBF"
+
+/**
+ * @brief Header stored in the NC_BUF_ALIGNMENT bytes just before every buffer.
+ */
+typedef struct buf_header {
+    uint32_t magic;          // One of the BUF_MAGIC_* states.
+    uint32_t size_class;     // Index into the class table, or BUF_UNPOOLED.
+    size_t capacity;         // Usable bytes after the header.
+    struct buf_header* next; // Next cached buffer of the same class (free lists only).
+} buf_header;
+
+/**
+ * @brief Free lists of one thread.
+ */
+typedef struct {
+    buf_header* heads[BUF_CLASS_COUNT];
+    size_t counts[BUF_CLASS_COUNT];
+} buf_thread_cache;
+
+// Fast access to the calling thread's free lists; the thread-specific slot below only exists to
+// release them when the thread exits.
+static NC_THREAD_LOCAL buf_thread_cache* t_cache = NULL;
+
+/**
+ * @brief Returns the size class for a request, or BUF_UNPOOLED if it is too large to pool.
+ */
+static uint32_t size_class_for(size_t size) {
+    uint32_t shift = BUF_MIN_CLASS_SHIFT;
+
+    if (size > ((size_t)1 << BUF_MAX_CLASS_SHIFT) + BUF_TAIL_ROOM) return BUF_UNPOOLED;
+    while (((size_t)1 << shift) + BUF_TAIL_ROOM < size) shift++;
+    return shift - BUF_MIN_CLASS_SHIFT;
+}
+
+static size_t class_capacity(uint32_t size_class) {
+    return ((size_t)1 << (size_class + BUF_MIN_CLASS_SHIFT)) + BUF_TAIL_ROOM;
+}
+
+static size_t class_cache_limit(uint32_t size_class) {
+    size_t limit = BUF_CACHE_BYTES / class_capacity(size_class);
+    if (limit < BUF_CACHE_MIN_ENTRIES) return BUF_CACHE_MIN_ENTRIES;
+    if (limit > BUF_CACHE_MAX_ENTRIES) return BUF_CACHE_MAX_ENTRIES;
+    return limit;
+}
+
+/**
+ * @brief Allocates a header plus capacity bytes from the system, aligned to NC_BUF_ALIGNMENT.
+ */
+static buf_header* block_alloc(size_t capacity) {
+    void* block;
+
+    if (capacity > SIZE_MAX - NC_BUF_ALIGNMENT) return NULL;
+#ifndef _WIN32
+    if (posix_memalign(&block, NC_BUF_ALIGNMENT, NC_BUF_ALIGNMENT + capacity) != 0) return NULL;
+#else
+    block = _aligned_malloc(NC_BUF_ALIGNMENT + capacity, NC_BUF_ALIGNMENT);
+    if (!block) return NULL;
+#endif
+    return (buf_header*)block;
+}
+
+static void block_free(buf_header* header) {
+    header->magic = 0;
+#ifndef _WIN32
+    free(header);
+#else
+    _aligned_free(header);
+#endif
+}
+
+static void* header_to_buf(buf_header* header) {
+    return (uint8_t*)header + NC_BUF_ALIGNMENT;
+}
+
+static buf_header* buf_to_header(void* buf) {
+    return (buf_header*)((uint8_t*)buf - NC_BUF_ALIGNMENT);
+}
+
+/**
+ * @brief Returns every buffer cached in the lists to the system.
+ */
+static void free_cached_buffers(buf_thread_cache* cache) {
+    size_t c;
+
+    for (c = 0; c < BUF_CLASS_COUNT; c++) {
+        while (cache->heads[c]) {
+            buf_header* header = cache->heads[c];
+            cache->heads[c] = header->next;
+            block_free(header);
+        }
+        cache->counts[c] = 0;
+    }
+}
+
+/**
+ * @brief Releases a thread's cached buffers and its lists (the thread-exit destructor).
+ */
+static void thread_cache_free(void* opaque) {
+    buf_thread_cache* cache = (buf_thread_cache*)opaque;
+
+    if (!cache) return;
+    free_cached_buffers(cache);
+    free(cache);
+    t_cache = NULL; // Destructors run on the exiting thread; later releases start over.
+}
+
+// Thread-specific slot whose destructor releases the cached buffers when a thread exits.
+#ifndef _WIN32
+static pthread_key_t g_cache_tls;
+static pthread_once_t g_cache_tls_once = PTHREAD_ONCE_INIT;
+static int g_cache_tls_ok = 0;
+
+static void cache_tls_init(void) {
+    g_cache_tls_ok = pthread_key_create(&g_cache_tls, thread_cache_free) == 0;
+}
+
+static int register_thread_cache(buf_thread_cache* cache) {
+    pthread_once(&g_cache_tls_once, cache_tls_init);
+    return g_cache_tls_ok && pthread_setspecific(g_cache_tls, cache) == 0;
+}
+#else
+static DWORD g_cache_tls = FLS_OUT_OF_INDEXES;
+static INIT_ONCE g_cache_tls_once = INIT_ONCE_STATIC_INIT;
+
+static void WINAPI cache_fls_free(void* opaque) {
+    thread_cache_free(opaque);
+}
+
+static BOOL CALLBACK cache_tls_init(PINIT_ONCE once, void* param, void** context) {
+    (void)once;
+    (void)param;
+    (void)context;
+    g_cache_tls = FlsAlloc(cache_fls_free);
+    return TRUE;
+}
+
+static int register_thread_cache(buf_thread_cache* cache) {
+    InitOnceExecuteOnce(&g_cache_tls_once, cache_tls_init, NULL, NULL);
+    return g_cache_tls != FLS_OUT_OF_INDEXES && FlsSetValue(g_cache_tls, cache);
+}
+#endif
+
+/**
+ * @brief Returns the calling thread's free lists, creating them on first use.
+ *
+ * @return The lists, or NULL if they could not be created (the pool then falls back to the
+ *         system allocator for this thread).
+ */
+static buf_thread_cache* thread_cache(void) {
+    buf_thread_cache* cache = t_cache;
+
+    if (cache) return cache;
+    cache = (buf_thread_cache*)calloc(1, sizeof(buf_thread_cache));
+    if (!cache) return NULL;
+    // Without a destructor the lists would leak when the thread exits, so they are not used.
+    if (!register_thread_cache(cache)) {
+        free(cache);
+        return NULL;
+    }
+    t_cache = cache;
+    return cache;
+}
+
+void* nc_buf_acquire(size_t size) {
+    uint32_t size_class = size_class_for(size);
+    size_t capacity = size_class == BUF_UNPOOLED ? size : class_capacity(size_class);
+    buf_header* header = NULL;
+
+    // Reuse a buffer released earlier on this thread when possible.
+    if (size_class != BUF_UNPOOLED) {
+        buf_thread_cache* cache = thread_cache();
+        if (cache && cache->heads[size_class]) {
+            header = cache->heads[size_class];
+            cache->heads[size_class] = header->next;
+            cache->counts[size_class]--;
+        }
+    }
+    if (!header) {
+        header = block_alloc(capacity);
+        if (!header) return NULL;
+        header->size_class = size_class;
+        header->capacity = capacity;
+    }
+    header->magic = BUF_MAGIC_IN_USE;
+    header->next = NULL;
+    return header_to_buf(header);
+}
+
+void nc_buf_release(void* buf) {
+    buf_header* header;
+    buf_thread_cache* cache;
+    uint32_t size_class;
+
+    if (!buf || ((uintptr_t)buf & (NC_BUF_ALIGNMENT - 1)) != 0) return;
+    header = buf_to_header(buf);
+    // Best effort against a second release of a still-cached buffer. Unpooled and evicted blocks are
+    // freed below, so a later release of them cannot be detected (undefined behaviour).
+    if (header->magic != BUF_MAGIC_IN_USE) return;
+
+    size_class = header->size_class;
+    if (size_class != BUF_UNPOOLED) {
+        // Buffers go to the releasing thread's lists, whichever thread acquired them.
+        cache = thread_cache();
+        if (cache && cache->counts[size_class] < class_cache_limit(size_class)) {
+            header->magic = BUF_MAGIC_CACHED;
+            header->next = cache->heads[size_class];
+            cache->heads[size_class] = header;
+            cache->counts[size_class]++;
+            return;
+        }
+    }
+    block_free(header);
+}
+
+void nc_buf_release_wipe(void* buf, size_t wipe_len) {
+    size_t capacity = nc_buf_capacity(buf);
+
+    if (capacity == 0) return;
+    OPENSSL_cleanse(buf, wipe_len < capacity ? wipe_len : capacity);
+    nc_buf_release(buf);
+}
+
+size_t nc_buf_capacity(const void* buf) {
+    const buf_header* header;
+
+    if (!buf || ((uintptr_t)buf & (NC_BUF_ALIGNMENT - 1)) != 0) return 0;
+    header = (const buf_header*)((const uint8_t*)buf - NC_BUF_ALIGNMENT);
+    return header->magic == BUF_MAGIC_IN_USE ? header->capacity : 0;
+}
+
+void nc_buf_pool_trim(void) {
+    if (t_cache) free_cached_buffers(t_cache);
+}
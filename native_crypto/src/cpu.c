@@ -0,0 +1,348 @@
+#include "native_crypto.h" // Public API (nc_cpu_features_get, nc_algorithm_auto)
+#include <openssl/aead.h>   // For EVP_has_aes_hardware and the calibration contexts
+#include <openssl/crypto.h> // For CRYPTO_has_asm
+#include <stdlib.h>         // For malloc, free
+#include <string.h>         // For memset
+
+#ifndef _WIN32
+#include <pthread.h>        // For pthread_once (one calibration per process)
+#include <time.h>           // For clock_gettime, CLOCK_MONOTONIC
+#else
+#include <windows.h>        // For InitOnceExecuteOnce, QueryPerformanceCounter, IsProcessorFeaturePresent
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define NC_CPU_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>         // For __cpuidex, _xgetbv
+#else
+#include <cpuid.h>          // For __cpuid_count
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define NC_CPU_AARCH64
+#elif defined(__arm__) || defined(_M_ARM)
+#define NC_CPU_ARM
+#endif
+
+#if (defined(NC_CPU_AARCH64) || defined(NC_CPU_ARM)) && defined(__linux__)
+#include <sys/auxv.h>       // For getauxval (Linux and Android)
+#endif
+
+// Feature detection repeats the checks BoringSSL makes at startup (CPUID and XCR0 on x86, the
+// kernel's hardware capabilities on ARM). BoringSSL keeps the result to itself, so only
+// aes_hardware comes from the library; the expected_* path names are inferred from the flags and
+// miss OPENSSL_ia32cap overrides and BoringSSL's own per-CPU adjustments.
+
+// --- x86 ---
+
+#ifdef NC_CPU_X86
+// CPUID leaf 1, ECX.
+#define CPUID1_PCLMULQDQ (1u << 1)
+#define CPUID1_SSSE3 (1u << 9)
+#define CPUID1_MOVBE (1u << 22)
+#define CPUID1_AESNI (1u << 25)
+#define CPUID1_OSXSAVE (1u << 27)
+#define CPUID1_AVX (1u << 28)
+// CPUID leaf 7, EBX and ECX.
+#define CPUID7_AVX2 (1u << 5)
+#define CPUID7_AVX512F (1u << 16)
+#define CPUID7_AVX512BW (1u << 30)
+#define CPUID7_AVX512VL (1u << 31)
+#define CPUID7_ECX_VAES (1u << 9)
+#define CPUID7_ECX_VPCLMULQDQ (1u << 10)
+// XCR0 state components: SSE and AVX registers, then the AVX-512 opmask and upper ZMM registers.
+#define XCR0_AVX_STATE 0x6u
+#define XCR0_AVX512_STATE 0xe6u
+
+static void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int values[4];
+    __cpuidex(values, (int)leaf, (int)subleaf);
+    regs[0] = (uint32_t)values[0];
+    regs[1] = (uint32_t)values[1];
+    regs[2] = (uint32_t)values[2];
+    regs[3] = (uint32_t)values[3];
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/**
+ * @brief Reads XCR0, the register state the operating system saves on context switches.
+ */
+static uint64_t read_xcr0(void) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return _xgetbv(0);
+#else
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+static void detect_x86(nc_cpu_features* out) {
+    uint32_t regs[4];
+    uint32_t max_leaf;
+    uint32_t ecx1;
+    uint32_t ebx7 = 0;
+    uint32_t ecx7 = 0;
+    uint64_t xcr0 = 0;
+    int avx_state;
+    int avx512_state;
+    int movbe;
+
+    cpuid(0, 0, regs);
+    max_leaf = regs[0];
+    if (max_leaf < 1) return;
+    cpuid(1, 0, regs);
+    ecx1 = regs[2];
+    if (max_leaf >= 7) {
+        cpuid(7, 0, regs);
+        ebx7 = regs[1];
+        ecx7 = regs[2];
+    }
+    if (ecx1 & CPUID1_OSXSAVE) xcr0 = read_xcr0();
+    avx_state = (xcr0 & XCR0_AVX_STATE) == XCR0_AVX_STATE;
+    avx512_state = (xcr0 & XCR0_AVX512_STATE) == XCR0_AVX512_STATE;
+
+    out->aesni = (ecx1 & CPUID1_AESNI) != 0;
+    out->pclmulqdq = (ecx1 & CPUID1_PCLMULQDQ) != 0;
+    out->ssse3 = (ecx1 & CPUID1_SSSE3) != 0;
+    movbe = (ecx1 & CPUID1_MOVBE) != 0;
+    // Without the OS saving the YMM/ZMM registers, the vector extensions are unusable.
+    out->avx = avx_state && (ecx1 & CPUID1_AVX) != 0;
+    out->avx2 = out->avx && (ebx7 & CPUID7_AVX2) != 0;
+    out->avx512 = out->avx2 && avx512_state && (ebx7 & CPUID7_AVX512F) && (ebx7 & CPUID7_AVX512BW) &&
+                  (ebx7 & CPUID7_AVX512VL);
+    out->vaes = out->avx && (ecx7 & CPUID7_ECX_VAES) != 0;
+    out->vpclmulqdq = out->avx && (ecx7 & CPUID7_ECX_VPCLMULQDQ) != 0;
+
+    // Fastest path first, in the order BoringSSL's dispatch tried them when this was written.
+    if (!out->asm_enabled) return;
+    if (out->vaes && out->vpclmulqdq && out->avx512) {
+        out->expected_aes_gcm_path = "VAES/AVX-512";
+    } else if (out->vaes && out->vpclmulqdq && out->avx2) {
+        out->expected_aes_gcm_path = "VAES/AVX2";
+    } else if (out->aesni && out->pclmulqdq && out->avx && movbe) {
+        out->expected_aes_gcm_path = "AES-NI/AVX";
+    } else if (out->aesni && out->pclmulqdq) {
+        out->expected_aes_gcm_path = "AES-NI";
+    } else if (out->ssse3) {
+        out->expected_aes_gcm_path = "vector-permute (SSSE3)";
+    }
+    if (out->avx2) {
+        out->expected_chacha_path = "AVX2";
+    } else if (out->ssse3) {
+        out->expected_chacha_path = "SSSE3";
+    }
+}
+#endif
+
+// --- ARM ---
+
+#if defined(NC_CPU_AARCH64) || defined(NC_CPU_ARM)
+// Kernel hardware capability bits (asm/hwcap.h), spelled out for older NDK headers.
+#define AARCH64_HWCAP_ASIMD (1ul << 1)
+#define AARCH64_HWCAP_AES (1ul << 3)
+#define AARCH64_HWCAP_PMULL (1ul << 4)
+#define ARM_HWCAP_NEON (1ul << 12)
+#define ARM_HWCAP2_AES (1ul << 0)
+#define ARM_HWCAP2_PMULL (1ul << 1)
+
+static void detect_arm(nc_cpu_features* out) {
+#if defined(__linux__) && defined(NC_CPU_AARCH64)
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    out->neon = (hwcap & AARCH64_HWCAP_ASIMD) != 0;
+    out->armv8_aes = (hwcap & AARCH64_HWCAP_AES) != 0;
+    out->armv8_pmull = (hwcap & AARCH64_HWCAP_PMULL) != 0;
+#elif defined(__linux__)
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    unsigned long hwcap2 = getauxval(AT_HWCAP2);
+    out->neon = (hwcap & ARM_HWCAP_NEON) != 0;
+    // The 32-bit ARMv8 instructions are NEON instructions, so they need NEON too.
+    out->armv8_aes = out->neon && (hwcap2 & ARM_HWCAP2_AES) != 0;
+    out->armv8_pmull = out->neon && (hwcap2 & ARM_HWCAP2_PMULL) != 0;
+#elif defined(__APPLE__) && defined(NC_CPU_AARCH64)
+    // Every Apple AArch64 core has the Crypto Extensions.
+    out->neon = 1;
+    out->armv8_aes = 1;
+    out->armv8_pmull = 1;
+#elif defined(_WIN32) && defined(NC_CPU_AARCH64)
+    out->neon = 1; // Mandatory on AArch64.
+    out->armv8_aes = out->armv8_pmull = IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != 0;
+#elif defined(NC_CPU_AARCH64)
+    out->neon = 1; // Mandatory on AArch64; the Crypto Extensions cannot be queried here.
+#endif
+
+    if (!out->asm_enabled) return;
+    if (out->armv8_aes && out->armv8_pmull) {
+        out->expected_aes_gcm_path = "ARMv8 Crypto Extensions";
+    } else if (out->neon) {
+        out->expected_aes_gcm_path = "NEON (constant-time software)";
+    }
+    if (out->neon) out->expected_chacha_path = "NEON";
+}
+#endif
+
+// --- Capability report ---
+
+int nc_cpu_features_get(nc_cpu_features* out_features) {
+    // --- Parameter Validation ---
+    if (!out_features) return NC_ERR_INVALID_ARGUMENT;
+
+    memset(out_features, 0, sizeof(*out_features));
+    out_features->asm_enabled = CRYPTO_has_asm();
+    out_features->aes_hardware = EVP_has_aes_hardware();
+    out_features->expected_aes_gcm_path = "generic C";
+    out_features->expected_chacha_path = "generic C";
+#if defined(NC_CPU_X86)
+    detect_x86(out_features);
+#elif defined(NC_CPU_AARCH64) || defined(NC_CPU_ARM)
+    detect_arm(out_features);
+#endif
+    return 0;
+}
+
+// --- Automatic selection ---
+
+// Rounds alternate between the candidates so a frequency change or a burst of background work
+// hits both; the best round of each is compared.
+#define CALIBRATION_ROUNDS 8
+#define SEALS_PER_ROUND 8
+
+/** @brief A candidate of the automatic selection. */
+typedef struct {
+    int id;                         // NC_ALG_* identifier.
+    const EVP_AEAD* (*aead)(void);  // BoringSSL AEAD.
+} candidate;
+
+static const candidate kCandidates[2] = {
+        {NC_ALG_AES_256_GCM, EVP_aead_aes_256_gcm},
+        {NC_ALG_CHACHA20_POLY1305, EVP_aead_chacha20_poly1305},
+};
+
+static nc_auto_selection g_selection;
+
+/**
+ * @brief Monotonic wall-clock time in nanoseconds, or 0 if unavailable.
+ */
+static uint64_t monotonic_ns(void) {
+#ifndef _WIN32
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) return 0;
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#else
+    LARGE_INTEGER count, frequency;
+    if (!QueryPerformanceCounter(&count) || !QueryPerformanceFrequency(&frequency)) return 0;
+    return (uint64_t)((double)count.QuadPart * 1e9 / (double)frequency.QuadPart);
+#endif
+}
+
+/**
+ * @brief Times SEALS_PER_ROUND seals of the calibration message.
+ *
+ * @return The elapsed nanoseconds, or 0 if a seal failed or the clock is unusable.
+ */
+static uint64_t time_round(const EVP_AEAD_CTX* ctx, const uint8_t* plaintext, uint8_t* out) {
+    static const uint8_t kNonce[12] = {0}; // The output is discarded, so one nonce will do.
+    uint64_t start = monotonic_ns();
+    uint64_t end;
+    int i;
+
+    for (i = 0; i < SEALS_PER_ROUND; i++) {
+        size_t out_len;
+        if (!EVP_AEAD_CTX_seal(ctx, out, &out_len, NC_AUTO_CALIBRATION_SIZE + NC_AEAD_TAG_LEN, kNonce,
+                               sizeof(kNonce), plaintext, NC_AUTO_CALIBRATION_SIZE, NULL, 0)) {
+            return 0;
+        }
+    }
+    end = monotonic_ns();
+    return start != 0 && end > start ? end - start : 0;
+}
+
+/**
+ * @brief Measures both candidates into g_selection.
+ *
+ * The candidates run on private EVP_AEAD contexts rather than through nc_seal(), so the
+ * calibration key never enters the caller's key-schedule cache.
+ *
+ * @return 1 if both were measured, 0 otherwise.
+ */
+static int calibrate(void) {
+    static const uint8_t kKey[32] = {0}; // Only ever seals the zero message below.
+    EVP_AEAD_CTX ctx[2];
+    int initialized[2] = {0, 0};
+    uint8_t* plaintext = (uint8_t*)calloc(1, NC_AUTO_CALIBRATION_SIZE);
+    uint8_t* out = (uint8_t*)malloc(NC_AUTO_CALIBRATION_SIZE + NC_AEAD_TAG_LEN);
+    uint64_t best[2] = {0, 0};
+    int round;
+    int c;
+    int ok = plaintext && out;
+
+    for (c = 0; c < 2 && ok; c++) {
+        initialized[c] = EVP_AEAD_CTX_init(&ctx[c], kCandidates[c].aead(), kKey, sizeof(kKey),
+                                           EVP_AEAD_DEFAULT_TAG_LENGTH, NULL);
+        ok = initialized[c];
+    }
+    // One untimed round each faults the buffers in and warms the code and the caches.
+    for (c = 0; c < 2 && ok; c++) ok = time_round(&ctx[c], plaintext, out) != 0;
+    for (round = 0; round < CALIBRATION_ROUNDS && ok; round++) {
+        for (c = 0; c < 2 && ok; c++) {
+            uint64_t ns = time_round(&ctx[c], plaintext, out);
+            ok = ns != 0;
+            if (ok && (best[c] == 0 || ns < best[c])) best[c] = ns;
+        }
+    }
+    for (c = 0; c < 2; c++) {
+        if (initialized[c]) EVP_AEAD_CTX_cleanup(&ctx[c]);
+    }
+    free(out);
+    free(plaintext);
+    if (!ok) return 0;
+
+    g_selection.aes_gcm_mib_per_s =
+            (double)NC_AUTO_CALIBRATION_SIZE * SEALS_PER_ROUND / ((double)best[0] / 1e9) / (1024.0 * 1024.0);
+    g_selection.chacha_mib_per_s =
+            (double)NC_AUTO_CALIBRATION_SIZE * SEALS_PER_ROUND / ((double)best[1] / 1e9) / (1024.0 * 1024.0);
+    return 1;
+}
+
+static void select_algorithm(void) {
+    nc_cpu_features features;
+
+    memset(&g_selection, 0, sizeof(g_selection));
+    g_selection.calibrated = calibrate();
+    if (g_selection.calibrated && g_selection.aes_gcm_mib_per_s != g_selection.chacha_mib_per_s) {
+        g_selection.algorithm = g_selection.aes_gcm_mib_per_s > g_selection.chacha_mib_per_s
+                                ? NC_ALG_AES_256_GCM
+                                : NC_ALG_CHACHA20_POLY1305;
+        return;
+    }
+    // No measurement (or a tie): AES-GCM only wins with hardware support.
+    nc_cpu_features_get(&features);
+    g_selection.algorithm = features.aes_hardware ? NC_ALG_AES_256_GCM : NC_ALG_CHACHA20_POLY1305;
+}
+
+#ifndef _WIN32
+static pthread_once_t g_selection_once = PTHREAD_ONCE_INIT;
+#else
+static INIT_ONCE g_selection_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK select_algorithm_once(PINIT_ONCE once, void* param, void** context) {
+    (void)once;
+    (void)param;
+    (void)context;
+    select_algorithm();
+    return TRUE;
+}
+#endif
+
+int nc_algorithm_auto(nc_auto_selection* out_selection) {
+#ifndef _WIN32
+    pthread_once(&g_selection_once, select_algorithm);
+#else
+    InitOnceExecuteOnce(&g_selection_once, select_algorithm_once, NULL, NULL);
+#endif
+    if (out_selection) *out_selection = g_selection;
+    return g_selection.algorithm;
+}
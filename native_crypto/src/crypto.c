@@ -1,214 +1,540 @@
 #include "native_crypto.h" // Include the header file for this module (presumably defines function prototypes)
+#include "errors.h"        // Internal failure recording (counters and error ring)
+#include "overlap.h"       // Partial-overlap check shared with the fused seal-and-digest
 #include <openssl/aead.h>   // Include BoringSSL/OpenSSL header for AEAD (Authenticated Encryption with Associated Data) operations
-#include <openssl/err.h>    // Include BoringSSL/OpenSSL header for error handling
+#include <openssl/chacha.h> // Include BoringSSL header for the raw ChaCha20 stream (Poly1305 key of verify-only checks)
+#include <openssl/crypto.h> // Include BoringSSL/OpenSSL header for CRYPTO_memcmp
+#include <openssl/mem.h>    // Include BoringSSL/OpenSSL header for OPENSSL_cleanse
+#include <openssl/poly1305.h> // Include BoringSSL header for the one-shot Poly1305 MAC (verify-only checks)
+#include <openssl/rand.h>   // Include BoringSSL/OpenSSL header for RAND_bytes (nonce generation)
 #include <string.h>         // Include standard C library for string operations (though not explicitly used in this snippet, often useful)
-#include <stdio.h>          // Include standard C library for input/output operations (like fprintf)
+#include <limits.h>         // Include standard C library for INT_MAX
+#include <stdlib.h>         // Include standard C library for memory allocation (malloc, free)
+
+#ifndef _WIN32
+#include <pthread.h>        // Include POSIX threads for the per-thread key-schedule cache (thread-specific data)
+#else
+#include <windows.h>        // Include Windows API for the per-thread key-schedule cache (fiber local storage)
+#endif
+
+#if !defined(_MSC_VER) || defined(__clang__)
+#include <stdatomic.h>      // Include C11 atomics for the process-wide cache settings
+#endif
+
+// --- Key-schedule cache ---
+// The stateless functions initialize an EVP_AEAD_CTX (AES key expansion, GHASH tables) for
+// every message. With the opt-in cache, each thread keeps its most recently used contexts keyed
+// on (algorithm, key bytes) and repeated calls with the same key skip EVP_AEAD_CTX_init.
+// Entries are evicted least-recently-used; evicted and flushed entries are wiped.
+
+// Longest key that is cached (longer keys bypass the cache).
+#define KEY_CACHE_MAX_KEY_LEN 32
+
+/** @brief One cached context. */
+typedef struct {
+    const EVP_AEAD* aead;                 // Algorithm of the context (NULL for an empty slot).
+    uint8_t key[KEY_CACHE_MAX_KEY_LEN];   // Copy of the key the context was created with.
+    size_t key_len;
+    uint64_t last_used;                   // Value of the cache clock at the last hit.
+    EVP_AEAD_CTX ctx;                     // Initialized context.
+} key_cache_entry;
+
+/** @brief Cache of one thread. */
+typedef struct {
+    size_t capacity;            // Number of entries.
+    uint64_t clock;             // Incremented on every lookup; orders entries by recency.
+    unsigned long generation;   // Settings generation the cache was built for.
+    key_cache_entry entries[];  // capacity entries.
+} key_cache;
+
+// Process-wide settings, read without a lock on every stateless call. A new generation makes
+// every thread flush and rebuild its cache at its next call.
+// g_key_caches_alive counts the thread caches that exist, so that the default (disabled) path
+// needs no thread-specific lookup unless a cache is still waiting to be wiped.
+#if defined(_MSC_VER) && !defined(__clang__)
+static volatile long g_key_cache_capacity = 0;
+static volatile long g_key_cache_generation = 0;
+static volatile long g_key_caches_alive = 0;
+#define LOAD_SETTING(name) ((unsigned long)(name))
+#define STORE_SETTING(name, value) ((name) = (long)(value))
+#define INCREMENT_SETTING(name) InterlockedIncrement(&(name))
+#define DECREMENT_SETTING(name) InterlockedDecrement(&(name))
+#else
+static atomic_ulong g_key_cache_capacity = 0;
+static atomic_ulong g_key_cache_generation = 0;
+static atomic_ulong g_key_caches_alive = 0;
+#define LOAD_SETTING(name) atomic_load_explicit(&(name), memory_order_acquire)
+#define STORE_SETTING(name, value) atomic_store_explicit(&(name), (value), memory_order_release)
+#define INCREMENT_SETTING(name) atomic_fetch_add_explicit(&(name), 1, memory_order_acq_rel)
+#define DECREMENT_SETTING(name) atomic_fetch_sub_explicit(&(name), 1, memory_order_acq_rel)
+#endif
+
+/**
+ * @brief Wipes one entry and releases its context.
+ */
+static void key_cache_entry_wipe(key_cache_entry* entry) {
+    if (!entry->aead) return;
+    EVP_AEAD_CTX_cleanup(&entry->ctx);
+    OPENSSL_cleanse(entry->key, sizeof(entry->key));
+    entry->aead = NULL;
+    entry->key_len = 0;
+}
+
+/**
+ * @brief Wipes every entry and releases the cache (also the thread-exit destructor).
+ */
+static void key_cache_free(void* opaque) {
+    key_cache* cache = (key_cache*)opaque;
+    size_t i;
+
+    if (!cache) return;
+    for (i = 0; i < cache->capacity; i++) key_cache_entry_wipe(&cache->entries[i]);
+    free(cache);
+    DECREMENT_SETTING(g_key_caches_alive);
+}
+
+// Per-thread cache pointer with a destructor that wipes the cache when the thread exits.
+#ifndef _WIN32
+static pthread_key_t g_key_cache_tls;
+static pthread_once_t g_key_cache_tls_once = PTHREAD_ONCE_INIT;
+static int g_key_cache_tls_ok = 0;
+
+static void key_cache_tls_init(void) {
+    g_key_cache_tls_ok = pthread_key_create(&g_key_cache_tls, key_cache_free) == 0;
+}
+
+static key_cache* key_cache_get_thread(void) {
+    pthread_once(&g_key_cache_tls_once, key_cache_tls_init);
+    return g_key_cache_tls_ok ? (key_cache*)pthread_getspecific(g_key_cache_tls) : NULL;
+}
+
+static int key_cache_set_thread(key_cache* cache) {
+    return g_key_cache_tls_ok && pthread_setspecific(g_key_cache_tls, cache) == 0;
+}
+#else
+static DWORD g_key_cache_tls = FLS_OUT_OF_INDEXES;
+static INIT_ONCE g_key_cache_tls_once = INIT_ONCE_STATIC_INIT;
+
+static void WINAPI key_cache_fls_free(void* opaque) {
+    key_cache_free(opaque);
+}
+
+static BOOL CALLBACK key_cache_tls_init(PINIT_ONCE once, void* param, void** context) {
+    (void)once;
+    (void)param;
+    (void)context;
+    g_key_cache_tls = FlsAlloc(key_cache_fls_free);
+    return TRUE;
+}
+
+static key_cache* key_cache_get_thread(void) {
+    InitOnceExecuteOnce(&g_key_cache_tls_once, key_cache_tls_init, NULL, NULL);
+    return g_key_cache_tls != FLS_OUT_OF_INDEXES ? (key_cache*)FlsGetValue(g_key_cache_tls) : NULL;
+}
+
+static int key_cache_set_thread(key_cache* cache) {
+    return g_key_cache_tls != FLS_OUT_OF_INDEXES && FlsSetValue(g_key_cache_tls, cache);
+}
+#endif
+
+/**
+ * @brief Returns the calling thread's cache, (re)building it if the settings changed.
+ *
+ * @return The cache, or NULL if caching is disabled or the cache could not be allocated.
+ */
+static key_cache* key_cache_for_thread(void) {
+    size_t capacity = (size_t)LOAD_SETTING(g_key_cache_capacity);
+    unsigned long generation;
+    key_cache* cache;
+
+    if (capacity == 0) {
+        // Fast path for the default (disabled) setting.
+        if (LOAD_SETTING(g_key_caches_alive) == 0) return NULL;
+        // The cache was disabled after this thread built one: wipe it now.
+        cache = key_cache_get_thread();
+        if (cache) {
+            key_cache_free(cache);
+            key_cache_set_thread(NULL);
+        }
+        return NULL;
+    }
+
+    generation = LOAD_SETTING(g_key_cache_generation);
+    cache = key_cache_get_thread();
+    if (cache && cache->generation == generation) return cache;
+
+    // First use on this thread, or the settings changed: start over with the new capacity.
+    key_cache_free(cache);
+    cache = (key_cache*)calloc(1, sizeof(key_cache) + capacity * sizeof(key_cache_entry));
+    if (cache) {
+        cache->capacity = capacity;
+        cache->generation = generation;
+        INCREMENT_SETTING(g_key_caches_alive);
+    }
+    if (!key_cache_set_thread(cache)) {
+        key_cache_free(cache);
+        return NULL;
+    }
+    return cache;
+}
 
 /**
- * @brief Handles and prints BoringSSL/OpenSSL errors to stderr.
+ * @brief Returns an initialized context for (aead, key), from the cache when possible.
  *
- * This function retrieves and prints all errors currently in the BoringSSL/OpenSSL
- * error queue, prepending a custom context message.
+ * Without a cache (or for keys that are too long) the context is initialized in scratch and the
+ * caller must pass the result to release_aead_ctx().
  *
- * @param context_message A string describing the context in which the error occurred.
+ * @param context Description recorded if the initialization fails.
+ * @return The context, or NULL if the initialization failed.
  */
-static void handle_boringssl_errors(const char* context_message) {
-    // Print the user-provided context message.
-    fprintf(stderr, "BoringSSL/OpenSSL Error in %s:\n", context_message);
-    unsigned long err_code;
-    // Loop through the error queue until it's empty.
-    while ((err_code = ERR_get_error()) != 0) {
-        char err_buf[256]; // Buffer to hold the error string.
-        // Convert the error code to a human-readable string.
-        ERR_error_string_n(err_code, err_buf, sizeof(err_buf));
-        // Print the error string to stderr.
-        fprintf(stderr, "- %s\n", err_buf);
+static EVP_AEAD_CTX* acquire_aead_ctx(const EVP_AEAD* aead, const uint8_t* key, size_t key_len,
+                                      EVP_AEAD_CTX* scratch, const char* context) {
+    key_cache* cache = key_len <= KEY_CACHE_MAX_KEY_LEN ? key_cache_for_thread() : NULL;
+    key_cache_entry* victim;
+    size_t i;
+
+    if (!cache) {
+        if (!EVP_AEAD_CTX_init(scratch, aead, key, key_len, EVP_AEAD_DEFAULT_TAG_LENGTH, NULL)) {
+            nc_error_record(NC_FAILURE_INIT, context);
+            return NULL;
+        }
+        return scratch;
     }
+
+    // --- Lookup ---
+    // Constant-time key comparison, so probing the cache does not leak key bytes through timing.
+    cache->clock++;
+    victim = &cache->entries[0];
+    for (i = 0; i < cache->capacity; i++) {
+        key_cache_entry* entry = &cache->entries[i];
+        if (entry->aead == aead && entry->key_len == key_len &&
+            CRYPTO_memcmp(entry->key, key, key_len) == 0) {
+            entry->last_used = cache->clock;
+            return &entry->ctx;
+        }
+        // Empty slots first, then the least recently used entry.
+        if (victim->aead && (!entry->aead || entry->last_used < victim->last_used)) victim = entry;
+    }
+
+    // --- Miss: replace the victim ---
+    key_cache_entry_wipe(victim);
+    if (!EVP_AEAD_CTX_init(&victim->ctx, aead, key, key_len, EVP_AEAD_DEFAULT_TAG_LENGTH, NULL)) {
+        nc_error_record(NC_FAILURE_INIT, context);
+        return NULL;
+    }
+    victim->aead = aead;
+    memcpy(victim->key, key, key_len);
+    victim->key_len = key_len;
+    victim->last_used = cache->clock;
+    return &victim->ctx;
 }
 
 /**
- * @brief Encrypts plaintext using AES-256-GCM.
+ * @brief Releases a context returned by acquire_aead_ctx(). Cached contexts stay in the cache.
+ */
+static void release_aead_ctx(EVP_AEAD_CTX* ctx, EVP_AEAD_CTX* scratch) {
+    if (ctx == scratch) EVP_AEAD_CTX_cleanup(scratch);
+}
+
+int nc_key_cache_configure(size_t capacity) {
+    if (capacity > NC_KEY_CACHE_MAX_ENTRIES) return NC_ERR_INVALID_ARGUMENT;
+    STORE_SETTING(g_key_cache_capacity, capacity);
+    INCREMENT_SETTING(g_key_cache_generation);
+    // The calling thread applies the new settings right away.
+    key_cache_for_thread();
+    return 0;
+}
+
+void nc_key_cache_flush(void) {
+    key_cache* cache = key_cache_get_thread();
+    size_t i;
+
+    if (!cache) return;
+    for (i = 0; i < cache->capacity; i++) key_cache_entry_wipe(&cache->entries[i]);
+}
+
+/**
+ * @brief Returns the number of plaintext bytes an open writes (the input without its tag).
+ */
+static size_t open_output_len(size_t ciphertext_tag_len, const EVP_AEAD* aead) {
+    size_t overhead = EVP_AEAD_max_overhead(aead);
+    return ciphertext_tag_len > overhead ? ciphertext_tag_len - overhead : 0;
+}
+
+// --- Algorithm registry ---
+
+/**
+ * @brief One registered AEAD: its NC_ALG_* identifier, display name and BoringSSL constructor.
+ */
+typedef struct {
+    int id;
+    const char* name;
+    const EVP_AEAD* (*aead)(void);
+} algorithm_entry;
+
+// Every AEAD the library dispatches to, in NC_ALG_* order. Key, nonce and tag sizes come from
+// BoringSSL, so supporting another AEAD only takes an identifier and a row here.
+static const algorithm_entry kAlgorithms[] = {
+        {NC_ALG_AES_256_GCM, "AES-256-GCM", EVP_aead_aes_256_gcm},
+        {NC_ALG_CHACHA20_POLY1305, "ChaCha20-Poly1305", EVP_aead_chacha20_poly1305},
+        {NC_ALG_AES_128_GCM, "AES-128-GCM", EVP_aead_aes_128_gcm},
+        {NC_ALG_AES_256_GCM_SIV, "AES-256-GCM-SIV", EVP_aead_aes_256_gcm_siv},
+        {NC_ALG_XCHACHA20_POLY1305, "XChaCha20-Poly1305", EVP_aead_xchacha20_poly1305},
+};
+
+#define NUM_ALGORITHMS (sizeof(kAlgorithms) / sizeof(kAlgorithms[0]))
+
+/**
+ * @brief Returns the registry entry of an NC_ALG_* identifier, or NULL for an unknown identifier.
+ * NC_ALG_AUTO is not in the registry; only nc_aead_ctx_new() resolves it.
+ */
+static const algorithm_entry* find_algorithm(int algorithm) {
+    size_t i;
+    for (i = 0; i < NUM_ALGORITHMS; i++) {
+        if (kAlgorithms[i].id == algorithm) return &kAlgorithms[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Maps an NC_ALG_* identifier to the corresponding BoringSSL AEAD.
  *
- * @param plaintext Pointer to the plaintext data to encrypt.
- * @param plaintext_len Length of the plaintext data.
- * @param key Pointer to the 256-bit (32-byte) encryption key.
- * @param nonce Pointer to the nonce (Initialization Vector - IV). Recommended size is 12 bytes.
- * @param nonce_len Length of the nonce.
- * @param aad Pointer to the Additional Associated Data (AAD). Can be NULL if aad_len is 0.
- * @param aad_len Length of the AAD.
- * @param out_ciphertext_tag Pointer to the output buffer where the ciphertext and authentication tag will be written.
- * The buffer should be large enough to hold plaintext_len + 16 bytes (for the tag).
- * @return The total number of bytes written (ciphertext + tag) on success,
- * -1 for invalid parameters or initialization errors,
- * or other negative values for encryption failures.
+ * @param algorithm One of the NC_ALG_* identifiers.
+ * @return The AEAD structure, or NULL for an unknown identifier.
  */
-int encrypt_aes_gcm_256(
+static const EVP_AEAD* aead_for_algorithm(int algorithm) {
+    const algorithm_entry* entry = find_algorithm(algorithm);
+    return entry ? entry->aead() : NULL;
+}
+
+static void fill_algorithm_info(const algorithm_entry* entry, nc_algorithm_info* out_info) {
+    const EVP_AEAD* aead = entry->aead();
+
+    out_info->id = entry->id;
+    out_info->name = entry->name;
+    out_info->key_len = EVP_AEAD_key_length(aead);
+    out_info->nonce_len = EVP_AEAD_nonce_length(aead);
+    out_info->tag_len = EVP_AEAD_max_overhead(aead);
+}
+
+size_t nc_algorithm_count(void) {
+    return NUM_ALGORITHMS;
+}
+
+int nc_algorithm_info_at(size_t index, nc_algorithm_info* out_info) {
+    if (index >= NUM_ALGORITHMS || !out_info) return NC_ERR_INVALID_ARGUMENT;
+    fill_algorithm_info(&kAlgorithms[index], out_info);
+    return 0;
+}
+
+int nc_algorithm_info_get(int algorithm, nc_algorithm_info* out_info) {
+    const algorithm_entry* entry = find_algorithm(algorithm);
+
+    if (!out_info) return NC_ERR_INVALID_ARGUMENT;
+    if (!entry) return NC_ERR_UNSUPPORTED;
+    fill_algorithm_info(entry, out_info);
+    return 0;
+}
+
+// --- Stateless API ---
+
+int nc_seal(
+        int algorithm,
+        const uint8_t* key, size_t key_len,
         const uint8_t* plaintext, size_t plaintext_len,
-        const uint8_t* key, const uint8_t* nonce, size_t nonce_len,
-        const uint8_t* aad, size_t aad_len, uint8_t* out_ciphertext_tag
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len,
+        uint8_t* out_ciphertext_tag, size_t* out_len
 ) {
-    // Get the AEAD algorithm structure for AES-256-GCM.
-    const EVP_AEAD *aead_alg = EVP_aead_aes_256_gcm();
-    EVP_AEAD_CTX ctx; // AEAD context structure.
+    // Get the AEAD algorithm structure from the registry.
+    const EVP_AEAD *aead_alg = aead_for_algorithm(algorithm);
+    EVP_AEAD_CTX scratch_ctx; // AEAD context structure (used when the key-schedule cache is off).
+    EVP_AEAD_CTX* ctx = NULL; // Context in use: scratch_ctx or a cached context.
     size_t actual_out_len = 0; // Variable to store the actual length of the output.
-    // Calculate the maximum possible output length (plaintext + tag overhead).
-    size_t max_out_len = plaintext_len + EVP_AEAD_max_overhead(aead_alg);
-    int result_status = -1; // Initialize result status to an error state.
+    size_t max_out_len; // Maximum possible output length (plaintext + tag overhead).
+    int result_status = NC_ERR_INVALID_ARGUMENT; // Initialize result status to an error state.
 
     // --- Parameter Validation ---
     // Check for NULL pointers for essential inputs.
-    if (!plaintext || !key || !nonce || !out_ciphertext_tag) return -1; // Invalid arguments
-    // AES-256-GCM requires a 32-byte (256-bit) key.
-    if (EVP_AEAD_key_length(aead_alg) != 32) return -1; // Should not happen with EVP_aead_aes_256_gcm, but good practice.
-    // GCM standard nonce size is 12 bytes (96 bits).
-    if (nonce_len != 12) return -1; // Invalid nonce length
+    if (!plaintext || !key || !nonce || !out_ciphertext_tag || !out_len) return NC_ERR_INVALID_ARGUMENT;
+    *out_len = 0;
+    if (!aead_alg) return NC_ERR_UNSUPPORTED; // Unknown NC_ALG_* identifier
+    // Key and nonce sizes are fixed per algorithm (e.g. 32 and 12 bytes for AES-256-GCM).
+    if (key_len != EVP_AEAD_key_length(aead_alg)) return NC_ERR_INVALID_ARGUMENT;
+    if (nonce_len != EVP_AEAD_nonce_length(aead_alg)) return NC_ERR_INVALID_ARGUMENT;
+    max_out_len = plaintext_len + EVP_AEAD_max_overhead(aead_alg);
+    // The output may be the plaintext buffer itself (in-place), but must not partially overlap it.
+    if (buffers_partially_overlap(plaintext, plaintext_len, out_ciphertext_tag, max_out_len)) {
+        return NC_ERR_INVALID_ARGUMENT;
+    }
 
     // --- AEAD Context Initialization ---
-    // Initialize the AEAD context with the algorithm, key, key length, and default tag length.
-    if (!EVP_AEAD_CTX_init(&ctx, aead_alg, key, EVP_AEAD_key_length(aead_alg),
-                           EVP_AEAD_DEFAULT_TAG_LENGTH, NULL)) {
-        handle_boringssl_errors("EVP_AEAD_CTX_init (encrypt AES)");
-        goto cleanup_aes_encrypt; // Jump to cleanup on failure.
-    }
+    // A cached context for this key is reused when the key-schedule cache is enabled.
+    ctx = acquire_aead_ctx(aead_alg, key, key_len, &scratch_ctx, "EVP_AEAD_CTX_init (stateless seal)");
+    if (!ctx) goto cleanup_seal; // Jump to cleanup on failure.
 
     // --- Encryption (Seal Operation) ---
-    // Perform the encryption and authentication.
     // EVP_AEAD_CTX_seal encrypts `plaintext` and generates an authentication tag.
     // The ciphertext and tag are written contiguously to `out_ciphertext_tag`.
-    if (!EVP_AEAD_CTX_seal(&ctx, out_ciphertext_tag, &actual_out_len, max_out_len,
+    if (!EVP_AEAD_CTX_seal(ctx, out_ciphertext_tag, &actual_out_len, max_out_len,
                            nonce, nonce_len, plaintext, plaintext_len, aad, aad_len)) {
-        handle_boringssl_errors("EVP_AEAD_CTX_seal (AES)");
-        goto cleanup_aes_encrypt; // Jump to cleanup on failure.
+        nc_error_record(NC_FAILURE_SEAL, "EVP_AEAD_CTX_seal (stateless)");
+        goto cleanup_seal; // Jump to cleanup on failure.
     }
 
-    // If encryption was successful, set the result status to the actual output length.
-    result_status = (int)actual_out_len;
+    // If encryption was successful, report the actual output length.
+    *out_len = actual_out_len;
+    result_status = 0;
 
-    cleanup_aes_encrypt:
+    cleanup_seal:
     // --- Cleanup ---
-    // Clean up the AEAD context to free any allocated resources.
-    EVP_AEAD_CTX_cleanup(&ctx);
-    return result_status; // Return the result (output length or error code).
+    release_aead_ctx(ctx, &scratch_ctx);
+    return result_status; // Return the result (0 or error code).
 }
 
-/**
- * @brief Decrypts ciphertext using AES-256-GCM.
- *
- * @param ciphertext_tag Pointer to the combined ciphertext and authentication tag.
- * @param ciphertext_tag_len Length of the combined ciphertext and tag.
- * @param key Pointer to the 256-bit (32-byte) decryption key.
- * @param nonce Pointer to the nonce (IV) used during encryption.
- * @param nonce_len Length of the nonce (must be 12 bytes).
- * @param aad Pointer to the Additional Associated Data (AAD) used during encryption. Can be NULL if aad_len is 0.
- * @param aad_len Length of the AAD.
- * @param out_plaintext Pointer to the output buffer where the decrypted plaintext will be written.
- * The buffer should be large enough to hold ciphertext_tag_len - 16 bytes (tag length).
- * @return The number of bytes written to out_plaintext on success (plaintext length),
- * -1 for invalid parameters or initialization errors,
- * -2 for authentication failure (tag mismatch) or if ciphertext_tag_len is too short.
- */
-int decrypt_aes_gcm_256(
+int nc_open(
+        int algorithm,
+        const uint8_t* key, size_t key_len,
         const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
-        const uint8_t* key, const uint8_t* nonce, size_t nonce_len,
-        const uint8_t* aad, size_t aad_len, uint8_t* out_plaintext
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len,
+        uint8_t* out_plaintext, size_t* out_len
 ) {
-    // Get the AEAD algorithm structure for AES-256-GCM.
-    const EVP_AEAD *aead_alg = EVP_aead_aes_256_gcm();
-    EVP_AEAD_CTX ctx; // AEAD context structure.
+    // Get the AEAD algorithm structure from the registry.
+    const EVP_AEAD *aead_alg = aead_for_algorithm(algorithm);
+    EVP_AEAD_CTX scratch_ctx; // AEAD context structure (used when the key-schedule cache is off).
+    EVP_AEAD_CTX* ctx = NULL; // Context in use: scratch_ctx or a cached context.
     size_t actual_out_len = 0; // Variable to store the actual length of the decrypted plaintext.
-    // For decryption, max_out_len is the ciphertext_tag_len itself, as plaintext cannot be larger.
-    size_t max_out_len = ciphertext_tag_len;
-    int result_status = -1; // Initialize result status to an error state.
+    int result_status = NC_ERR_INVALID_ARGUMENT; // Initialize result status to an error state.
 
     // --- Parameter Validation ---
-    if (!ciphertext_tag || !key || !nonce || !out_plaintext) return -1; // Invalid arguments
-    if (EVP_AEAD_key_length(aead_alg) != 32) return -1; // Key length check
-    if (nonce_len != 12) return -1; // Nonce length check
+    if (!ciphertext_tag || !key || !nonce || !out_plaintext || !out_len) return NC_ERR_INVALID_ARGUMENT;
+    *out_len = 0;
+    if (!aead_alg) return NC_ERR_UNSUPPORTED; // Unknown NC_ALG_* identifier
+    if (key_len != EVP_AEAD_key_length(aead_alg)) return NC_ERR_INVALID_ARGUMENT; // Key length check
+    if (nonce_len != EVP_AEAD_nonce_length(aead_alg)) return NC_ERR_INVALID_ARGUMENT; // Nonce length check
     // Ciphertext + tag length must be at least the tag length.
-    if (ciphertext_tag_len < EVP_AEAD_DEFAULT_TAG_LENGTH) return -2; // Input too short to contain a tag
+    if (ciphertext_tag_len < EVP_AEAD_max_overhead(aead_alg)) { // Input too short
+        nc_error_record(NC_FAILURE_OPEN, "input shorter than the tag (stateless)");
+        return NC_ERR_AUTHENTICATION;
+    }
+    // The output may be the ciphertext buffer itself (in-place), but must not partially overlap it.
+    if (buffers_partially_overlap(ciphertext_tag, ciphertext_tag_len, out_plaintext,
+                                  open_output_len(ciphertext_tag_len, aead_alg))) {
+        return NC_ERR_INVALID_ARGUMENT;
+    }
 
     // --- AEAD Context Initialization ---
-    if (!EVP_AEAD_CTX_init(&ctx, aead_alg, key, EVP_AEAD_key_length(aead_alg),
-                           EVP_AEAD_DEFAULT_TAG_LENGTH, NULL)) {
-        handle_boringssl_errors("EVP_AEAD_CTX_init (decrypt AES)");
-        goto cleanup_aes_decrypt;
-    }
+    // A cached context for this key is reused when the key-schedule cache is enabled.
+    ctx = acquire_aead_ctx(aead_alg, key, key_len, &scratch_ctx, "EVP_AEAD_CTX_init (stateless open)");
+    if (!ctx) goto cleanup_open; // Jump to cleanup on failure.
 
     // --- Decryption (Open Operation) ---
-    // Perform the decryption and authentication verification.
     // EVP_AEAD_CTX_open decrypts `ciphertext_tag` and verifies the authentication tag.
     // If verification fails, it returns 0 and no plaintext is written.
-    if (!EVP_AEAD_CTX_open(&ctx, out_plaintext, &actual_out_len, max_out_len,
+    // For decryption, the output cannot be larger than ciphertext_tag_len.
+    if (!EVP_AEAD_CTX_open(ctx, out_plaintext, &actual_out_len, ciphertext_tag_len,
                            nonce, nonce_len, ciphertext_tag, ciphertext_tag_len, aad, aad_len)) {
         // Authentication failed or other decryption error.
-        handle_boringssl_errors("EVP_AEAD_CTX_open (AES)");
-        result_status = -2; // Indicate authentication/decryption failure
-        goto cleanup_aes_decrypt;
+        nc_error_record(NC_FAILURE_OPEN, "EVP_AEAD_CTX_open (stateless)");
+        result_status = NC_ERR_AUTHENTICATION; // Indicate authentication/decryption failure
+        goto cleanup_open;
     }
 
-    // If decryption was successful, set the result status to the actual plaintext length.
-    result_status = (int)actual_out_len;
+    // If decryption was successful, report the actual plaintext length.
+    *out_len = actual_out_len;
+    result_status = 0;
 
-    cleanup_aes_decrypt:
+    cleanup_open:
     // --- Cleanup ---
-    EVP_AEAD_CTX_cleanup(&ctx);
+    release_aead_ctx(ctx, &scratch_ctx);
     return result_status;
 }
 
+// The original per-algorithm entry points, kept for existing callers.
+
 /**
- * @brief Encrypts plaintext using ChaCha20-Poly1305.
+ * @brief Encrypts plaintext using AES-256-GCM.
  *
  * @param plaintext Pointer to the plaintext data to encrypt.
  * @param plaintext_len Length of the plaintext data.
  * @param key Pointer to the 256-bit (32-byte) encryption key.
- * @param nonce Pointer to the nonce (IV). Recommended size is 12 bytes for ChaCha20-Poly1305.
+ * @param nonce Pointer to the nonce (Initialization Vector - IV). Recommended size is 12 bytes.
  * @param nonce_len Length of the nonce.
  * @param aad Pointer to the Additional Associated Data (AAD). Can be NULL if aad_len is 0.
  * @param aad_len Length of the AAD.
  * @param out_ciphertext_tag Pointer to the output buffer where the ciphertext and authentication tag will be written.
  * The buffer should be large enough to hold plaintext_len + 16 bytes (for the tag).
- * @return The total number of bytes written (ciphertext + tag) on success,
+ * It may be the same pointer as plaintext (in-place encryption) but must not partially overlap it.
+ * @param out_len Receives the total number of bytes written (ciphertext + tag).
+ * @return 0 on success,
  * -1 for invalid parameters or initialization errors,
  * or other negative values for encryption failures.
  */
-int encrypt_chacha20_poly1305(
+int encrypt_aes_gcm_256_ex(
         const uint8_t* plaintext, size_t plaintext_len,
         const uint8_t* key, const uint8_t* nonce, size_t nonce_len,
-        const uint8_t* aad, size_t aad_len, uint8_t* out_ciphertext_tag
+        const uint8_t* aad, size_t aad_len, uint8_t* out_ciphertext_tag,
+        size_t* out_len
 ) {
-    // Get the AEAD algorithm structure for ChaCha20-Poly1305.
-    const EVP_AEAD *aead_alg = EVP_aead_chacha20_poly1305();
-    EVP_AEAD_CTX ctx;
-    size_t actual_out_len = 0;
-    size_t max_out_len = plaintext_len + EVP_AEAD_max_overhead(aead_alg); // Max output: plaintext + tag
-    int result_status = -1;
-
-    // --- Parameter Validation ---
-    if (!plaintext || !key || !nonce || !out_ciphertext_tag) return -1;
-    // ChaCha20-Poly1305 uses a 256-bit (32-byte) key.
-    if (EVP_AEAD_key_length(aead_alg) != 32) return -1;
-    // ChaCha20-Poly1305 typically uses a 12-byte (96-bit) nonce.
-    if (nonce_len != 12) return -1;
-
-    // --- AEAD Context Initialization ---
-    if (!EVP_AEAD_CTX_init(&ctx, aead_alg, key, EVP_AEAD_key_length(aead_alg),
-                           EVP_AEAD_DEFAULT_TAG_LENGTH, NULL)) {
-        handle_boringssl_errors("EVP_AEAD_CTX_init (encrypt ChaCha)");
-        goto cleanup_chacha_encrypt;
-    }
+    return nc_seal(NC_ALG_AES_256_GCM, key, 32, plaintext, plaintext_len, nonce, nonce_len, aad, aad_len,
+                   out_ciphertext_tag, out_len);
+}
 
-    // --- Encryption (Seal Operation) ---
-    if (!EVP_AEAD_CTX_seal(&ctx, out_ciphertext_tag, &actual_out_len, max_out_len,
-                           nonce, nonce_len, plaintext, plaintext_len, aad, aad_len)) {
-        handle_boringssl_errors("EVP_AEAD_CTX_seal (ChaCha)");
-        goto cleanup_chacha_encrypt;
-    }
-    result_status = (int)actual_out_len;
+/**
+ * @brief Decrypts ciphertext using AES-256-GCM.
+ *
+ * @param ciphertext_tag Pointer to the combined ciphertext and authentication tag.
+ * @param ciphertext_tag_len Length of the combined ciphertext and tag.
+ * @param key Pointer to the 256-bit (32-byte) decryption key.
+ * @param nonce Pointer to the nonce (IV) used during encryption.
+ * @param nonce_len Length of the nonce (must be 12 bytes).
+ * @param aad Pointer to the Additional Associated Data (AAD) used during encryption. Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @param out_plaintext Pointer to the output buffer where the decrypted plaintext will be written.
+ * The buffer should be large enough to hold ciphertext_tag_len - 16 bytes (tag length).
+ * It may be the same pointer as ciphertext_tag (in-place decryption) but must not partially overlap it.
+ * @param out_len Receives the number of bytes written to out_plaintext (plaintext length).
+ * @return 0 on success,
+ * -1 for invalid parameters or initialization errors,
+ * -2 for authentication failure (tag mismatch) or if ciphertext_tag_len is too short.
+ */
+int decrypt_aes_gcm_256_ex(
+        const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
+        const uint8_t* key, const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len, uint8_t* out_plaintext,
+        size_t* out_len
+) {
+    return nc_open(NC_ALG_AES_256_GCM, key, 32, ciphertext_tag, ciphertext_tag_len, nonce, nonce_len, aad, aad_len,
+                   out_plaintext, out_len);
+}
 
-    cleanup_chacha_encrypt:
-    // --- Cleanup ---
-    EVP_AEAD_CTX_cleanup(&ctx);
-    return result_status;
+/**
+ * @brief Encrypts plaintext using ChaCha20-Poly1305.
+ *
+ * @param plaintext Pointer to the plaintext data to encrypt.
+ * @param plaintext_len Length of the plaintext data.
+ * @param key Pointer to the 256-bit (32-byte) encryption key.
+ * @param nonce Pointer to the nonce (IV). Recommended size is 12 bytes for ChaCha20-Poly1305.
+ * @param nonce_len Length of the nonce.
+ * @param aad Pointer to the Additional Associated Data (AAD). Can be NULL if aad_len is 0.
+ * @param aad_len Length of the AAD.
+ * @param out_ciphertext_tag Pointer to the output buffer where the ciphertext and authentication tag will be written.
+ * The buffer should be large enough to hold plaintext_len + 16 bytes (for the tag).
+ * It may be the same pointer as plaintext (in-place encryption) but must not partially overlap it.
+ * @param out_len Receives the total number of bytes written (ciphertext + tag).
+ * @return 0 on success,
+ * -1 for invalid parameters or initialization errors,
+ * or other negative values for encryption failures.
+ */
+int encrypt_chacha20_poly1305_ex(
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* key, const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len, uint8_t* out_ciphertext_tag,
+        size_t* out_len
+) {
+    return nc_seal(NC_ALG_CHACHA20_POLY1305, key, 32, plaintext, plaintext_len, nonce, nonce_len, aad, aad_len,
+                   out_ciphertext_tag, out_len);
 }
 
 /**
@@ -223,47 +549,725 @@ int encrypt_chacha20_poly1305(
  * @param aad_len Length of the AAD.
  * @param out_plaintext Pointer to the output buffer where the decrypted plaintext will be written.
  * The buffer should be large enough to hold ciphertext_tag_len - 16 bytes (tag length).
- * @return The number of bytes written to out_plaintext on success (plaintext length),
+ * It may be the same pointer as ciphertext_tag (in-place decryption) but must not partially overlap it.
+ * @param out_len Receives the number of bytes written to out_plaintext (plaintext length).
+ * @return 0 on success,
  * -1 for invalid parameters or initialization errors,
  * -2 for authentication failure (tag mismatch) or if ciphertext_tag_len is too short.
  */
+int decrypt_chacha20_poly1305_ex(
+        const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
+        const uint8_t* key, const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len, uint8_t* out_plaintext,
+        size_t* out_len
+) {
+    return nc_open(NC_ALG_CHACHA20_POLY1305, key, 32, ciphertext_tag, ciphertext_tag_len, nonce, nonce_len, aad, aad_len,
+                   out_plaintext, out_len);
+}
+
+// --- int-returning variants ---
+// The original API reports the output length as an int. Inputs whose output would not fit are
+// refused up front rather than processed and truncated into something that looks like an error.
+
+/**
+ * @brief Returns 1 if sealing plaintext_len bytes produces more output than an int can report.
+ */
+static int seal_len_exceeds_int(size_t plaintext_len) {
+    return plaintext_len > (size_t)INT_MAX - NC_AEAD_TAG_LEN;
+}
+
+/**
+ * @brief Returns 1 if opening ciphertext_tag_len bytes produces more output than an int can report.
+ */
+static int open_len_exceeds_int(size_t ciphertext_tag_len) {
+    return ciphertext_tag_len > NC_AEAD_TAG_LEN && ciphertext_tag_len - NC_AEAD_TAG_LEN > (size_t)INT_MAX;
+}
+
+int encrypt_aes_gcm_256(
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* key, const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len, uint8_t* out_ciphertext_tag
+) {
+    size_t out_len = 0;
+    int status;
+
+    if (seal_len_exceeds_int(plaintext_len)) return -1; // Use encrypt_aes_gcm_256_ex().
+    status = encrypt_aes_gcm_256_ex(plaintext, plaintext_len, key, nonce, nonce_len, aad, aad_len,
+                                    out_ciphertext_tag, &out_len);
+    return status < 0 ? status : (int)out_len;
+}
+
+int decrypt_aes_gcm_256(
+        const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
+        const uint8_t* key, const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len, uint8_t* out_plaintext
+) {
+    size_t out_len = 0;
+    int status;
+
+    if (open_len_exceeds_int(ciphertext_tag_len)) return -1; // Use decrypt_aes_gcm_256_ex().
+    status = decrypt_aes_gcm_256_ex(ciphertext_tag, ciphertext_tag_len, key, nonce, nonce_len, aad, aad_len,
+                                    out_plaintext, &out_len);
+    return status < 0 ? status : (int)out_len;
+}
+
+int encrypt_chacha20_poly1305(
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* key, const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len, uint8_t* out_ciphertext_tag
+) {
+    size_t out_len = 0;
+    int status;
+
+    if (seal_len_exceeds_int(plaintext_len)) return -1; // Use encrypt_chacha20_poly1305_ex().
+    status = encrypt_chacha20_poly1305_ex(plaintext, plaintext_len, key, nonce, nonce_len, aad, aad_len,
+                                          out_ciphertext_tag, &out_len);
+    return status < 0 ? status : (int)out_len;
+}
+
 int decrypt_chacha20_poly1305(
         const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
         const uint8_t* key, const uint8_t* nonce, size_t nonce_len,
         const uint8_t* aad, size_t aad_len, uint8_t* out_plaintext
 ) {
-    // Get the AEAD algorithm structure for ChaCha20-Poly1305.
-    const EVP_AEAD *aead_alg = EVP_aead_chacha20_poly1305();
-    EVP_AEAD_CTX ctx;
-    size_t actual_out_len = 0;
-    size_t max_out_len = ciphertext_tag_len; // Plaintext cannot be larger than ciphertext + tag
-    int result_status = -1;
+    size_t out_len = 0;
+    int status;
+
+    if (open_len_exceeds_int(ciphertext_tag_len)) return -1; // Use decrypt_chacha20_poly1305_ex().
+    status = decrypt_chacha20_poly1305_ex(ciphertext_tag, ciphertext_tag_len, key, nonce, nonce_len, aad,
+                                          aad_len, out_plaintext, &out_len);
+    return status < 0 ? status : (int)out_len;
+}
+
+// --- Handle-based API ---
+
+/**
+ * @brief Internal layout of the opaque nc_aead_ctx handle.
+ *
+ * The embedded EVP_AEAD_CTX holds the expanded key schedule. BoringSSL's seal and
+ * open functions take the context as const, which is what makes a handle safe to
+ * share between threads once it has been created.
+ */
+// Counter of the NC_NONCE_COUNTER mode, the only part of a context that changes after creation.
+#if defined(_MSC_VER) && !defined(__clang__)
+typedef volatile LONG64 nonce_counter_t;
+#define NONCE_COUNTER_INIT(counter) ((counter) = 0)
+#define NONCE_COUNTER_LOAD(counter) ((uint64_t)InterlockedCompareExchange64(&(counter), 0, 0))
+#define NONCE_COUNTER_CAS(counter, expected, desired) \
+    (InterlockedCompareExchange64(&(counter), (LONG64)(desired), (LONG64)(expected)) == (LONG64)(expected))
+#else
+typedef _Atomic uint64_t nonce_counter_t;
+#define NONCE_COUNTER_INIT(counter) atomic_init(&(counter), 0)
+#define NONCE_COUNTER_LOAD(counter) atomic_load_explicit(&(counter), memory_order_relaxed)
+#define NONCE_COUNTER_CAS(counter, expected, desired) \
+    atomic_compare_exchange_weak_explicit(&(counter), &(expected), (desired), memory_order_relaxed, \
+                                          memory_order_relaxed)
+#endif
+
+// Counter values at or above this are refused. Requests are capped at NC_MAX_NONCES_PER_CALL, so
+// the counter cannot wrap back to values already handed out.
+#define NONCE_COUNTER_LIMIT (UINT64_C(1) << 63)
+
+struct nc_aead_ctx {
+    EVP_AEAD_CTX aead_ctx;                  // Initialized BoringSSL context (key schedule, GHASH tables).
+    int algorithm;                          // NC_ALG_* identifier the context uses (NC_ALG_AUTO resolved).
+    int seal_only;                          // Created from NC_ALG_AUTO: the open functions refuse it.
+    uint8_t nonce_prefix[NC_NONCE_LEN - 8]; // Random per context, first bytes of counter nonces.
+    nonce_counter_t nonce_counter;          // Next counter value of the NC_NONCE_COUNTER mode.
+};
+
+nc_aead_ctx* nc_aead_ctx_new(int algorithm, const uint8_t* key, size_t key_len) {
+    // The automatic choice is made once here and pinned in the context.
+    int seal_only = algorithm == NC_ALG_AUTO;
+    const EVP_AEAD *aead_alg = aead_for_algorithm(seal_only ? nc_algorithm_auto(NULL) : algorithm);
+    nc_aead_ctx* ctx;
 
     // --- Parameter Validation ---
-    if (!ciphertext_tag || !key || !nonce || !out_plaintext) return -1;
-    if (EVP_AEAD_key_length(aead_alg) != 32) return -1; // Key length check
-    if (nonce_len != 12) return -1; // Nonce length check
-    // Ciphertext + tag length must be at least the tag length.
-    if (ciphertext_tag_len < EVP_AEAD_DEFAULT_TAG_LENGTH) return -2; // Input too short
+    if (!aead_alg || !key) return NULL;
+    if (key_len != EVP_AEAD_key_length(aead_alg)) return NULL;
+
+    ctx = (nc_aead_ctx*)malloc(sizeof(nc_aead_ctx));
+    if (!ctx) return NULL;
 
     // --- AEAD Context Initialization ---
-    if (!EVP_AEAD_CTX_init(&ctx, aead_alg, key, EVP_AEAD_key_length(aead_alg),
+    // This is the expensive step that the stateless functions repeat for every message.
+    if (!EVP_AEAD_CTX_init(&ctx->aead_ctx, aead_alg, key, key_len,
                            EVP_AEAD_DEFAULT_TAG_LENGTH, NULL)) {
-        handle_boringssl_errors("EVP_AEAD_CTX_init (decrypt ChaCha)");
-        goto cleanup_chacha_decrypt;
+        nc_error_record(NC_FAILURE_INIT, "EVP_AEAD_CTX_init (handle)");
+        free(ctx);
+        return NULL;
+    }
+    ctx->algorithm = seal_only ? nc_algorithm_auto(NULL) : algorithm;
+    ctx->seal_only = seal_only;
+    // Keeps counter nonces of different contexts under the same key apart.
+    if (!RAND_bytes(ctx->nonce_prefix, sizeof(ctx->nonce_prefix))) {
+        nc_error_record(NC_FAILURE_INIT, "RAND_bytes (nonce prefix)");
+        EVP_AEAD_CTX_cleanup(&ctx->aead_ctx);
+        free(ctx);
+        return NULL;
+    }
+    NONCE_COUNTER_INIT(ctx->nonce_counter);
+    return ctx;
+}
+
+void nc_aead_ctx_free(nc_aead_ctx* ctx) {
+    if (!ctx) return;
+    // EVP_AEAD_CTX_cleanup wipes the expanded key before the memory is released.
+    EVP_AEAD_CTX_cleanup(&ctx->aead_ctx);
+    free(ctx);
+}
+
+int nc_aead_ctx_algorithm(const nc_aead_ctx* ctx) {
+    return ctx ? ctx->algorithm : NC_ERR_INVALID_ARGUMENT;
+}
+
+int nc_aead_seal_ex(
+        const nc_aead_ctx* ctx,
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len, uint8_t* out_ciphertext_tag,
+        size_t* out_len
+) {
+    size_t max_out_len;
+
+    // --- Parameter Validation ---
+    if (!ctx || !plaintext || !nonce || !out_ciphertext_tag || !out_len) return NC_ERR_INVALID_ARGUMENT;
+    *out_len = 0;
+    if (nonce_len != EVP_AEAD_nonce_length(EVP_AEAD_CTX_aead(&ctx->aead_ctx))) return NC_ERR_INVALID_ARGUMENT;
+    max_out_len = plaintext_len + EVP_AEAD_max_overhead(EVP_AEAD_CTX_aead(&ctx->aead_ctx));
+    if (buffers_partially_overlap(plaintext, plaintext_len, out_ciphertext_tag, max_out_len)) {
+        return NC_ERR_INVALID_ARGUMENT;
+    }
+
+    // --- Encryption (Seal Operation) ---
+    if (!EVP_AEAD_CTX_seal(&ctx->aead_ctx, out_ciphertext_tag, out_len, max_out_len,
+                           nonce, nonce_len, plaintext, plaintext_len, aad, aad_len)) {
+        nc_error_record(NC_FAILURE_SEAL, "EVP_AEAD_CTX_seal (handle)");
+        return NC_ERR_INVALID_ARGUMENT;
+    }
+    return 0;
+}
+
+int nc_aead_open_ex(
+        const nc_aead_ctx* ctx,
+        const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len, uint8_t* out_plaintext,
+        size_t* out_len
+) {
+    // --- Parameter Validation ---
+    if (!ctx || !ciphertext_tag || !nonce || !out_plaintext || !out_len) return NC_ERR_INVALID_ARGUMENT;
+    *out_len = 0;
+    if (ctx->seal_only) return NC_ERR_UNSUPPORTED;
+    if (nonce_len != EVP_AEAD_nonce_length(EVP_AEAD_CTX_aead(&ctx->aead_ctx))) return NC_ERR_INVALID_ARGUMENT;
+    if (ciphertext_tag_len < EVP_AEAD_max_overhead(EVP_AEAD_CTX_aead(&ctx->aead_ctx))) {
+        nc_error_record(NC_FAILURE_OPEN, "input shorter than the tag (handle)");
+        return NC_ERR_AUTHENTICATION; // Input too short to contain a tag
+    }
+    if (buffers_partially_overlap(ciphertext_tag, ciphertext_tag_len, out_plaintext,
+                                  open_output_len(ciphertext_tag_len, EVP_AEAD_CTX_aead(&ctx->aead_ctx)))) {
+        return NC_ERR_INVALID_ARGUMENT;
     }
 
     // --- Decryption (Open Operation) ---
-    if (!EVP_AEAD_CTX_open(&ctx, out_plaintext, &actual_out_len, max_out_len,
+    if (!EVP_AEAD_CTX_open(&ctx->aead_ctx, out_plaintext, out_len, ciphertext_tag_len,
                            nonce, nonce_len, ciphertext_tag, ciphertext_tag_len, aad, aad_len)) {
-        handle_boringssl_errors("EVP_AEAD_CTX_open (ChaCha)");
-        result_status = -2; // Indicate authentication/decryption failure
-        goto cleanup_chacha_decrypt;
+        nc_error_record(NC_FAILURE_OPEN, "EVP_AEAD_CTX_open (handle)");
+        return NC_ERR_AUTHENTICATION;
+    }
+    return 0;
+}
+
+int nc_aead_seal(
+        const nc_aead_ctx* ctx,
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len, uint8_t* out_ciphertext_tag
+) {
+    size_t out_len = 0;
+    int status;
+
+    if (seal_len_exceeds_int(plaintext_len)) return NC_ERR_INVALID_ARGUMENT; // Use nc_aead_seal_ex().
+    status = nc_aead_seal_ex(ctx, plaintext, plaintext_len, nonce, nonce_len, aad, aad_len,
+                             out_ciphertext_tag, &out_len);
+    return status < 0 ? status : (int)out_len;
+}
+
+int nc_aead_open(
+        const nc_aead_ctx* ctx,
+        const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len, uint8_t* out_plaintext
+) {
+    size_t out_len = 0;
+    int status;
+
+    if (open_len_exceeds_int(ciphertext_tag_len)) return NC_ERR_INVALID_ARGUMENT; // Use nc_aead_open_ex().
+    status = nc_aead_open_ex(ctx, ciphertext_tag, ciphertext_tag_len, nonce, nonce_len, aad, aad_len,
+                             out_plaintext, &out_len);
+    return status < 0 ? status : (int)out_len;
+}
+
+// --- Nonce generation ---
+
+int nc_aead_generate_nonces(nc_aead_ctx* ctx, int mode, uint8_t* out_nonces, size_t count) {
+    uint64_t first;
+    size_t i;
+
+    // --- Parameter Validation ---
+    if (!out_nonces || count > NC_MAX_NONCES_PER_CALL) return NC_ERR_INVALID_ARGUMENT;
+    if (count == 0) return 0;
+
+    if (mode == NC_NONCE_RANDOM) {
+        // One RAND_bytes call for the whole batch.
+        return RAND_bytes(out_nonces, count * NC_NONCE_LEN) ? 0 : NC_ERR_INVALID_ARGUMENT;
+    }
+    if (mode != NC_NONCE_COUNTER || !ctx) return NC_ERR_INVALID_ARGUMENT;
+    // Counter nonces are NC_NONCE_LEN bytes; XChaCha20-Poly1305 takes 24-byte random nonces.
+    if (EVP_AEAD_nonce_length(EVP_AEAD_CTX_aead(&ctx->aead_ctx)) != NC_NONCE_LEN) return NC_ERR_UNSUPPORTED;
+
+    // One compare-and-swap reserves the whole range, so concurrent callers never share a value. The
+    // limit is checked before reserving, so a refused request leaves the counter untouched.
+    do {
+        first = NONCE_COUNTER_LOAD(ctx->nonce_counter);
+        if (first >= NONCE_COUNTER_LIMIT - count) return NC_ERR_INVALID_ARGUMENT;
+    } while (!NONCE_COUNTER_CAS(ctx->nonce_counter, first, first + count));
+    for (i = 0; i < count; i++) {
+        uint8_t* nonce = out_nonces + i * NC_NONCE_LEN;
+        uint64_t value = first + i;
+        int b;
+
+        memcpy(nonce, ctx->nonce_prefix, sizeof(ctx->nonce_prefix));
+        for (b = 0; b < 8; b++) nonce[NC_NONCE_LEN - 1 - b] = (uint8_t)(value >> (8 * b));
+    }
+    return 0;
+}
+
+int nc_aead_seal_auto_nonce(
+        nc_aead_ctx* ctx, int mode,
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* aad, size_t aad_len,
+        uint8_t* out_nonce, uint8_t* out_ciphertext_tag
+) {
+    int result;
+
+    // --- Parameter Validation ---
+    if (!ctx || !out_nonce) return NC_ERR_INVALID_ARGUMENT;
+    if (EVP_AEAD_nonce_length(EVP_AEAD_CTX_aead(&ctx->aead_ctx)) != NC_NONCE_LEN) return NC_ERR_UNSUPPORTED;
+
+    result = nc_aead_generate_nonces(ctx, mode, out_nonce, 1);
+    if (result < 0) return result;
+    return nc_aead_seal(ctx, plaintext, plaintext_len, out_nonce, NC_NONCE_LEN, aad, aad_len,
+                        out_ciphertext_tag);
+}
+
+// --- Batch API ---
+
+int nc_aead_seal_batch(
+        const nc_aead_ctx* ctx,
+        const nc_aead_batch_item* items, size_t count,
+        int* out_status
+) {
+    int succeeded = 0;
+    size_t i;
+
+    if (!ctx || !items || !out_status) return NC_ERR_INVALID_ARGUMENT;
+
+    for (i = 0; i < count; i++) {
+        const nc_aead_batch_item* item = &items[i];
+        out_status[i] = nc_aead_seal(ctx, item->input, item->input_len,
+                                     item->nonce, item->nonce_len,
+                                     item->aad, item->aad_len, item->output);
+        if (out_status[i] >= 0) succeeded++;
+    }
+    return succeeded;
+}
+
+int nc_aead_open_batch(
+        const nc_aead_ctx* ctx,
+        const nc_aead_batch_item* items, size_t count,
+        int* out_status
+) {
+    int succeeded = 0;
+    size_t i;
+
+    if (!ctx || !items || !out_status) return NC_ERR_INVALID_ARGUMENT;
+
+    for (i = 0; i < count; i++) {
+        const nc_aead_batch_item* item = &items[i];
+        out_status[i] = nc_aead_open(ctx, item->input, item->input_len,
+                                     item->nonce, item->nonce_len,
+                                     item->aad, item->aad_len, item->output);
+        if (out_status[i] >= 0) succeeded++;
+    }
+    return succeeded;
+}
+
+// --- In-place API ---
+
+int nc_aead_seal_in_place(
+        const nc_aead_ctx* ctx,
+        uint8_t* buffer, size_t plaintext_len,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len
+) {
+    // BoringSSL supports exact aliasing of input and output, so no scratch copy is needed.
+    return nc_aead_seal(ctx, buffer, plaintext_len, nonce, nonce_len, aad, aad_len, buffer);
+}
+
+int nc_aead_open_in_place(
+        const nc_aead_ctx* ctx,
+        uint8_t* buffer, size_t ciphertext_tag_len,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len
+) {
+    return nc_aead_open(ctx, buffer, ciphertext_tag_len, nonce, nonce_len, aad, aad_len, buffer);
+}
+
+// --- Scatter/gather API ---
+
+/**
+ * @brief Validates an iovec list, computes its total length and makes it contiguous in `out`.
+ *
+ * A single piece is returned as-is (zero copy). Several pieces are copied to their final
+ * offsets in `out`, so the caller can then run the AEAD in place on `out`.
+ *
+ * @param out_input Receives the pointer to the contiguous input.
+ * @param out_total Receives the total input length.
+ * @return 0 on success, or NC_ERR_INVALID_ARGUMENT.
+ */
+static int gather_input(const nc_iovec* in, size_t in_count, uint8_t* out,
+                        const uint8_t** out_input, size_t* out_total) {
+    size_t total = 0;
+    size_t i;
+
+    if (!in || in_count == 0 || !out) return NC_ERR_INVALID_ARGUMENT;
+    for (i = 0; i < in_count; i++) {
+        if (!in[i].base && in[i].len > 0) return NC_ERR_INVALID_ARGUMENT;
+        if (in[i].len > (size_t)INT_MAX - total) return NC_ERR_INVALID_ARGUMENT; // Result must fit an int.
+        total += in[i].len;
+    }
+
+    if (in_count == 1) {
+        if (buffers_partially_overlap(in[0].base, in[0].len, out, total)) return NC_ERR_INVALID_ARGUMENT;
+        *out_input = in[0].len > 0 ? in[0].base : out;
+    } else {
+        size_t offset = 0;
+        for (i = 0; i < in_count; i++) {
+            if (in[i].len == 0) continue;
+            // A piece already at its destination (e.g. a body read in place) needs no copy.
+            if (in[i].base != out + offset) {
+                if (buffers_partially_overlap(in[i].base, in[i].len, out, total)) return NC_ERR_INVALID_ARGUMENT;
+                memcpy(out + offset, in[i].base, in[i].len);
+            }
+            offset += in[i].len;
+        }
+        *out_input = out;
+    }
+    *out_total = total;
+    return 0;
+}
+
+int nc_aead_seal_scatter(
+        const nc_aead_ctx* ctx,
+        const nc_iovec* in, size_t in_count,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len,
+        uint8_t* out_ciphertext,
+        uint8_t* out_tag
+) {
+    const uint8_t* input = NULL;
+    size_t input_len = 0;
+    size_t tag_len = 0;
+
+    // --- Parameter Validation ---
+    if (!ctx || !nonce || !out_tag) return NC_ERR_INVALID_ARGUMENT;
+    if (nonce_len != EVP_AEAD_nonce_length(EVP_AEAD_CTX_aead(&ctx->aead_ctx))) return NC_ERR_INVALID_ARGUMENT;
+    if (gather_input(in, in_count, out_ciphertext, &input, &input_len) != 0) return NC_ERR_INVALID_ARGUMENT;
+
+    // --- Encryption (Seal Operation) ---
+    // The ciphertext goes to out_ciphertext and the tag to out_tag; no extra_in is used.
+    if (!EVP_AEAD_CTX_seal_scatter(&ctx->aead_ctx, out_ciphertext, out_tag, &tag_len, NC_AEAD_TAG_LEN,
+                                   nonce, nonce_len, input, input_len, NULL, 0, aad, aad_len)) {
+        nc_error_record(NC_FAILURE_SEAL, "EVP_AEAD_CTX_seal_scatter");
+        return NC_ERR_INVALID_ARGUMENT;
+    }
+    return (int)input_len;
+}
+
+int nc_aead_open_gather(
+        const nc_aead_ctx* ctx,
+        const nc_iovec* in, size_t in_count,
+        const uint8_t* tag, size_t tag_len,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len,
+        uint8_t* out_plaintext
+) {
+    const uint8_t* input = NULL;
+    size_t input_len = 0;
+
+    // --- Parameter Validation ---
+    if (!ctx || !tag || !nonce) return NC_ERR_INVALID_ARGUMENT;
+    if (ctx->seal_only) return NC_ERR_UNSUPPORTED;
+    if (nonce_len != EVP_AEAD_nonce_length(EVP_AEAD_CTX_aead(&ctx->aead_ctx))) return NC_ERR_INVALID_ARGUMENT;
+    if (tag_len != NC_AEAD_TAG_LEN) {
+        nc_error_record(NC_FAILURE_OPEN, "tag length (open gather)");
+        return NC_ERR_AUTHENTICATION;
+    }
+    if (gather_input(in, in_count, out_plaintext, &input, &input_len) != 0) return NC_ERR_INVALID_ARGUMENT;
+
+    // --- Decryption (Open Operation) ---
+    if (!EVP_AEAD_CTX_open_gather(&ctx->aead_ctx, out_plaintext, nonce, nonce_len,
+                                  input, input_len, tag, tag_len, aad, aad_len)) {
+        nc_error_record(NC_FAILURE_OPEN, "EVP_AEAD_CTX_open_gather");
+        // The plaintext is written before the tag check completes; never release it unverified.
+        OPENSSL_cleanse(out_plaintext, input_len);
+        return NC_ERR_AUTHENTICATION;
+    }
+    return (int)input_len;
+}
+
+// --- Verify-only API ---
+
+/**
+ * @brief Element of GF(2^128) in GCM's bit order: hi holds bytes 0-7 and lo bytes 8-15 of the
+ * block, both big-endian, so the coefficient of x^0 is the most significant bit of hi.
+ */
+typedef struct {
+    uint64_t hi;
+    uint64_t lo;
+} gf128;
+
+static gf128 gf128_load(const uint8_t block[16]) {
+    gf128 x = {0, 0};
+    int i;
+    for (i = 0; i < 8; i++) {
+        x.hi = (x.hi << 8) | block[i];
+        x.lo = (x.lo << 8) | block[8 + i];
+    }
+    return x;
+}
+
+static void gf128_store(gf128 x, uint8_t block[16]) {
+    int i;
+    for (i = 0; i < 8; i++) {
+        block[7 - i] = (uint8_t)(x.hi >> (8 * i));
+        block[15 - i] = (uint8_t)(x.lo >> (8 * i));
+    }
+}
+
+/**
+ * @brief Multiplies two field elements (NIST SP 800-38D, algorithm 1).
+ *
+ * Branch-free in both operands, since one of them is always derived from the hash key H. Only a
+ * handful of products are needed per message, so the bit-serial form is fast enough.
+ */
+static gf128 gf128_mul(gf128 x, gf128 y) {
+    gf128 z = {0, 0};
+    gf128 v = y;
+    int i;
+
+    for (i = 0; i < 128; i++) {
+        uint64_t bit = i < 64 ? (x.hi >> (63 - i)) & 1 : (x.lo >> (127 - i)) & 1;
+        uint64_t take = 0 - bit;
+        uint64_t reduce = 0 - (v.lo & 1);
+
+        z.hi ^= v.hi & take;
+        z.lo ^= v.lo & take;
+        v.lo = (v.lo >> 1) | (v.hi << 63);
+        v.hi = (v.hi >> 1) ^ (UINT64_C(0xe100000000000000) & reduce);
+    }
+    return z;
+}
+
+/**
+ * @brief Returns h^n. The exponent is a public block count, so it may steer branches.
+ */
+static gf128 gf128_pow(gf128 h, uint64_t n) {
+    gf128 result = {UINT64_C(1) << 63, 0}; // The multiplicative identity (x^0).
+
+    while (n) {
+        if (n & 1) result = gf128_mul(result, h);
+        h = gf128_mul(h, h);
+        n >>= 1;
+    }
+    return result;
+}
+
+/**
+ * @brief Inverse of the length block (len(A) = 128 bits, len(C) = 0) of a one-block GMAC.
+ *
+ * GMAC over one zero block is GHASH_H(0 || L) ^ E_K(J0) = L * H ^ E_K(J0), so H follows from two
+ * GMACs and one multiplication by this constant, without a second AES key schedule.
+ */
+static const gf128 kOneBlockLengthInverse = {UINT64_C(0x0800000000000000), UINT64_C(0x00da2b1efc975384)};
+
+/**
+ * @brief Computes GMAC over data: the GCM tag of an empty plaintext with data as the AAD.
+ *
+ * BoringSSL runs this through its hardware GHASH without generating any CTR keystream.
+ */
+static int gmac(const EVP_AEAD_CTX* ctx, const uint8_t* nonce, size_t nonce_len,
+                const uint8_t* data, size_t data_len, uint8_t tag[16]) {
+    size_t tag_len = 0;
+    return EVP_AEAD_CTX_seal(ctx, tag, &tag_len, NC_AEAD_TAG_LEN, nonce, nonce_len, tag, 0,
+                             data, data_len) && tag_len == NC_AEAD_TAG_LEN;
+}
+
+int verify_aes_gcm_256(
+        const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
+        const uint8_t* key, const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len
+) {
+    const EVP_AEAD *aead_alg = EVP_aead_aes_256_gcm();
+    EVP_AEAD_CTX scratch_ctx;
+    EVP_AEAD_CTX* ctx = NULL;
+    static const uint8_t kZeroBlock[16] = {0};
+    uint8_t block[16];
+    uint8_t expected[16];
+    size_t ciphertext_len;
+    gf128 h = {0, 0};
+    gf128 mask = {0, 0};
+    gf128 tag;
+    gf128 lengths;
+    int result_status = -1;
+
+    // --- Parameter Validation ---
+    if (!ciphertext_tag || !key || !nonce || (!aad && aad_len > 0)) return -1;
+    if (nonce_len != 12) return -1;
+    if (ciphertext_tag_len < NC_AEAD_TAG_LEN) { // Input too short to contain a tag
+        nc_error_record(NC_FAILURE_OPEN, "input shorter than the tag (verify AES)");
+        return -2;
+    }
+    ciphertext_len = ciphertext_tag_len - NC_AEAD_TAG_LEN;
+
+    ctx = acquire_aead_ctx(aead_alg, key, EVP_AEAD_key_length(aead_alg), &scratch_ctx,
+                           "EVP_AEAD_CTX_init (verify AES)");
+    if (!ctx) goto cleanup_aes_verify;
+
+    // --- Hash key H and mask E_K(J0) from the (possibly cached) context ---
+    // GMAC over nothing is E_K(J0) itself (GHASH of an all-zero length block is zero).
+    if (!gmac(ctx, nonce, nonce_len, NULL, 0, expected) ||
+        !gmac(ctx, nonce, nonce_len, kZeroBlock, sizeof(kZeroBlock), block)) {
+        nc_error_record(NC_FAILURE_SEAL, "EVP_AEAD_CTX_seal (verify AES)");
+        goto cleanup_aes_verify;
+    }
+    mask = gf128_load(expected);
+    h = gf128_load(block);
+    h.hi ^= mask.hi;
+    h.lo ^= mask.lo;
+    h = gf128_mul(h, kOneBlockLengthInverse);
+
+    // --- Tag reconstruction ---
+    // The real tag is GHASH_H(A || C || len(A) || len(C)) ^ E_K(J0). GMAC with C as the AAD gives
+    // GHASH_H(C || len(C) || 0) ^ E_K(J0): the same C blocks in the same positions, so only the
+    // length block (multiplied by H) and, with an AAD, the A blocks (shifted by H^c) differ.
+    // The length correction is one field multiplication; the AAD shift takes O(log c) of them
+    // for c ciphertext blocks, next to the single GHASH pass over the ciphertext.
+    if (!gmac(ctx, nonce, nonce_len, ciphertext_tag, ciphertext_len, block)) {
+        nc_error_record(NC_FAILURE_SEAL, "EVP_AEAD_CTX_seal (verify AES)");
+        goto cleanup_aes_verify;
     }
-    result_status = (int)actual_out_len;
+    tag = gf128_load(block);
+    // (len(A) || len(C)) ^ (len(C) || 0), in bits.
+    lengths.hi = ((uint64_t)aad_len << 3) ^ ((uint64_t)ciphertext_len << 3);
+    lengths.lo = (uint64_t)ciphertext_len << 3;
+    lengths = gf128_mul(lengths, h);
+    tag.hi ^= lengths.hi;
+    tag.lo ^= lengths.lo;
 
-    cleanup_chacha_decrypt:
+    if (aad_len > 0) {
+        gf128 aad_hash;
+
+        // GMAC over A alone gives GHASH_H(A) * H ^ len(A) * H ^ E_K(J0).
+        if (!gmac(ctx, nonce, nonce_len, aad, aad_len, block)) {
+            nc_error_record(NC_FAILURE_SEAL, "EVP_AEAD_CTX_seal (verify AES)");
+            goto cleanup_aes_verify;
+        }
+        aad_hash = gf128_load(block);
+        lengths.hi = (uint64_t)aad_len << 3;
+        lengths.lo = 0;
+        lengths = gf128_mul(lengths, h);
+        aad_hash.hi ^= mask.hi ^ lengths.hi;
+        aad_hash.lo ^= mask.lo ^ lengths.lo;
+        aad_hash = gf128_mul(aad_hash, gf128_pow(h, (ciphertext_len + 15) / 16));
+        tag.hi ^= aad_hash.hi;
+        tag.lo ^= aad_hash.lo;
+    }
+    gf128_store(tag, expected);
+
+    // --- Comparison ---
+    if (CRYPTO_memcmp(expected, ciphertext_tag + ciphertext_len, NC_AEAD_TAG_LEN) != 0) {
+        nc_error_record(NC_FAILURE_OPEN, "tag mismatch (verify AES)");
+        result_status = -2;
+        goto cleanup_aes_verify;
+    }
+    result_status = 0;
+
+    cleanup_aes_verify:
     // --- Cleanup ---
-    EVP_AEAD_CTX_cleanup(&ctx);
+    release_aead_ctx(ctx, &scratch_ctx);
+    OPENSSL_cleanse(&h, sizeof(h));
+    OPENSSL_cleanse(&mask, sizeof(mask));
+    OPENSSL_cleanse(block, sizeof(block));
+    OPENSSL_cleanse(expected, sizeof(expected));
+    return result_status;
+}
+
+/**
+ * @brief Feeds data to Poly1305 followed by zero padding up to a 16-byte boundary (RFC 8439).
+ */
+static void poly1305_update_padded(poly1305_state* state, const uint8_t* data, size_t len) {
+    static const uint8_t kPadding[16] = {0};
+
+    if (len > 0) CRYPTO_poly1305_update(state, data, len);
+    if (len % 16 != 0) CRYPTO_poly1305_update(state, kPadding, 16 - len % 16);
+}
+
+int verify_chacha20_poly1305(
+        const uint8_t* ciphertext_tag, size_t ciphertext_tag_len,
+        const uint8_t* key, const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len
+) {
+    static const uint8_t kZeros[32] = {0};
+    uint8_t poly_key[32];
+    uint8_t lengths[16];
+    uint8_t expected[16];
+    poly1305_state state;
+    size_t ciphertext_len;
+    int result_status = 0;
+    int i;
+
+    // --- Parameter Validation ---
+    if (!ciphertext_tag || !key || !nonce || (!aad && aad_len > 0)) return -1;
+    if (nonce_len != 12) return -1;
+    if (ciphertext_tag_len < NC_AEAD_TAG_LEN) { // Input too short to contain a tag
+        nc_error_record(NC_FAILURE_OPEN, "input shorter than the tag (verify ChaCha)");
+        return -2;
+    }
+    ciphertext_len = ciphertext_tag_len - NC_AEAD_TAG_LEN;
+
+    // --- One-time Poly1305 key: the first 32 bytes of ChaCha20 block 0 ---
+    // This is the only keystream generated; the ciphertext itself is never decrypted.
+    CRYPTO_chacha_20(poly_key, kZeros, sizeof(poly_key), key, nonce, 0);
+
+    // --- MAC over AAD || pad || C || pad || len(A) || len(C) (little-endian) ---
+    CRYPTO_poly1305_init(&state, poly_key);
+    poly1305_update_padded(&state, aad, aad_len);
+    poly1305_update_padded(&state, ciphertext_tag, ciphertext_len);
+    for (i = 0; i < 8; i++) {
+        lengths[i] = (uint8_t)((uint64_t)aad_len >> (8 * i));
+        lengths[8 + i] = (uint8_t)((uint64_t)ciphertext_len >> (8 * i));
+    }
+    CRYPTO_poly1305_update(&state, lengths, sizeof(lengths));
+    CRYPTO_poly1305_finish(&state, expected);
+
+    // --- Comparison ---
+    if (CRYPTO_memcmp(expected, ciphertext_tag + ciphertext_len, NC_AEAD_TAG_LEN) != 0) {
+        nc_error_record(NC_FAILURE_OPEN, "tag mismatch (verify ChaCha)");
+        result_status = -2;
+    }
+    OPENSSL_cleanse(poly_key, sizeof(poly_key));
+    OPENSSL_cleanse(expected, sizeof(expected));
     return result_status;
 }
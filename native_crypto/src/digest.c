@@ -0,0 +1,221 @@
+#include "native_crypto.h"  // Public API (nc_digest, nc_seal_digest)
+#include "errors.h"         // Internal failure recording
+#include "overlap.h"        // Partial-overlap check shared with the AEAD entry points
+#include <openssl/blake2.h>   // For BLAKE2b-256
+#include <openssl/chacha.h>   // For the raw ChaCha20 stream (tiled ChaCha20-Poly1305)
+#include <openssl/cipher.h>   // For the incremental AES-256-GCM cipher (tiled AES-GCM)
+#include <openssl/mem.h>      // For OPENSSL_cleanse
+#include <openssl/poly1305.h> // For the incremental Poly1305 MAC (tiled ChaCha20-Poly1305)
+#include <openssl/sha.h>      // For SHA-256
+
+// The fused seal walks the plaintext in tiles small enough to stay in L1/L2: each tile is hashed
+// and then encrypted (and, for ChaCha20-Poly1305, MACed) while it is still cached, instead of the
+// digest making a second pass over a buffer the cipher has already streamed through.
+// The one-shot EVP_AEAD interface cannot be fed in pieces, so the tiles go through BoringSSL's
+// incremental AES-GCM cipher, or through ChaCha20 and Poly1305 directly (RFC 8439). Either way the
+// output is the usual ciphertext || tag and opens with the regular decrypt functions.
+
+// ChaCha20 advances its block counter every 64 bytes, so tiles are whole blocks.
+#define CHACHA_BLOCK_LEN 64
+// Largest tile: one EVP_EncryptUpdate call takes an int length.
+#define MAX_TILE_SIZE ((size_t)1 << 30)
+// ChaCha20-Poly1305 uses block 0 for the MAC key and has a 32-bit block counter.
+#define CHACHA_MAX_PLAINTEXT_LEN ((((uint64_t)1 << 32) - 1) * CHACHA_BLOCK_LEN)
+
+/**
+ * @brief State of either supported digest.
+ */
+typedef struct {
+    int kind; // NC_DIGEST_* identifier.
+    union {
+        SHA256_CTX sha256;
+        BLAKE2B_CTX blake2b;
+    } u;
+} digest_state;
+
+static int digest_init(digest_state* state, int kind) {
+    state->kind = kind;
+    switch (kind) {
+        case NC_DIGEST_SHA256:
+            return SHA256_Init(&state->u.sha256) ? 0 : NC_ERR_INVALID_ARGUMENT;
+        case NC_DIGEST_BLAKE2B_256:
+            BLAKE2B256_Init(&state->u.blake2b);
+            return 0;
+        default:
+            return NC_ERR_UNSUPPORTED;
+    }
+}
+
+static void digest_update(digest_state* state, const uint8_t* data, size_t len) {
+    if (len == 0) return;
+    if (state->kind == NC_DIGEST_SHA256) {
+        SHA256_Update(&state->u.sha256, data, len);
+    } else {
+        BLAKE2B256_Update(&state->u.blake2b, data, len);
+    }
+}
+
+static void digest_final(digest_state* state, uint8_t out_digest[NC_DIGEST_LEN]) {
+    if (state->kind == NC_DIGEST_SHA256) {
+        SHA256_Final(out_digest, &state->u.sha256);
+    } else {
+        BLAKE2B256_Final(out_digest, &state->u.blake2b);
+    }
+    OPENSSL_cleanse(state, sizeof(*state));
+}
+
+int nc_digest(int digest, const uint8_t* data, size_t len, uint8_t* out_digest) {
+    digest_state state;
+    int result;
+
+    if ((!data && len > 0) || !out_digest) return NC_ERR_INVALID_ARGUMENT;
+    result = digest_init(&state, digest);
+    if (result < 0) return result;
+    digest_update(&state, data, len);
+    digest_final(&state, out_digest);
+    return 0;
+}
+
+// --- AES-256-GCM ---
+
+static int seal_tiles_aes_gcm(const uint8_t* key, const uint8_t* plaintext, size_t plaintext_len,
+                              const uint8_t* nonce, const uint8_t* aad, size_t aad_len, size_t tile_size,
+                              digest_state* digest, uint8_t* out) {
+    EVP_CIPHER_CTX* cipher = EVP_CIPHER_CTX_new();
+    size_t offset;
+    int len;
+    int result = NC_ERR_INVALID_ARGUMENT;
+
+    if (!cipher) return NC_ERR_INVALID_ARGUMENT;
+    if (!EVP_EncryptInit_ex(cipher, EVP_aes_256_gcm(), NULL, NULL, NULL) ||
+        !EVP_CIPHER_CTX_ctrl(cipher, EVP_CTRL_AEAD_SET_IVLEN, 12, NULL) ||
+        !EVP_EncryptInit_ex(cipher, NULL, NULL, key, nonce)) {
+        nc_error_record(NC_FAILURE_INIT, "EVP_EncryptInit_ex (seal digest AES)");
+        goto cleanup;
+    }
+    // The AAD goes in before any plaintext, in int-sized pieces.
+    for (offset = 0; offset < aad_len; offset += MAX_TILE_SIZE) {
+        size_t n = aad_len - offset < MAX_TILE_SIZE ? aad_len - offset : MAX_TILE_SIZE;
+        if (!EVP_EncryptUpdate(cipher, NULL, &len, aad + offset, (int)n)) goto seal_failed;
+    }
+    for (offset = 0; offset < plaintext_len; offset += tile_size) {
+        size_t n = plaintext_len - offset < tile_size ? plaintext_len - offset : tile_size;
+
+        // Hash first: with in-place use the encryption overwrites the plaintext.
+        digest_update(digest, plaintext + offset, n);
+        if (!EVP_EncryptUpdate(cipher, out + offset, &len, plaintext + offset, (int)n) || (size_t)len != n) {
+            goto seal_failed;
+        }
+    }
+    if (!EVP_EncryptFinal_ex(cipher, out + plaintext_len, &len) ||
+        !EVP_CIPHER_CTX_ctrl(cipher, EVP_CTRL_AEAD_GET_TAG, NC_AEAD_TAG_LEN, out + plaintext_len)) {
+        goto seal_failed;
+    }
+    result = 0;
+    goto cleanup;
+
+    seal_failed:
+    nc_error_record(NC_FAILURE_SEAL, "EVP_EncryptUpdate (seal digest AES)");
+    cleanup:
+    EVP_CIPHER_CTX_free(cipher); // Also wipes the key schedule.
+    return result;
+}
+
+// --- ChaCha20-Poly1305 ---
+
+static const uint8_t kPoly1305Padding[16] = {0};
+
+/**
+ * @brief Pads the Poly1305 input up to a 16-byte boundary after len bytes of data.
+ */
+static void poly1305_pad(poly1305_state* state, size_t len) {
+    if (len % 16 != 0) CRYPTO_poly1305_update(state, kPoly1305Padding, 16 - len % 16);
+}
+
+static int seal_tiles_chacha(const uint8_t* key, const uint8_t* plaintext, size_t plaintext_len,
+                             const uint8_t* nonce, const uint8_t* aad, size_t aad_len, size_t tile_size,
+                             digest_state* digest, uint8_t* out) {
+    static const uint8_t kZeros[32] = {0};
+    uint8_t poly_key[32];
+    uint8_t lengths[16];
+    poly1305_state mac;
+    size_t offset;
+    int i;
+
+    if ((uint64_t)plaintext_len > CHACHA_MAX_PLAINTEXT_LEN) return NC_ERR_INVALID_ARGUMENT;
+
+    // Block 0 keys Poly1305; the plaintext is encrypted from block 1 on.
+    CRYPTO_chacha_20(poly_key, kZeros, sizeof(poly_key), key, nonce, 0);
+    CRYPTO_poly1305_init(&mac, poly_key);
+    OPENSSL_cleanse(poly_key, sizeof(poly_key));
+    if (aad_len > 0) CRYPTO_poly1305_update(&mac, aad, aad_len);
+    poly1305_pad(&mac, aad_len);
+
+    // Tiles are whole 16-byte blocks, so only the last one can need Poly1305 padding.
+    for (offset = 0; offset < plaintext_len; offset += tile_size) {
+        size_t n = plaintext_len - offset < tile_size ? plaintext_len - offset : tile_size;
+
+        digest_update(digest, plaintext + offset, n);
+        CRYPTO_chacha_20(out + offset, plaintext + offset, n, key, nonce,
+                         (uint32_t)(1 + offset / CHACHA_BLOCK_LEN));
+        CRYPTO_poly1305_update(&mac, out + offset, n); // Still cached from the encryption.
+    }
+    poly1305_pad(&mac, plaintext_len);
+    for (i = 0; i < 8; i++) {
+        lengths[i] = (uint8_t)((uint64_t)aad_len >> (8 * i));
+        lengths[8 + i] = (uint8_t)((uint64_t)plaintext_len >> (8 * i));
+    }
+    CRYPTO_poly1305_update(&mac, lengths, sizeof(lengths));
+    CRYPTO_poly1305_finish(&mac, out + plaintext_len);
+    return 0;
+}
+
+int nc_seal_digest(
+        int algorithm,
+        const uint8_t* key, size_t key_len,
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* nonce, size_t nonce_len,
+        const uint8_t* aad, size_t aad_len,
+        int digest, size_t tile_size,
+        uint8_t* out_ciphertext_tag, size_t* out_len,
+        uint8_t* out_digest
+) {
+    digest_state state;
+    int result;
+
+    // --- Parameter Validation ---
+    if (!key || (!plaintext && plaintext_len > 0) || !nonce || (!aad && aad_len > 0) ||
+        !out_ciphertext_tag || !out_len || !out_digest) {
+        return NC_ERR_INVALID_ARGUMENT;
+    }
+    *out_len = 0;
+    if (algorithm != NC_ALG_AES_256_GCM && algorithm != NC_ALG_CHACHA20_POLY1305) return NC_ERR_UNSUPPORTED;
+    if (key_len != 32 || nonce_len != 12) return NC_ERR_INVALID_ARGUMENT;
+    if (plaintext_len > SIZE_MAX - NC_AEAD_TAG_LEN) return NC_ERR_INVALID_ARGUMENT;
+    if (buffers_partially_overlap(plaintext, plaintext_len, out_ciphertext_tag, plaintext_len + NC_AEAD_TAG_LEN)) {
+        return NC_ERR_INVALID_ARGUMENT;
+    }
+    if (tile_size == 0) tile_size = NC_DEFAULT_TILE_SIZE;
+    if (tile_size > MAX_TILE_SIZE) tile_size = MAX_TILE_SIZE;
+    tile_size -= tile_size % CHACHA_BLOCK_LEN;
+    if (tile_size == 0) return NC_ERR_INVALID_ARGUMENT;
+
+    result = digest_init(&state, digest);
+    if (result < 0) return result;
+
+    // --- Fused pass ---
+    if (algorithm == NC_ALG_AES_256_GCM) {
+        result = seal_tiles_aes_gcm(key, plaintext, plaintext_len, nonce, aad, aad_len, tile_size, &state,
+                                    out_ciphertext_tag);
+    } else {
+        result = seal_tiles_chacha(key, plaintext, plaintext_len, nonce, aad, aad_len, tile_size, &state,
+                                   out_ciphertext_tag);
+    }
+    if (result < 0) {
+        OPENSSL_cleanse(&state, sizeof(state));
+        return result;
+    }
+    digest_final(&state, out_digest);
+    *out_len = plaintext_len + NC_AEAD_TAG_LEN;
+    return 0;
+}
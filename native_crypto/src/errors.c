@@ -0,0 +1,147 @@
+#include "errors.h"
+#include "native_crypto.h" // Public API (error counters and ring)
+#include <openssl/err.h>    // For ERR_get_error, ERR_clear_error
+#include <stdlib.h>         // For calloc, free
+#include <string.h>         // For memset
+
+#ifdef NATIVE_CRYPTO_LOG_ERRORS
+#include <stdio.h>          // For fprintf (debug builds only)
+#endif
+
+#ifndef _WIN32
+#include <pthread.h>        // For the ring mutex
+#else
+#include <windows.h>        // For SRWLOCK
+#endif
+
+#if !defined(_MSC_VER) || defined(__clang__)
+#include <stdatomic.h>      // For atomic_int
+#endif
+
+#if defined(_MSC_VER)
+#define NC_THREAD_LOCAL __declspec(thread)
+#else
+#define NC_THREAD_LOCAL _Thread_local
+#endif
+
+// Failure counters of the calling thread; no synchronization is needed on the failure path.
+static NC_THREAD_LOCAL nc_error_counters t_counters;
+
+// --- Error ring ---
+// A process-wide ring of the most recent failures, disabled (capacity 0) by default. The lock is
+// only taken when the ring is enabled, so a disabled ring costs one relaxed load per failure.
+
+#ifndef _WIN32
+static pthread_mutex_t g_ring_lock = PTHREAD_MUTEX_INITIALIZER;
+#define RING_LOCK() pthread_mutex_lock(&g_ring_lock)
+#define RING_UNLOCK() pthread_mutex_unlock(&g_ring_lock)
+#else
+static SRWLOCK g_ring_lock = SRWLOCK_INIT;
+#define RING_LOCK() AcquireSRWLockExclusive(&g_ring_lock)
+#define RING_UNLOCK() ReleaseSRWLockExclusive(&g_ring_lock)
+#endif
+
+static nc_error_entry* g_ring = NULL;       // Entries (guarded by g_ring_lock).
+static size_t g_ring_capacity = 0;          // Capacity of g_ring (guarded by g_ring_lock).
+static uint64_t g_ring_sequence = 0;        // Failures recorded since the ring was configured.
+
+// Unlocked fast-path check of whether the ring is enabled.
+#if defined(_MSC_VER) && !defined(__clang__)
+static volatile long g_ring_enabled = 0; // MSVC gives volatile accesses acquire/release semantics.
+#define RING_ENABLED() (g_ring_enabled != 0)
+#define SET_RING_ENABLED(value) (g_ring_enabled = (value))
+#else
+static atomic_int g_ring_enabled = 0;
+#define RING_ENABLED() atomic_load_explicit(&g_ring_enabled, memory_order_relaxed)
+#define SET_RING_ENABLED(value) atomic_store_explicit(&g_ring_enabled, (value), memory_order_relaxed)
+#endif
+
+/**
+ * @brief Maps a failure kind to the NC_ERR_* code returned to the caller.
+ */
+static int code_for_kind(nc_failure_kind kind) {
+    return kind == NC_FAILURE_OPEN ? NC_ERR_AUTHENTICATION : NC_ERR_INVALID_ARGUMENT;
+}
+
+void nc_error_record(nc_failure_kind kind, const char* context) {
+    switch (kind) {
+        case NC_FAILURE_INIT:
+            t_counters.init_failures++;
+            break;
+        case NC_FAILURE_SEAL:
+            t_counters.seal_failures++;
+            break;
+        case NC_FAILURE_OPEN:
+            t_counters.auth_failures++;
+            break;
+    }
+
+    if (RING_ENABLED()) {
+        // Only the first queued error is kept; it identifies the failure.
+        uint32_t library_error = (uint32_t)ERR_get_error();
+        RING_LOCK();
+        if (g_ring_capacity > 0) {
+            nc_error_entry* entry = &g_ring[g_ring_sequence % g_ring_capacity];
+            entry->sequence = g_ring_sequence++;
+            entry->library_error = library_error;
+            entry->code = code_for_kind(kind);
+            entry->context = context;
+        }
+        RING_UNLOCK();
+    }
+
+#ifdef NATIVE_CRYPTO_LOG_ERRORS
+    fprintf(stderr, "native_crypto: %s failed\n", context);
+#endif
+    // Drops the remaining queued errors without formatting them.
+    ERR_clear_error();
+}
+
+void nc_error_counters_get(nc_error_counters* out_counters) {
+    if (out_counters) *out_counters = t_counters;
+}
+
+void nc_error_counters_reset(void) {
+    memset(&t_counters, 0, sizeof(t_counters));
+}
+
+int nc_error_ring_configure(size_t capacity) {
+    nc_error_entry* ring = NULL;
+    nc_error_entry* old_ring;
+
+    if (capacity > 0) {
+        ring = (nc_error_entry*)calloc(capacity, sizeof(nc_error_entry));
+        if (!ring) return NC_ERR_INVALID_ARGUMENT;
+    }
+
+    RING_LOCK();
+    old_ring = g_ring;
+    g_ring = ring;
+    g_ring_capacity = capacity;
+    g_ring_sequence = 0;
+    SET_RING_ENABLED(capacity > 0);
+    RING_UNLOCK();
+
+    free(old_ring);
+    return 0;
+}
+
+size_t nc_error_ring_snapshot(nc_error_entry* out_entries, size_t max_entries) {
+    size_t count = 0;
+    size_t i;
+
+    if (!out_entries || max_entries == 0) return 0;
+    RING_LOCK();
+    if (g_ring_capacity > 0) {
+        // The ring holds the last min(sequence, capacity) failures; copy the newest ones oldest first.
+        uint64_t available = g_ring_sequence < g_ring_capacity ? g_ring_sequence : g_ring_capacity;
+        uint64_t first;
+        count = available < max_entries ? (size_t)available : max_entries;
+        first = g_ring_sequence - count;
+        for (i = 0; i < count; i++) {
+            out_entries[i] = g_ring[(first + i) % g_ring_capacity];
+        }
+    }
+    RING_UNLOCK();
+    return count;
+}
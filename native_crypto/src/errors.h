@@ -0,0 +1,25 @@
+#ifndef NATIVE_CRYPTO_ERRORS_H
+#define NATIVE_CRYPTO_ERRORS_H
+
+// Internal failure recording used instead of printing BoringSSL errors.
+// This header is not part of the public API.
+
+/** @brief Kind of a failure reported by BoringSSL. */
+typedef enum {
+    NC_FAILURE_INIT = 0, // EVP_AEAD_CTX_init failed (key setup).
+    NC_FAILURE_SEAL,     // A seal operation failed.
+    NC_FAILURE_OPEN,     // An open operation rejected its input (tag mismatch or corrupt input).
+} nc_failure_kind;
+
+/**
+ * @brief Records a BoringSSL failure without any I/O.
+ *
+ * Increments the calling thread's counter for the kind, appends an entry to the error ring if
+ * it is enabled, and clears the BoringSSL error queue so it cannot grow across failures.
+ *
+ * @param kind Kind of the failure.
+ * @param context Static string naming the failing operation (stored by pointer in the ring).
+ */
+void nc_error_record(nc_failure_kind kind, const char* context);
+
+#endif // NATIVE_CRYPTO_ERRORS_H
@@ -0,0 +1,307 @@
+#ifndef _WIN32
+#define _GNU_SOURCE            // For sync_file_range
+#define _FILE_OFFSET_BITS 64   // 64-bit off_t on 32-bit Android/Linux
+#endif
+
+#include "native_crypto.h" // Public API (handle-based seal/open used for every segment)
+#include "errors.h"        // Internal failure recording
+#include "file_io.h"       // Input/output file pair shared with the io_uring engine
+#include "segment.h"       // Segment layout shared with the parallel and streaming modes
+#include <stdint.h>         // For uint64_t, SIZE_MAX
+
+#ifndef _WIN32
+#include <fcntl.h>          // For open, posix_fallocate, sync_file_range
+#include <sys/mman.h>       // For mmap, munmap, madvise
+#include <sys/stat.h>       // For fstat
+#include <unistd.h>         // For close, ftruncate, unlink, sysconf
+#endif
+
+#ifndef _WIN32
+
+// Segments are processed in windows of about this many input bytes. While one window is being
+// encrypted the kernel is already reading the next one (MADV_WILLNEED) and writing back the
+// previous one, so page cache I/O overlaps with the crypto work.
+#define FILE_WINDOW_SIZE ((size_t)8 * 1024 * 1024)
+
+// sync_file_range starts writeback without waiting for it (Linux only; bionic has it from API 26).
+#if defined(__linux__) && (!defined(__ANDROID__) || __ANDROID_API__ >= 26)
+#define HAVE_SYNC_FILE_RANGE 1
+#endif
+
+/**
+ * @brief A read-only or read-write mapping of a whole file (data is NULL for an empty file).
+ */
+typedef struct {
+    uint8_t* data;
+    size_t len;
+} file_map;
+
+/**
+ * @brief Applies madvise() to [offset, offset + len) of a mapping, widened to whole pages.
+ */
+static void advise_range(const file_map* map, size_t offset, size_t len, int advice) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t start;
+    size_t end;
+
+    if (!map->data || offset >= map->len || len == 0) return;
+    start = offset - offset % page;
+    end = (len > map->len - offset) ? map->len : offset + len;
+    madvise(map->data + start, end - start, advice);
+}
+
+/**
+ * @brief Maps len bytes of fd, hinting sequential access (a no-op mapping for len 0).
+ *
+ * @return 0 on success, or NC_ERR_IO if mmap failed.
+ */
+static int map_file(int fd, size_t len, int writable, file_map* map) {
+    void* data;
+
+    map->data = NULL;
+    map->len = len;
+    if (len == 0) return 0;
+    data = mmap(NULL, len, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) return NC_ERR_IO;
+    map->data = (uint8_t*)data;
+    madvise(map->data, len, MADV_SEQUENTIAL);
+    return 0;
+}
+
+static void unmap_file(file_map* map) {
+    if (map->data) munmap(map->data, map->len);
+    map->data = NULL;
+}
+
+/**
+ * @brief Seals or opens every segment of a mapped input into a mapped output, window by window.
+ *
+ * @return 0 on success, or the first negative error code of a segment.
+ */
+static int process_segments(const nc_aead_ctx* ctx, int is_seal, const file_map* in, const file_map* out,
+                            int out_fd, const uint8_t* nonce_prefix, const uint8_t* aad, size_t aad_len,
+                            size_t segment_size, size_t num_segments) {
+    static const uint8_t kEmpty[1] = {0}; // Stand-in input pointer for an empty mapping.
+    uint8_t empty_out[1];                 // Stand-in output pointer for an empty mapping.
+    size_t in_stride = is_seal ? segment_size : segment_size + SEGMENT_TAG_LEN;
+    size_t out_stride = is_seal ? segment_size + SEGMENT_TAG_LEN : segment_size;
+    size_t window_segments = FILE_WINDOW_SIZE / in_stride;
+    size_t first;
+
+    if (window_segments == 0) window_segments = 1;
+    for (first = 0; first < num_segments; first += window_segments) {
+        size_t last = num_segments - first < window_segments ? num_segments : first + window_segments;
+        size_t in_start = first * in_stride;
+        size_t out_start = first * out_stride;
+        size_t in_window = (last - first) * in_stride;
+        size_t out_window = (last - first) * out_stride;
+        size_t i;
+
+        // Start reading the next window while this one is being processed.
+        advise_range(in, in_start + in_window, in_window, MADV_WILLNEED);
+
+        for (i = first; i < last; i++) {
+            int is_last = i + 1 == num_segments;
+            size_t in_offset = i * in_stride;
+            size_t in_len = is_last ? in->len - in_offset : in_stride;
+            const uint8_t* src = in->data ? in->data + in_offset : kEmpty;
+            uint8_t* dst = out->data ? out->data + i * out_stride : empty_out;
+            uint8_t nonce[12];
+            int written;
+
+            build_segment_nonce(nonce, nonce_prefix, i, is_last);
+            written = is_seal
+                      ? nc_aead_seal(ctx, src, in_len, nonce, sizeof(nonce), aad, aad_len, dst)
+                      : nc_aead_open(ctx, src, in_len, nonce, sizeof(nonce), aad, aad_len, dst);
+            if (written < 0) return written;
+        }
+
+#ifdef HAVE_SYNC_FILE_RANGE
+        // Queue writeback of the finished window now instead of at munmap/close time.
+        if (out->data && out_start < out->len) {
+            size_t len = out->len - out_start < out_window ? out->len - out_start : out_window;
+            sync_file_range(out_fd, (off_t)out_start, (off_t)len, SYNC_FILE_RANGE_WRITE);
+        }
+#else
+        (void)out_fd;
+        (void)out_window;
+        (void)out_start;
+#endif
+        // The finished input window is no longer needed in this mapping (it stays in the page cache).
+        advise_range(in, in_start, in_window, MADV_DONTNEED);
+    }
+    return 0;
+}
+
+/**
+ * @brief Computes the segment count and output length for a seal or open of in_len bytes.
+ *
+ * @return 0 on success, NC_ERR_AUTHENTICATION for a malformed ciphertext length, or
+ *         NC_ERR_UNSUPPORTED if the result does not fit in memory on this platform.
+ */
+static int file_layout(int is_seal, uint64_t in_len, size_t segment_size,
+                       size_t* out_num_segments, size_t* out_len) {
+    size_t stride = segment_size + SEGMENT_TAG_LEN;
+    size_t num_segments;
+    size_t last_len;
+
+    if (in_len > SIZE_MAX - SEGMENT_TAG_LEN) return NC_ERR_UNSUPPORTED;
+    if (is_seal) {
+        num_segments = segment_count((size_t)in_len, segment_size);
+        if (num_segments > MAX_SEGMENTS) return NC_ERR_INVALID_ARGUMENT;
+        if (num_segments > (SIZE_MAX - (size_t)in_len) / SEGMENT_TAG_LEN) return NC_ERR_UNSUPPORTED;
+        *out_num_segments = num_segments;
+        *out_len = (size_t)in_len + num_segments * SEGMENT_TAG_LEN;
+        return 0;
+    }
+
+    // Same rules as nc_parallel_open(): only the last segment may be short, and only a
+    // single-segment message may be empty.
+    num_segments = (size_t)in_len / stride + ((size_t)in_len % stride != 0);
+    last_len = (size_t)in_len - (num_segments - 1) * stride;
+    if (num_segments == 0 || num_segments > MAX_SEGMENTS || last_len < SEGMENT_TAG_LEN ||
+        (last_len == SEGMENT_TAG_LEN && num_segments > 1)) {
+        nc_error_record(NC_FAILURE_OPEN, "segment layout (file open)");
+        return NC_ERR_AUTHENTICATION;
+    }
+    *out_num_segments = num_segments;
+    *out_len = (size_t)in_len - num_segments * SEGMENT_TAG_LEN;
+    return 0;
+}
+
+int nc_file_pair_open(nc_file_pair* pair, int is_seal, const char* in_path, const char* out_path,
+                      size_t segment_size) {
+    struct stat in_stat;
+    struct stat out_stat;
+    int result;
+
+    pair->in_fd = -1;
+    pair->out_fd = -1;
+    if (segment_size == 0) segment_size = NC_DEFAULT_SEGMENT_SIZE;
+    if (segment_size > MAX_SEGMENT_SIZE) return NC_ERR_INVALID_ARGUMENT;
+    pair->segment_size = segment_size;
+
+    // --- Input ---
+    pair->in_fd = open(in_path, O_RDONLY | O_CLOEXEC);
+    if (pair->in_fd < 0) return NC_ERR_IO;
+    if (fstat(pair->in_fd, &in_stat) != 0 || !S_ISREG(in_stat.st_mode)) {
+        result = NC_ERR_IO;
+        goto fail;
+    }
+    result = file_layout(is_seal, (uint64_t)in_stat.st_size, segment_size, &pair->num_segments, &pair->out_len);
+    if (result < 0) goto fail;
+    pair->in_len = (size_t)in_stat.st_size;
+
+    // --- Output ---
+    // The output is only truncated once it is known not to be the input file itself.
+    pair->out_fd = open(out_path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (pair->out_fd < 0) {
+        result = NC_ERR_IO;
+        goto fail;
+    }
+    if (fstat(pair->out_fd, &out_stat) != 0) {
+        result = NC_ERR_IO;
+        goto fail;
+    }
+    if (out_stat.st_dev == in_stat.st_dev && out_stat.st_ino == in_stat.st_ino) {
+        result = NC_ERR_INVALID_ARGUMENT;
+        goto fail;
+    }
+    // The blocks are reserved rather than left sparse: a store to a mapped hole that the file system
+    // cannot back (full disk, quota) raises SIGBUS instead of returning an error.
+    if (ftruncate(pair->out_fd, 0) != 0 ||
+        (pair->out_len > 0 && posix_fallocate(pair->out_fd, 0, (off_t)pair->out_len) != 0)) {
+        // The output has been truncated already, so it is removed like after a failed run.
+        nc_file_pair_close(pair, out_path, NC_ERR_IO);
+        return NC_ERR_IO;
+    }
+    return 0;
+
+    fail:
+    if (pair->out_fd >= 0) close(pair->out_fd);
+    close(pair->in_fd);
+    pair->in_fd = -1;
+    pair->out_fd = -1;
+    return result;
+}
+
+int nc_file_pair_close(nc_file_pair* pair, const char* out_path, int result) {
+    close(pair->in_fd);
+    if (close(pair->out_fd) != 0 && result == 0) result = NC_ERR_IO;
+    pair->in_fd = -1;
+    pair->out_fd = -1;
+    // Never leave a partial or unauthenticated output behind.
+    if (result < 0) unlink(out_path);
+    return result;
+}
+
+/**
+ * @brief Shared implementation of nc_file_seal() and nc_file_open().
+ */
+static int file_process(const nc_aead_ctx* ctx, int is_seal, const char* in_path, const char* out_path,
+                        const uint8_t* nonce_prefix, const uint8_t* aad, size_t aad_len,
+                        size_t segment_size, uint64_t* out_len) {
+    nc_file_pair pair;
+    file_map in_map = {NULL, 0};
+    file_map out_map = {NULL, 0};
+    int result;
+
+    // --- Parameter Validation ---
+    if (!ctx || !in_path || !out_path || !nonce_prefix || (!aad && aad_len > 0)) {
+        return NC_ERR_INVALID_ARGUMENT;
+    }
+    result = nc_file_pair_open(&pair, is_seal, in_path, out_path, segment_size);
+    if (result < 0) return result;
+
+    // --- Encryption or decryption over the mappings ---
+    // The input mapping is only safe while the file keeps its size: pages past a concurrent
+    // truncation raise SIGBUS when touched (see the File API notes in native_crypto.h).
+    result = map_file(pair.in_fd, pair.in_len, 0, &in_map);
+    if (result == 0) result = map_file(pair.out_fd, pair.out_len, 1, &out_map);
+    if (result == 0) {
+        result = process_segments(ctx, is_seal, &in_map, &out_map, pair.out_fd, nonce_prefix, aad, aad_len,
+                                  pair.segment_size, pair.num_segments);
+    }
+    unmap_file(&in_map);
+    unmap_file(&out_map);
+
+    result = nc_file_pair_close(&pair, out_path, result);
+    if (result < 0) return result;
+    if (out_len) *out_len = (uint64_t)pair.out_len;
+    return 0;
+}
+
+#endif // !_WIN32
+
+int nc_file_seal(
+        const nc_aead_ctx* ctx,
+        const char* in_path, const char* out_path,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size, uint64_t* out_len
+) {
+#ifndef _WIN32
+    return file_process(ctx, 1, in_path, out_path, nonce_prefix, aad, aad_len, segment_size, out_len);
+#else
+    (void)ctx; (void)in_path; (void)out_path; (void)nonce_prefix;
+    (void)aad; (void)aad_len; (void)segment_size; (void)out_len;
+    return NC_ERR_UNSUPPORTED;
+#endif
+}
+
+int nc_file_open(
+        const nc_aead_ctx* ctx,
+        const char* in_path, const char* out_path,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size, uint64_t* out_plaintext_len
+) {
+#ifndef _WIN32
+    return file_process(ctx, 0, in_path, out_path, nonce_prefix, aad, aad_len, segment_size,
+                        out_plaintext_len);
+#else
+    (void)ctx; (void)in_path; (void)out_path; (void)nonce_prefix;
+    (void)aad; (void)aad_len; (void)segment_size; (void)out_plaintext_len;
+    return NC_ERR_UNSUPPORTED;
+#endif
+}
@@ -0,0 +1,41 @@
+#ifndef NATIVE_CRYPTO_FILE_IO_H
+#define NATIVE_CRYPTO_FILE_IO_H
+
+// Input/output file handling shared by the file engines (mmap and io_uring).
+// This header is not part of the public API. POSIX only.
+
+#include <stddef.h> // For size_t
+
+/**
+ * @brief An input file and its output file, sized for a segmented seal or open.
+ */
+typedef struct {
+    int in_fd;
+    int out_fd;
+    size_t in_len;       // Size of the input file.
+    size_t out_len;      // Size of the output file (already allocated with posix_fallocate).
+    size_t segment_size; // Plaintext bytes per segment (never 0).
+    size_t num_segments;
+} nc_file_pair;
+
+/**
+ * @brief Opens the input, validates its length for the segmented format, and creates or
+ *        truncates the output and reserves its blocks at their final size.
+ *
+ * @param is_seal 1 if the input is plaintext, 0 if it is a segmented ciphertext.
+ * @param segment_size Plaintext bytes per segment (0 selects NC_DEFAULT_SEGMENT_SIZE).
+ * @return 0 on success, or NC_ERR_INVALID_ARGUMENT (also when both paths name the same file),
+ *         NC_ERR_AUTHENTICATION, NC_ERR_IO (also when the blocks cannot be reserved) or
+ *         NC_ERR_UNSUPPORTED. Nothing is left open on failure.
+ */
+int nc_file_pair_open(nc_file_pair* pair, int is_seal, const char* in_path, const char* out_path,
+                      size_t segment_size);
+
+/**
+ * @brief Closes both files and removes the output if result (or closing it) reports a failure.
+ *
+ * @return result, or NC_ERR_IO if closing the output failed.
+ */
+int nc_file_pair_close(nc_file_pair* pair, const char* out_path, int result);
+
+#endif // NATIVE_CRYPTO_FILE_IO_H
@@ -0,0 +1,255 @@
+#include "native_crypto.h" // Public API (nc_mem_sampler)
+#include <stdlib.h>         // For calloc, free
+#include <string.h>         // For memset
+
+#ifndef _WIN32
+#include <fcntl.h>   // For open
+#include <pthread.h> // For the sampler thread
+#include <stdio.h>   // For sscanf
+#include <time.h>    // For clock_gettime
+#include <unistd.h>  // For pread, close, sysconf
+#if defined(__GLIBC__) || defined(__ANDROID__)
+#include <malloc.h>  // For mallinfo / mallinfo2
+#endif
+#endif
+
+#ifndef _WIN32
+
+// Heap statistics source: mallinfo2 (glibc 2.33+), else the older mallinfo (int fields on glibc,
+// size_t on bionic), else none.
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#define HEAP_MALLINFO2 1
+#elif defined(__GLIBC__) || defined(__ANDROID__)
+#define HEAP_MALLINFO 1
+#endif
+
+/**
+ * @brief Internal layout of the opaque nc_mem_sampler handle.
+ *
+ * The statistics are only touched with the mutex held; the sampler thread releases the mutex
+ * while it reads /proc and mallinfo.
+ */
+struct nc_mem_sampler {
+    pthread_mutex_t mutex;   // Guards every field below.
+    pthread_cond_t cond;     // Signalled when a phase begins or the sampler stops.
+    pthread_t thread;
+    int statm_fd;            // /proc/self/statm, kept open and re-read with pread().
+    uint64_t page_size;
+    uint64_t period_ns;      // Time between two samples.
+    int active;              // 1 while a phase runs.
+    int stopping;            // Set by nc_mem_sampler_free().
+    nc_mem_stats stats;      // Statistics of the current phase.
+    uint64_t rss_sum;        // Sum of the RSS samples of the current phase.
+    uint64_t heap_sum;       // Sum of the heap samples of the current phase.
+};
+
+/**
+ * @brief Reads the current RSS in bytes (0 if it cannot be read).
+ */
+static uint64_t read_rss(const nc_mem_sampler* sampler) {
+    char text[128];
+    unsigned long size_pages = 0;
+    unsigned long resident_pages = 0;
+    ssize_t len = pread(sampler->statm_fd, text, sizeof(text) - 1, 0);
+
+    if (len <= 0) return 0;
+    text[len] = '\0';
+    if (sscanf(text, "%lu %lu", &size_pages, &resident_pages) != 2) return 0;
+    return (uint64_t)resident_pages * sampler->page_size;
+}
+
+/**
+ * @brief Reads the bytes in use by malloc, including chunks served by mmap (large buffers).
+ */
+static uint64_t read_heap(void) {
+#if defined(HEAP_MALLINFO2)
+    struct mallinfo2 info = mallinfo2();
+    return (uint64_t)info.uordblks + (uint64_t)info.hblkhd;
+#elif defined(HEAP_MALLINFO)
+    struct mallinfo info = mallinfo();
+    return (uint64_t)(size_t)info.uordblks + (uint64_t)(size_t)info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Adds one sample to the statistics of the current phase. Called with the mutex held.
+ */
+static void record_sample(nc_mem_sampler* sampler, uint64_t rss, uint64_t heap) {
+    nc_mem_stats* stats = &sampler->stats;
+
+    if (stats->samples == 0) {
+        stats->rss_start_bytes = rss;
+        stats->heap_start_bytes = heap;
+    }
+    stats->samples++;
+    stats->rss_end_bytes = rss;
+    stats->heap_end_bytes = heap;
+    sampler->rss_sum += rss;
+    sampler->heap_sum += heap;
+    if (rss > stats->rss_peak_bytes) stats->rss_peak_bytes = rss;
+    if (heap > stats->heap_peak_bytes) stats->heap_peak_bytes = heap;
+}
+
+/**
+ * @brief Returns the absolute CLOCK_REALTIME deadline ns from now (the clock of pthread_cond_timedwait).
+ */
+static struct timespec deadline_after(uint64_t ns) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ns += (uint64_t)ts.tv_nsec;
+    ts.tv_sec += (time_t)(ns / 1000000000ull);
+    ts.tv_nsec = (long)(ns % 1000000000ull);
+    return ts;
+}
+
+/**
+ * @brief Sampler loop: sleeps while idle, samples once per period while a phase runs.
+ */
+static void* sampler_main(void* opaque) {
+    nc_mem_sampler* sampler = (nc_mem_sampler*)opaque;
+
+    pthread_mutex_lock(&sampler->mutex);
+    while (!sampler->stopping) {
+        struct timespec deadline;
+        uint64_t rss, heap;
+
+        if (!sampler->active) {
+            pthread_cond_wait(&sampler->cond, &sampler->mutex);
+            continue;
+        }
+
+        // Wait one period; begin/end/free wake the thread early.
+        deadline = deadline_after(sampler->period_ns);
+        while (sampler->active && !sampler->stopping &&
+               pthread_cond_timedwait(&sampler->cond, &sampler->mutex, &deadline) == 0) {
+        }
+        if (!sampler->active || sampler->stopping) continue;
+
+        pthread_mutex_unlock(&sampler->mutex);
+        rss = read_rss(sampler);
+        heap = read_heap();
+        pthread_mutex_lock(&sampler->mutex);
+        // The phase may have ended while the sample was taken.
+        if (sampler->active) record_sample(sampler, rss, heap);
+    }
+    pthread_mutex_unlock(&sampler->mutex);
+    return NULL;
+}
+
+nc_mem_sampler* nc_mem_sampler_new(unsigned int rate_hz) {
+    nc_mem_sampler* sampler;
+    long page_size = sysconf(_SC_PAGESIZE);
+
+    if (rate_hz == 0) rate_hz = NC_MEM_SAMPLER_DEFAULT_HZ;
+    sampler = (nc_mem_sampler*)calloc(1, sizeof(nc_mem_sampler));
+    if (!sampler) return NULL;
+
+    sampler->statm_fd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+    if (sampler->statm_fd < 0) {
+        free(sampler);
+        return NULL;
+    }
+    sampler->page_size = page_size > 0 ? (uint64_t)page_size : 4096;
+    sampler->period_ns = 1000000000ull / rate_hz;
+    pthread_mutex_init(&sampler->mutex, NULL);
+    pthread_cond_init(&sampler->cond, NULL);
+
+    if (pthread_create(&sampler->thread, NULL, sampler_main, sampler) != 0) {
+        pthread_cond_destroy(&sampler->cond);
+        pthread_mutex_destroy(&sampler->mutex);
+        close(sampler->statm_fd);
+        free(sampler);
+        return NULL;
+    }
+    return sampler;
+}
+
+int nc_mem_sampler_begin(nc_mem_sampler* sampler) {
+    uint64_t rss, heap;
+
+    if (!sampler) return NC_ERR_INVALID_ARGUMENT;
+    rss = read_rss(sampler);
+    heap = read_heap();
+
+    pthread_mutex_lock(&sampler->mutex);
+    if (sampler->active) {
+        pthread_mutex_unlock(&sampler->mutex);
+        return NC_ERR_INVALID_ARGUMENT;
+    }
+    memset(&sampler->stats, 0, sizeof(sampler->stats));
+    sampler->rss_sum = 0;
+    sampler->heap_sum = 0;
+    record_sample(sampler, rss, heap);
+    sampler->active = 1;
+    pthread_cond_signal(&sampler->cond);
+    pthread_mutex_unlock(&sampler->mutex);
+    return 0;
+}
+
+int nc_mem_sampler_end(nc_mem_sampler* sampler, nc_mem_stats* out_stats) {
+    uint64_t rss, heap;
+
+    if (!sampler || !out_stats) return NC_ERR_INVALID_ARGUMENT;
+    rss = read_rss(sampler);
+    heap = read_heap();
+
+    pthread_mutex_lock(&sampler->mutex);
+    if (!sampler->active) {
+        pthread_mutex_unlock(&sampler->mutex);
+        return NC_ERR_INVALID_ARGUMENT;
+    }
+    record_sample(sampler, rss, heap);
+    sampler->active = 0;
+    pthread_cond_signal(&sampler->cond);
+
+    *out_stats = sampler->stats;
+    out_stats->rss_avg_bytes = sampler->rss_sum / sampler->stats.samples;
+    out_stats->heap_avg_bytes = sampler->heap_sum / sampler->stats.samples;
+#if defined(HEAP_MALLINFO2) || defined(HEAP_MALLINFO)
+    out_stats->heap_supported = 1;
+#endif
+    pthread_mutex_unlock(&sampler->mutex);
+    return 0;
+}
+
+void nc_mem_sampler_free(nc_mem_sampler* sampler) {
+    if (!sampler) return;
+    pthread_mutex_lock(&sampler->mutex);
+    sampler->stopping = 1;
+    pthread_cond_signal(&sampler->cond);
+    pthread_mutex_unlock(&sampler->mutex);
+
+    pthread_join(sampler->thread, NULL);
+    pthread_cond_destroy(&sampler->cond);
+    pthread_mutex_destroy(&sampler->mutex);
+    close(sampler->statm_fd);
+    free(sampler);
+}
+
+#else // _WIN32
+
+// Windows has no /proc; the sampler is unavailable there.
+
+nc_mem_sampler* nc_mem_sampler_new(unsigned int rate_hz) {
+    (void)rate_hz;
+    return NULL;
+}
+
+int nc_mem_sampler_begin(nc_mem_sampler* sampler) {
+    (void)sampler;
+    return NC_ERR_INVALID_ARGUMENT;
+}
+
+int nc_mem_sampler_end(nc_mem_sampler* sampler, nc_mem_stats* out_stats) {
+    (void)sampler;
+    (void)out_stats;
+    return NC_ERR_INVALID_ARGUMENT;
+}
+
+void nc_mem_sampler_free(nc_mem_sampler* sampler) {
+    (void)sampler;
+}
+
+#endif // _WIN32
@@ -0,0 +1,26 @@
+#ifndef NATIVE_CRYPTO_OVERLAP_H
+#define NATIVE_CRYPTO_OVERLAP_H
+
+// Buffer aliasing check shared by the AEAD entry points and the fused seal-and-digest.
+// This header is not part of the public API.
+
+#include <stddef.h> // For size_t
+#include <stdint.h> // For uint8_t, uintptr_t
+
+/**
+ * @brief Checks whether an output buffer partially overlaps an input buffer.
+ *
+ * BoringSSL's seal and open support exact aliasing (in == out, in-place operation) but not
+ * partially overlapping buffers, which would overwrite input before it has been read.
+ *
+ * @return 1 if the buffers overlap without being identical, 0 otherwise.
+ */
+static inline int buffers_partially_overlap(const uint8_t* in, size_t in_len, const uint8_t* out, size_t out_len) {
+    uintptr_t in_start = (uintptr_t)in;
+    uintptr_t out_start = (uintptr_t)out;
+    if (in_start == out_start) return 0; // Exact aliasing (in-place) is supported.
+    if (in_len == 0 || out_len == 0) return 0; // Empty ranges never overlap.
+    return in_start < out_start + out_len && out_start < in_start + in_len;
+}
+
+#endif // NATIVE_CRYPTO_OVERLAP_H
@@ -0,0 +1,201 @@
+#include "native_crypto.h" // Public API (handle-based seal/open used for every segment)
+#include "errors.h"        // Internal failure recording
+#include "segment.h"       // Segment layout shared with the streaming mode
+#include "thread_pool.h"   // Internal worker pool
+#include <stdlib.h>         // For malloc, free
+#include <string.h>         // For memcpy, memset
+
+/**
+ * @brief Shared state of one parallel seal or open call.
+ *
+ * Each pool task handles a contiguous range of segments and reports its result in
+ * its own slot of `task_status`, so workers never write to shared memory.
+ */
+typedef struct {
+    const nc_aead_ctx* ctx;
+    const uint8_t* in;            // Plaintext (seal) or segmented ciphertext (open).
+    size_t in_len;
+    uint8_t* out;                 // Segmented ciphertext (seal) or plaintext (open).
+    const uint8_t* nonce_prefix;  // NC_SEGMENT_NONCE_PREFIX_LEN bytes.
+    const uint8_t* aad;
+    size_t aad_len;
+    size_t segment_size;          // Plaintext bytes per segment.
+    size_t num_segments;
+    size_t num_tasks;
+    int* task_status;             // One result per task (0 or a negative error code).
+} segment_job;
+
+size_t nc_segmented_ciphertext_len(size_t plaintext_len, size_t segment_size) {
+    if (segment_size == 0) segment_size = NC_DEFAULT_SEGMENT_SIZE;
+    return plaintext_len + segment_count(plaintext_len, segment_size) * SEGMENT_TAG_LEN;
+}
+
+/**
+ * @brief Pool task: seals segments [first, last) of the job.
+ */
+static void seal_segments_task(void* arg, size_t task) {
+    segment_job* job = (segment_job*)arg;
+    size_t first = task * job->num_segments / job->num_tasks;
+    size_t last = (task + 1) * job->num_segments / job->num_tasks;
+    size_t i;
+
+    job->task_status[task] = 0;
+    for (i = first; i < last; i++) {
+        size_t offset = i * job->segment_size;
+        size_t len = (i + 1 == job->num_segments) ? job->in_len - offset : job->segment_size;
+        uint8_t nonce[12];
+        int written;
+
+        build_segment_nonce(nonce, job->nonce_prefix, i, i + 1 == job->num_segments);
+        written = nc_aead_seal(job->ctx, job->in + offset, len, nonce, sizeof(nonce),
+                               job->aad, job->aad_len,
+                               job->out + offset + i * SEGMENT_TAG_LEN);
+        if (written < 0) {
+            job->task_status[task] = written;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Pool task: opens segments [first, last) of the job.
+ */
+static void open_segments_task(void* arg, size_t task) {
+    segment_job* job = (segment_job*)arg;
+    size_t first = task * job->num_segments / job->num_tasks;
+    size_t last = (task + 1) * job->num_segments / job->num_tasks;
+    size_t stride = job->segment_size + SEGMENT_TAG_LEN;
+    size_t i;
+
+    job->task_status[task] = 0;
+    for (i = first; i < last; i++) {
+        size_t offset = i * stride;
+        size_t len = (i + 1 == job->num_segments) ? job->in_len - offset : stride;
+        uint8_t nonce[12];
+        int written;
+
+        build_segment_nonce(nonce, job->nonce_prefix, i, i + 1 == job->num_segments);
+        written = nc_aead_open(job->ctx, job->in + offset, len, nonce, sizeof(nonce),
+                               job->aad, job->aad_len,
+                               job->out + i * job->segment_size);
+        if (written < 0) {
+            job->task_status[task] = written;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Splits the job into tasks and runs them on the shared pool (or inline for one thread).
+ *
+ * @return 0 if every task succeeded, otherwise the first task error.
+ */
+static int run_segment_job(segment_job* job, size_t num_threads, nc_task_fn task_fn) {
+    nc_thread_pool* pool = NULL;
+    int result = 0;
+    size_t i;
+
+    if (num_threads != 1) {
+        pool = nc_shared_thread_pool();
+        if (num_threads == 0) num_threads = pool ? nc_thread_pool_size(pool) : 1;
+    }
+    job->num_tasks = num_threads < job->num_segments ? num_threads : job->num_segments;
+    job->task_status = (int*)malloc(job->num_tasks * sizeof(int));
+    if (!job->task_status) return NC_ERR_INVALID_ARGUMENT;
+
+    nc_thread_pool_run(pool, task_fn, job, job->num_tasks);
+
+    for (i = 0; i < job->num_tasks && result == 0; i++) {
+        result = job->task_status[i];
+    }
+    free(job->task_status);
+    return result;
+}
+
+int nc_parallel_seal(
+        const nc_aead_ctx* ctx,
+        const uint8_t* plaintext, size_t plaintext_len,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size, size_t num_threads,
+        uint8_t* out, size_t* out_len
+) {
+    segment_job job;
+    int result;
+
+    // --- Parameter Validation ---
+    if (!ctx || !plaintext || !nonce_prefix || !out || !out_len) return NC_ERR_INVALID_ARGUMENT;
+    if (segment_size == 0) segment_size = NC_DEFAULT_SEGMENT_SIZE;
+    if (segment_size > MAX_SEGMENT_SIZE) return NC_ERR_INVALID_ARGUMENT;
+
+    memset(&job, 0, sizeof(job));
+    job.ctx = ctx;
+    job.in = plaintext;
+    job.in_len = plaintext_len;
+    job.out = out;
+    job.nonce_prefix = nonce_prefix;
+    job.aad = aad;
+    job.aad_len = aad_len;
+    job.segment_size = segment_size;
+    job.num_segments = segment_count(plaintext_len, segment_size);
+    if (job.num_segments > MAX_SEGMENTS) return NC_ERR_INVALID_ARGUMENT;
+
+    // --- Encryption (one task per thread, contiguous segment ranges) ---
+    result = run_segment_job(&job, num_threads, seal_segments_task);
+    if (result < 0) return result;
+
+    *out_len = plaintext_len + job.num_segments * SEGMENT_TAG_LEN;
+    return 0;
+}
+
+int nc_parallel_open(
+        const nc_aead_ctx* ctx,
+        const uint8_t* ciphertext, size_t ciphertext_len,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size, size_t num_threads,
+        uint8_t* out_plaintext, size_t* out_plaintext_len
+) {
+    segment_job job;
+    size_t stride;
+    size_t last_len;
+    int result;
+
+    // --- Parameter Validation ---
+    if (!ctx || !ciphertext || !nonce_prefix || !out_plaintext || !out_plaintext_len) {
+        return NC_ERR_INVALID_ARGUMENT;
+    }
+    if (segment_size == 0) segment_size = NC_DEFAULT_SEGMENT_SIZE;
+    if (segment_size > MAX_SEGMENT_SIZE) return NC_ERR_INVALID_ARGUMENT;
+
+    memset(&job, 0, sizeof(job));
+    stride = segment_size + SEGMENT_TAG_LEN;
+    job.num_segments = ciphertext_len / stride + (ciphertext_len % stride != 0);
+    // Only the last segment may be short, and only a single-segment message may be empty.
+    last_len = ciphertext_len - (job.num_segments - 1) * stride;
+    if (job.num_segments == 0 || job.num_segments > MAX_SEGMENTS || last_len < SEGMENT_TAG_LEN ||
+        (last_len == SEGMENT_TAG_LEN && job.num_segments > 1)) {
+        nc_error_record(NC_FAILURE_OPEN, "segment layout (parallel open)");
+        return NC_ERR_AUTHENTICATION;
+    }
+
+    job.ctx = ctx;
+    job.in = ciphertext;
+    job.in_len = ciphertext_len;
+    job.out = out_plaintext;
+    job.nonce_prefix = nonce_prefix;
+    job.aad = aad;
+    job.aad_len = aad_len;
+    job.segment_size = segment_size;
+
+    // --- Decryption (one task per thread, contiguous segment ranges) ---
+    result = run_segment_job(&job, num_threads, open_segments_task);
+    if (result < 0) {
+        // Other tasks may already have written their segments; never release partial plaintext.
+        memset(out_plaintext, 0, ciphertext_len - job.num_segments * SEGMENT_TAG_LEN);
+        return result;
+    }
+
+    *out_plaintext_len = ciphertext_len - job.num_segments * SEGMENT_TAG_LEN;
+    return 0;
+}
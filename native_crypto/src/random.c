@@ -0,0 +1,69 @@
+#include "native_crypto.h" // Public API (nc_fill_random)
+#include <openssl/rand.h>   // For RAND_bytes (cryptographic mode)
+#include <string.h>         // For memcpy
+
+// The seeded mode is xoshiro256** (Blackman and Vigna), seeded through splitmix64. It is not a
+// cryptographic generator, but it needs no system calls and produces the same bytes for the same seed
+// on every platform: words are always written little-endian.
+
+/**
+ * @brief splitmix64 step, used to expand the 64-bit seed into the generator state.
+ */
+static uint64_t splitmix64(uint64_t* state) {
+    uint64_t z = (*state += UINT64_C(0x9E3779B97F4A7C15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+}
+
+static uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * @brief xoshiro256** step.
+ */
+static uint64_t xoshiro_next(uint64_t s[4]) {
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+static void store_le64(uint8_t* out, uint64_t value) {
+    int i;
+    for (i = 0; i < 8; i++) out[i] = (uint8_t)(value >> (8 * i));
+}
+
+int nc_fill_random(uint8_t* buf, size_t len, int mode, uint64_t seed) {
+    uint64_t state[4];
+    uint64_t seed_state = seed;
+    size_t offset;
+    int i;
+
+    // --- Parameter Validation ---
+    if (!buf && len > 0) return NC_ERR_INVALID_ARGUMENT;
+    if (len == 0) return mode == NC_RANDOM_CRYPTO || mode == NC_RANDOM_SEEDED ? 0 : NC_ERR_INVALID_ARGUMENT;
+
+    if (mode == NC_RANDOM_CRYPTO) {
+        return RAND_bytes(buf, len) ? 0 : NC_ERR_INVALID_ARGUMENT;
+    }
+    if (mode != NC_RANDOM_SEEDED) return NC_ERR_INVALID_ARGUMENT;
+
+    for (i = 0; i < 4; i++) state[i] = splitmix64(&seed_state);
+    for (offset = 0; offset + 8 <= len; offset += 8) {
+        store_le64(buf + offset, xoshiro_next(state));
+    }
+    if (offset < len) {
+        uint8_t last[8];
+        store_le64(last, xoshiro_next(state));
+        memcpy(buf + offset, last, len - offset);
+    }
+    return 0;
+}
@@ -0,0 +1,202 @@
+#include "ring.h"
+
+#ifndef _WIN32
+
+#include <stdlib.h> // For posix_memalign, free
+#include <string.h> // For memcpy
+
+// The ring indices are free-running; only their low bits select a cell.
+
+/**
+ * @brief Rounds n up to a power of two (at least 2).
+ */
+static size_t round_up_pow2(size_t n) {
+    size_t capacity = 2;
+    while (capacity < n) capacity <<= 1;
+    return capacity;
+}
+
+/**
+ * @brief Allocates size bytes on their own cache lines, so the ring never shares a line with
+ * unrelated data.
+ */
+static void* alloc_lines(size_t size) {
+    void* ptr = NULL;
+    size = (size + NC_CACHE_LINE - 1) & ~(size_t)(NC_CACHE_LINE - 1);
+    if (posix_memalign(&ptr, NC_CACHE_LINE, size ? size : NC_CACHE_LINE) != 0) return NULL;
+    return ptr;
+}
+
+// --- MPSC ring ---
+
+static _Atomic size_t* cell_seq(const nc_mpsc_ring* ring, size_t pos) {
+    return (_Atomic size_t*)(ring->cells + (pos & ring->mask) * ring->cell_size);
+}
+
+static void* cell_elem(const nc_mpsc_ring* ring, size_t pos) {
+    return ring->cells + (pos & ring->mask) * ring->cell_size + sizeof(_Atomic size_t);
+}
+
+int nc_mpsc_ring_init(nc_mpsc_ring* ring, size_t min_capacity, size_t elem_size) {
+    size_t capacity = round_up_pow2(min_capacity);
+    size_t i;
+
+    ring->mask = capacity - 1;
+    ring->elem_size = elem_size;
+    ring->cell_size = (sizeof(_Atomic size_t) + elem_size + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+    ring->cells = (unsigned char*)alloc_lines(capacity * ring->cell_size);
+    if (!ring->cells) return -1;
+    // A cell is free for the producer at position pos while its sequence equals pos.
+    for (i = 0; i < capacity; i++) atomic_init(cell_seq(ring, i), i);
+    atomic_init(&ring->tail, 0);
+    ring->head = 0;
+    return 0;
+}
+
+void nc_mpsc_ring_destroy(nc_mpsc_ring* ring) {
+    free(ring->cells);
+    ring->cells = NULL;
+}
+
+int nc_mpsc_ring_push(nc_mpsc_ring* ring, const void* elem) {
+    size_t pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    for (;;) {
+        size_t seq = atomic_load_explicit(cell_seq(ring, pos), memory_order_acquire);
+        ptrdiff_t diff = (ptrdiff_t)(seq - pos);
+
+        if (diff == 0) {
+            // The cell is free: claim the position (pos is reloaded on failure).
+            if (atomic_compare_exchange_weak_explicit(&ring->tail, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return 0; // The consumer has not yet freed this cell: the ring is full.
+        } else {
+            pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        }
+    }
+    memcpy(cell_elem(ring, pos), elem, ring->elem_size);
+    atomic_store_explicit(cell_seq(ring, pos), pos + 1, memory_order_release);
+    return 1;
+}
+
+size_t nc_mpsc_ring_pop(nc_mpsc_ring* ring, void* out, size_t max) {
+    unsigned char* dst = (unsigned char*)out;
+    size_t n;
+
+    for (n = 0; n < max; n++) {
+        size_t pos = ring->head;
+
+        if (atomic_load_explicit(cell_seq(ring, pos), memory_order_acquire) != pos + 1) break;
+        memcpy(dst + n * ring->elem_size, cell_elem(ring, pos), ring->elem_size);
+        // Hand the cell back to producers for the position one lap ahead.
+        atomic_store_explicit(cell_seq(ring, pos), pos + ring->mask + 1, memory_order_release);
+        ring->head = pos + 1;
+    }
+    return n;
+}
+
+int nc_mpsc_ring_empty(nc_mpsc_ring* ring) {
+    return atomic_load_explicit(cell_seq(ring, ring->head), memory_order_acquire) != ring->head + 1;
+}
+
+// --- SPSC ring ---
+
+int nc_spsc_ring_init(nc_spsc_ring* ring, size_t min_capacity, size_t elem_size) {
+    size_t capacity = round_up_pow2(min_capacity);
+
+    ring->mask = capacity - 1;
+    ring->elem_size = elem_size;
+    ring->elems = (unsigned char*)alloc_lines(capacity * elem_size);
+    if (!ring->elems) return -1;
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->head, 0);
+    ring->cached_head = 0;
+    ring->cached_tail = 0;
+    return 0;
+}
+
+void nc_spsc_ring_destroy(nc_spsc_ring* ring) {
+    free(ring->elems);
+    ring->elems = NULL;
+}
+
+size_t nc_spsc_ring_push(nc_spsc_ring* ring, const void* elems, size_t count) {
+    const unsigned char* src = (const unsigned char*)elems;
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    size_t capacity = ring->mask + 1;
+    size_t n;
+
+    if (tail - ring->cached_head + count > capacity) {
+        ring->cached_head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    }
+    if (count > capacity - (tail - ring->cached_head)) count = capacity - (tail - ring->cached_head);
+    for (n = 0; n < count; n++) {
+        memcpy(ring->elems + ((tail + n) & ring->mask) * ring->elem_size, src + n * ring->elem_size,
+               ring->elem_size);
+    }
+    atomic_store_explicit(&ring->tail, tail + count, memory_order_release);
+    return count;
+}
+
+int nc_spsc_ring_empty(nc_spsc_ring* ring) {
+    return atomic_load_explicit(&ring->tail, memory_order_acquire) ==
+           atomic_load_explicit(&ring->head, memory_order_relaxed);
+}
+
+size_t nc_spsc_ring_pop(nc_spsc_ring* ring, void* out, size_t max) {
+    unsigned char* dst = (unsigned char*)out;
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t n;
+
+    if (ring->cached_tail - head < max) {
+        ring->cached_tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    }
+    if (max > ring->cached_tail - head) max = ring->cached_tail - head;
+    for (n = 0; n < max; n++) {
+        memcpy(dst + n * ring->elem_size, ring->elems + ((head + n) & ring->mask) * ring->elem_size,
+               ring->elem_size);
+    }
+    atomic_store_explicit(&ring->head, head + max, memory_order_release);
+    return max;
+}
+
+// --- Doorbell ---
+
+int nc_doorbell_init(nc_doorbell* bell) {
+    atomic_init(&bell->sleeping, 0);
+    if (pthread_mutex_init(&bell->mutex, NULL) != 0) return -1;
+    if (pthread_cond_init(&bell->cond, NULL) != 0) {
+        pthread_mutex_destroy(&bell->mutex);
+        return -1;
+    }
+    return 0;
+}
+
+void nc_doorbell_destroy(nc_doorbell* bell) {
+    pthread_cond_destroy(&bell->cond);
+    pthread_mutex_destroy(&bell->mutex);
+}
+
+void nc_doorbell_ring(nc_doorbell* bell) {
+    // Orders the caller's publication before the sleeper check; pairs with the fence in
+    // nc_doorbell_wait(), so either the producer sees a sleeper or the sleeper sees the entry.
+    atomic_thread_fence(memory_order_seq_cst);
+    if (!atomic_load_explicit(&bell->sleeping, memory_order_relaxed)) return;
+    pthread_mutex_lock(&bell->mutex);
+    pthread_cond_broadcast(&bell->cond);
+    pthread_mutex_unlock(&bell->mutex);
+}
+
+void nc_doorbell_wait(nc_doorbell* bell, int (*ready)(void* arg), void* arg) {
+    pthread_mutex_lock(&bell->mutex);
+    atomic_fetch_add_explicit(&bell->sleeping, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    while (!ready(arg)) pthread_cond_wait(&bell->cond, &bell->mutex);
+    atomic_fetch_sub_explicit(&bell->sleeping, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&bell->mutex);
+}
+
+#endif // _WIN32
@@ -0,0 +1,129 @@
+#ifndef NATIVE_CRYPTO_RING_H
+#define NATIVE_CRYPTO_RING_H
+
+#include <stddef.h> // For size_t
+
+// Internal bounded lock-free rings used by the asynchronous engine, and the doorbell that wakes
+// a sleeping consumer. Elements are fixed-size and copied in and out by value.
+// This header is not part of the public API.
+
+#ifndef _WIN32
+
+#include <pthread.h>   // For the doorbell's mutex and condition variable
+#include <stdatomic.h> // For the ring indices
+
+#define NC_CACHE_LINE 64
+
+/**
+ * @brief Bounded multi-producer, single-consumer ring.
+ *
+ * Each cell carries a sequence number (Vyukov's bounded queue): producers claim a position with a
+ * CAS on tail and publish the cell by advancing its sequence, so a producer that is preempted
+ * mid-copy only delays the consumer at that cell and never blocks other producers.
+ */
+typedef struct nc_mpsc_ring {
+    _Alignas(NC_CACHE_LINE) _Atomic size_t tail; // Next position to claim (producers).
+    _Alignas(NC_CACHE_LINE) size_t head;         // Next position to consume (consumer only).
+    _Alignas(NC_CACHE_LINE) unsigned char* cells;
+    size_t mask;                                 // Capacity - 1 (capacity is a power of two).
+    size_t elem_size;
+    size_t cell_size;                            // Sequence number + element, rounded up.
+} nc_mpsc_ring;
+
+/**
+ * @brief Bounded single-producer, single-consumer ring.
+ *
+ * Each side caches the other side's index and only reloads it when the ring looks full or empty.
+ */
+typedef struct nc_spsc_ring {
+    _Alignas(NC_CACHE_LINE) _Atomic size_t tail; // Written by the producer.
+    size_t cached_head;                          // Producer's copy of head.
+    _Alignas(NC_CACHE_LINE) _Atomic size_t head; // Written by the consumer.
+    size_t cached_tail;                          // Consumer's copy of tail.
+    _Alignas(NC_CACHE_LINE) unsigned char* elems;
+    size_t mask;
+    size_t elem_size;
+} nc_spsc_ring;
+
+/**
+ * @brief Wakes a consumer that went to sleep on an empty ring.
+ *
+ * The fast path stays lock-free: a producer only takes the mutex when a consumer has announced
+ * that it is about to sleep, and rings once for a whole batch of entries.
+ */
+typedef struct nc_doorbell {
+    _Atomic int sleeping; // Number of threads inside nc_doorbell_wait().
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+} nc_doorbell;
+
+/**
+ * @brief Initializes a ring of at least min_capacity elements (rounded up to a power of two).
+ *
+ * @return 0 on success, or -1 if memory is exhausted.
+ */
+int nc_mpsc_ring_init(nc_mpsc_ring* ring, size_t min_capacity, size_t elem_size);
+void nc_mpsc_ring_destroy(nc_mpsc_ring* ring);
+
+/**
+ * @brief Copies elem into the ring. Safe to call from any number of threads.
+ *
+ * @return 1 on success, 0 if the ring is full.
+ */
+int nc_mpsc_ring_push(nc_mpsc_ring* ring, const void* elem);
+
+/**
+ * @brief Moves up to max elements into out, oldest first. Only one thread may pop at a time.
+ *
+ * Stops early at a cell whose producer has claimed it but not yet published it.
+ *
+ * @return The number of elements copied.
+ */
+size_t nc_mpsc_ring_pop(nc_mpsc_ring* ring, void* out, size_t max);
+
+/**
+ * @brief Returns 1 if the consumer would currently find nothing to pop.
+ */
+int nc_mpsc_ring_empty(nc_mpsc_ring* ring);
+
+int nc_spsc_ring_init(nc_spsc_ring* ring, size_t min_capacity, size_t elem_size);
+void nc_spsc_ring_destroy(nc_spsc_ring* ring);
+
+/**
+ * @brief Copies up to count elements into the ring and publishes them with one store.
+ *
+ * @return The number of elements pushed (fewer than count if the ring filled up).
+ */
+size_t nc_spsc_ring_push(nc_spsc_ring* ring, const void* elems, size_t count);
+
+/**
+ * @brief Moves up to max elements into out, oldest first.
+ *
+ * @return The number of elements copied.
+ */
+size_t nc_spsc_ring_pop(nc_spsc_ring* ring, void* out, size_t max);
+
+/**
+ * @brief Consumer side: returns 1 if there is nothing to pop.
+ */
+int nc_spsc_ring_empty(nc_spsc_ring* ring);
+
+int nc_doorbell_init(nc_doorbell* bell);
+void nc_doorbell_destroy(nc_doorbell* bell);
+
+/**
+ * @brief Producer side: wakes the consumer if it is sleeping. Call after publishing entries.
+ */
+void nc_doorbell_ring(nc_doorbell* bell);
+
+/**
+ * @brief Consumer side: sleeps until ready(arg) returns nonzero.
+ *
+ * ready() is checked again after the thread is counted as sleeping, so an entry published
+ * concurrently with nc_doorbell_ring() is never missed.
+ */
+void nc_doorbell_wait(nc_doorbell* bell, int (*ready)(void* arg), void* arg);
+
+#endif // _WIN32
+
+#endif // NATIVE_CRYPTO_RING_H
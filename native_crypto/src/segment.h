@@ -0,0 +1,39 @@
+#ifndef NATIVE_CRYPTO_SEGMENT_H
+#define NATIVE_CRYPTO_SEGMENT_H
+
+// Segment layout shared by the parallel and streaming modes (STREAM construction).
+// This header is not part of the public API.
+
+#include "native_crypto.h" // For NC_SEGMENT_NONCE_PREFIX_LEN
+#include <stddef.h>         // For size_t
+#include <stdint.h>         // For uint8_t
+#include <string.h>         // For memcpy
+
+// Size of the authentication tag appended to every segment.
+#define SEGMENT_TAG_LEN 16
+// Largest accepted segment, so per-segment lengths always fit the int returned by nc_aead_seal().
+#define MAX_SEGMENT_SIZE ((size_t)1 << 30)
+// The segment index is encoded in 32 bits of the nonce.
+#define MAX_SEGMENTS ((size_t)0xFFFFFFFFu)
+
+/**
+ * @brief Builds the nonce of one segment: prefix || big-endian index || last-segment flag.
+ */
+static inline void build_segment_nonce(uint8_t nonce[12], const uint8_t* prefix, size_t index, int is_last) {
+    memcpy(nonce, prefix, NC_SEGMENT_NONCE_PREFIX_LEN);
+    nonce[7] = (uint8_t)(index >> 24);
+    nonce[8] = (uint8_t)(index >> 16);
+    nonce[9] = (uint8_t)(index >> 8);
+    nonce[10] = (uint8_t)index;
+    nonce[11] = is_last ? 1 : 0;
+}
+
+/**
+ * @brief Returns the number of segments for a plaintext (an empty plaintext still has one).
+ */
+static inline size_t segment_count(size_t plaintext_len, size_t segment_size) {
+    if (plaintext_len == 0) return 1;
+    return plaintext_len / segment_size + (plaintext_len % segment_size != 0);
+}
+
+#endif // NATIVE_CRYPTO_SEGMENT_H
@@ -0,0 +1,205 @@
+#include "native_crypto.h" // Public API (handle-based seal/open used for every segment)
+#include "errors.h"        // Internal failure recording
+#include "segment.h"       // Segment layout shared with the parallel mode
+#include <openssl/mem.h>    // For OPENSSL_cleanse
+#include <stdlib.h>         // For malloc, calloc, free
+#include <string.h>         // For memcpy
+
+// Lifecycle states of a stream.
+#define STREAM_ACTIVE 0
+#define STREAM_FINISHED 1
+#define STREAM_FAILED 2
+
+/**
+ * @brief Internal layout of the opaque nc_stream handle.
+ *
+ * The stream buffers at most one input block: a plaintext segment when sealing, or a
+ * segment plus its tag when opening. A full block is only processed once more input
+ * arrives, because the last segment has to be sealed with the last-segment flag set.
+ */
+struct nc_stream {
+    const nc_aead_ctx* ctx;                            // Context shared with the caller.
+    int is_seal;                                       // 1 for seal, 0 for open.
+    int state;                                         // One of the STREAM_* states.
+    uint8_t nonce_prefix[NC_SEGMENT_NONCE_PREFIX_LEN]; // Copy of the nonce prefix.
+    size_t segment_size;                               // Plaintext bytes per segment.
+    size_t block_size;                                 // Input bytes per segment (with the tag when opening).
+    size_t next_index;                                 // Index of the next segment to process.
+    uint8_t* aad;                                      // Copy of the AAD (or NULL).
+    size_t aad_len;
+    uint8_t* buffer;                                   // Partial input block.
+    size_t buffered;                                   // Bytes currently in buffer.
+};
+
+/**
+ * @brief Shared implementation of nc_stream_seal_new() and nc_stream_open_new().
+ */
+static nc_stream* stream_new(const nc_aead_ctx* ctx, int is_seal, const uint8_t* nonce_prefix,
+                             const uint8_t* aad, size_t aad_len, size_t segment_size) {
+    nc_stream* stream;
+
+    // --- Parameter Validation ---
+    if (!ctx || !nonce_prefix || (!aad && aad_len > 0)) return NULL;
+    if (segment_size == 0) segment_size = NC_DEFAULT_SEGMENT_SIZE;
+    if (segment_size > MAX_SEGMENT_SIZE) return NULL;
+
+    stream = (nc_stream*)calloc(1, sizeof(nc_stream));
+    if (!stream) return NULL;
+    stream->ctx = ctx;
+    stream->is_seal = is_seal;
+    stream->state = STREAM_ACTIVE;
+    memcpy(stream->nonce_prefix, nonce_prefix, NC_SEGMENT_NONCE_PREFIX_LEN);
+    stream->segment_size = segment_size;
+    stream->block_size = is_seal ? segment_size : segment_size + SEGMENT_TAG_LEN;
+
+    stream->buffer = (uint8_t*)malloc(stream->block_size);
+    if (aad_len > 0) {
+        stream->aad = (uint8_t*)malloc(aad_len);
+        if (stream->aad) memcpy(stream->aad, aad, aad_len);
+        stream->aad_len = aad_len;
+    }
+    if (!stream->buffer || (aad_len > 0 && !stream->aad)) {
+        nc_stream_free(stream);
+        return NULL;
+    }
+    return stream;
+}
+
+nc_stream* nc_stream_seal_new(
+        const nc_aead_ctx* ctx,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size
+) {
+    return stream_new(ctx, 1, nonce_prefix, aad, aad_len, segment_size);
+}
+
+nc_stream* nc_stream_open_new(
+        const nc_aead_ctx* ctx,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size
+) {
+    return stream_new(ctx, 0, nonce_prefix, aad, aad_len, segment_size);
+}
+
+/**
+ * @brief Seals or opens one segment and advances the segment index.
+ *
+ * @return The number of bytes written to out, or a negative error code.
+ */
+static int process_segment(nc_stream* stream, const uint8_t* in, size_t in_len, int is_last, uint8_t* out) {
+    uint8_t nonce[12];
+
+    // Same limit as nc_parallel_open() and nc_file_open(): at most MAX_SEGMENTS segments, indices
+    // 0 to MAX_SEGMENTS - 1. With a 32-bit size_t this also stops next_index from wrapping to 0.
+    if (stream->next_index >= MAX_SEGMENTS) return NC_ERR_INVALID_ARGUMENT;
+    build_segment_nonce(nonce, stream->nonce_prefix, stream->next_index, is_last);
+    stream->next_index++;
+    if (stream->is_seal) {
+        return nc_aead_seal(stream->ctx, in, in_len, nonce, sizeof(nonce),
+                            stream->aad, stream->aad_len, out);
+    }
+    return nc_aead_open(stream->ctx, in, in_len, nonce, sizeof(nonce),
+                        stream->aad, stream->aad_len, out);
+}
+
+size_t nc_stream_max_output(const nc_stream* stream, size_t in_len) {
+    size_t total;
+    size_t out_per_block;
+
+    if (!stream) return 0;
+    total = stream->buffered + in_len;
+    if (total == 0) return 0;
+    // Every block except the (possibly complete) final one can be emitted by update.
+    out_per_block = stream->is_seal ? stream->block_size + SEGMENT_TAG_LEN : stream->segment_size;
+    return ((total - 1) / stream->block_size) * out_per_block;
+}
+
+int nc_stream_update(nc_stream* stream, const uint8_t* in, size_t in_len, uint8_t* out, size_t* out_len) {
+    size_t written = 0;
+    int result;
+
+    // --- Parameter Validation ---
+    if (!stream || !out_len || (!in && in_len > 0) || (!out && in_len > 0)) return NC_ERR_INVALID_ARGUMENT;
+    if (stream->state != STREAM_ACTIVE) return NC_ERR_INVALID_ARGUMENT;
+    *out_len = 0;
+
+    while (in_len > 0) {
+        size_t take;
+
+        // A full buffered block followed by more input cannot be the last segment.
+        if (stream->buffered == stream->block_size) {
+            result = process_segment(stream, stream->buffer, stream->block_size, 0, out + written);
+            if (result < 0) goto fail;
+            written += (size_t)result;
+            stream->buffered = 0;
+        }
+
+        // Whole blocks that are followed by more input are processed straight from the
+        // caller's buffer, without copying them into the stream.
+        if (stream->buffered == 0 && in_len > stream->block_size) {
+            result = process_segment(stream, in, stream->block_size, 0, out + written);
+            if (result < 0) goto fail;
+            written += (size_t)result;
+            in += stream->block_size;
+            in_len -= stream->block_size;
+            continue;
+        }
+
+        take = stream->block_size - stream->buffered;
+        if (take > in_len) take = in_len;
+        memcpy(stream->buffer + stream->buffered, in, take);
+        stream->buffered += take;
+        in += take;
+        in_len -= take;
+    }
+
+    *out_len = written;
+    return 0;
+
+    fail:
+    stream->state = STREAM_FAILED;
+    *out_len = 0;
+    return result;
+}
+
+int nc_stream_final(nc_stream* stream, uint8_t* out, size_t* out_len) {
+    int result;
+
+    // --- Parameter Validation ---
+    if (!stream || !out || !out_len) return NC_ERR_INVALID_ARGUMENT;
+    if (stream->state != STREAM_ACTIVE) return NC_ERR_INVALID_ARGUMENT;
+    *out_len = 0;
+
+    // When opening, the last segment must hold a tag, and only a single-segment
+    // message may have an empty last segment.
+    if (!stream->is_seal &&
+        (stream->buffered < SEGMENT_TAG_LEN ||
+         (stream->buffered == SEGMENT_TAG_LEN && stream->next_index > 0))) {
+        stream->state = STREAM_FAILED;
+        nc_error_record(NC_FAILURE_OPEN, "last segment shorter than the tag (stream)");
+        return NC_ERR_AUTHENTICATION;
+    }
+
+    result = process_segment(stream, stream->buffer, stream->buffered, 1, out);
+    OPENSSL_cleanse(stream->buffer, stream->buffered);
+    stream->buffered = 0;
+    if (result < 0) {
+        stream->state = STREAM_FAILED;
+        return result;
+    }
+    stream->state = STREAM_FINISHED;
+    *out_len = (size_t)result;
+    return 0;
+}
+
+void nc_stream_free(nc_stream* stream) {
+    if (!stream) return;
+    if (stream->buffer) {
+        OPENSSL_cleanse(stream->buffer, stream->block_size);
+        free(stream->buffer);
+    }
+    free(stream->aad);
+    free(stream);
+}
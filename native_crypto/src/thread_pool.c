@@ -0,0 +1,209 @@
+#include "thread_pool.h"
+
+#include <stdlib.h> // For malloc, free
+
+#ifndef _WIN32
+#include <pthread.h> // For worker threads, mutexes and condition variables
+#include <unistd.h>  // For sysconf
+#else
+#include <windows.h> // For GetSystemInfo
+#endif
+
+size_t nc_online_cpu_count(void) {
+#ifndef _WIN32
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (size_t)count : 1;
+#else
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1;
+#endif
+}
+
+#ifndef _WIN32
+
+/**
+ * @brief A group of tasks submitted by one nc_thread_pool_run() call.
+ *
+ * Batches live on the submitting thread's stack and are linked into the pool's
+ * FIFO queue until every task index has been claimed by a worker.
+ */
+typedef struct nc_batch {
+    nc_task_fn fn;         // Work function.
+    void* arg;             // Shared argument for every task.
+    size_t count;          // Total number of tasks.
+    size_t next_index;     // Next task index to hand out (guarded by the pool mutex).
+    size_t remaining;      // Tasks not yet finished (guarded by the pool mutex).
+    struct nc_batch* next; // Next batch in the queue.
+} nc_batch;
+
+struct nc_thread_pool {
+    pthread_mutex_t mutex;     // Guards the queue and every batch's counters.
+    pthread_cond_t work_cond;  // Signalled when a batch is queued or the pool stops.
+    pthread_cond_t done_cond;  // Broadcast when any batch finishes.
+    nc_batch* head;            // Oldest batch that still has unclaimed tasks.
+    nc_batch* tail;            // Newest batch in the queue.
+    int stopping;              // Set by nc_thread_pool_destroy().
+    size_t num_threads;        // Number of started workers.
+    pthread_t* threads;        // Worker thread handles.
+};
+
+/**
+ * @brief Worker loop: claims one task at a time from the oldest batch and runs it.
+ */
+static void* worker_main(void* opaque) {
+    nc_thread_pool* pool = (nc_thread_pool*)opaque;
+
+    pthread_mutex_lock(&pool->mutex);
+    for (;;) {
+        nc_batch* batch;
+        size_t index;
+
+        while (!pool->head && !pool->stopping) {
+            pthread_cond_wait(&pool->work_cond, &pool->mutex);
+        }
+        if (!pool->head) break; // Stopping and nothing left to do.
+
+        // Claim the next task; unlink the batch once its last index is handed out.
+        batch = pool->head;
+        index = batch->next_index++;
+        if (batch->next_index == batch->count) {
+            pool->head = batch->next;
+            if (!pool->head) pool->tail = NULL;
+        }
+        pthread_mutex_unlock(&pool->mutex);
+
+        batch->fn(batch->arg, index);
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--batch->remaining == 0) {
+            pthread_cond_broadcast(&pool->done_cond);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+nc_thread_pool* nc_thread_pool_create(size_t num_threads) {
+    nc_thread_pool* pool;
+
+    if (num_threads == 0) return NULL;
+    pool = (nc_thread_pool*)calloc(1, sizeof(nc_thread_pool));
+    if (!pool) return NULL;
+    pool->threads = (pthread_t*)calloc(num_threads, sizeof(pthread_t));
+    if (!pool->threads) {
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+
+    // Start as many workers as possible; a partially started pool is still usable.
+    for (pool->num_threads = 0; pool->num_threads < num_threads; pool->num_threads++) {
+        if (pthread_create(&pool->threads[pool->num_threads], NULL, worker_main, pool) != 0) break;
+    }
+    if (pool->num_threads == 0) {
+        nc_thread_pool_destroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void nc_thread_pool_destroy(nc_thread_pool* pool) {
+    size_t i;
+
+    if (!pool) return;
+    pthread_mutex_lock(&pool->mutex);
+    pool->stopping = 1;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (i = 0; i < pool->num_threads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_mutex_destroy(&pool->mutex);
+    free(pool->threads);
+    free(pool);
+}
+
+size_t nc_thread_pool_size(const nc_thread_pool* pool) {
+    return pool ? pool->num_threads : 0;
+}
+
+void nc_thread_pool_run(nc_thread_pool* pool, nc_task_fn fn, void* arg, size_t count) {
+    nc_batch batch;
+    size_t i;
+
+    if (count == 0) return;
+    // Without a pool (or for a single task) the handoff would only add latency.
+    if (!pool || count == 1) {
+        for (i = 0; i < count; i++) fn(arg, i);
+        return;
+    }
+
+    batch.fn = fn;
+    batch.arg = arg;
+    batch.count = count;
+    batch.next_index = 0;
+    batch.remaining = count;
+    batch.next = NULL;
+
+    pthread_mutex_lock(&pool->mutex);
+    if (pool->tail) {
+        pool->tail->next = &batch;
+    } else {
+        pool->head = &batch;
+    }
+    pool->tail = &batch;
+    pthread_cond_broadcast(&pool->work_cond);
+
+    while (batch.remaining > 0) {
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+static nc_thread_pool* g_shared_pool = NULL;
+static pthread_once_t g_shared_pool_once = PTHREAD_ONCE_INIT;
+
+static void create_shared_pool(void) {
+    g_shared_pool = nc_thread_pool_create(nc_online_cpu_count());
+}
+
+nc_thread_pool* nc_shared_thread_pool(void) {
+    pthread_once(&g_shared_pool_once, create_shared_pool);
+    return g_shared_pool;
+}
+
+#else // _WIN32
+
+// Windows builds run the parallel modes serially on the calling thread.
+
+nc_thread_pool* nc_thread_pool_create(size_t num_threads) {
+    (void)num_threads;
+    return NULL;
+}
+
+void nc_thread_pool_destroy(nc_thread_pool* pool) {
+    (void)pool;
+}
+
+size_t nc_thread_pool_size(const nc_thread_pool* pool) {
+    (void)pool;
+    return 0;
+}
+
+void nc_thread_pool_run(nc_thread_pool* pool, nc_task_fn fn, void* arg, size_t count) {
+    size_t i;
+    (void)pool;
+    for (i = 0; i < count; i++) fn(arg, i);
+}
+
+nc_thread_pool* nc_shared_thread_pool(void) {
+    return NULL;
+}
+
+#endif // _WIN32
@@ -0,0 +1,60 @@
+#ifndef NATIVE_CRYPTO_THREAD_POOL_H
+#define NATIVE_CRYPTO_THREAD_POOL_H
+
+#include <stddef.h> // For size_t
+
+// Internal worker pool used by the parallel (multi-threaded) modes of native_crypto.
+// This header is not part of the public API.
+
+/**
+ * @brief Work function executed by the pool.
+ *
+ * @param arg The shared argument passed to nc_thread_pool_run().
+ * @param index Index of the task in the range [0, count).
+ */
+typedef void (*nc_task_fn)(void* arg, size_t index);
+
+/** @brief Opaque fixed-size pool of worker threads. */
+typedef struct nc_thread_pool nc_thread_pool;
+
+/**
+ * @brief Starts a pool with the given number of worker threads.
+ *
+ * @param num_threads Number of workers (at least 1).
+ * @return The pool, or NULL if no worker could be started.
+ */
+nc_thread_pool* nc_thread_pool_create(size_t num_threads);
+
+/**
+ * @brief Stops all workers and releases the pool. Pending work is completed first.
+ *
+ * @param pool Pool returned by nc_thread_pool_create(). NULL is ignored.
+ */
+void nc_thread_pool_destroy(nc_thread_pool* pool);
+
+/**
+ * @brief Returns the number of worker threads in the pool.
+ */
+size_t nc_thread_pool_size(const nc_thread_pool* pool);
+
+/**
+ * @brief Runs fn(arg, i) for every i in [0, count) on the workers and waits for all of them.
+ *
+ * Several threads may call this concurrently on the same pool; their tasks are queued in order.
+ * If pool is NULL the tasks are run on the calling thread.
+ */
+void nc_thread_pool_run(nc_thread_pool* pool, nc_task_fn fn, void* arg, size_t count);
+
+/**
+ * @brief Returns the process-wide pool, created on first use with one worker per online CPU.
+ *
+ * @return The shared pool, or NULL if threads are unavailable (callers then run serially).
+ */
+nc_thread_pool* nc_shared_thread_pool(void);
+
+/**
+ * @brief Returns the number of online CPUs (at least 1).
+ */
+size_t nc_online_cpu_count(void);
+
+#endif // NATIVE_CRYPTO_THREAD_POOL_H
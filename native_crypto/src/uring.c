@@ -0,0 +1,623 @@
+#define _GNU_SOURCE            // For syscall
+#define _FILE_OFFSET_BITS 64   // 64-bit file offsets on 32-bit Linux
+
+#include "native_crypto.h" // Public API (handle-based seal/open used for every segment)
+#include <stdint.h>         // For uint64_t
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <sys/syscall.h>    // For __NR_io_uring_*
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define HAVE_IO_URING 1
+#endif
+#endif
+#endif
+
+#ifdef HAVE_IO_URING
+#include "file_io.h"        // Input/output file pair shared with the mmap engine
+#include "segment.h"        // Segment layout shared with the parallel and streaming modes
+#include "thread_pool.h"    // Internal worker pool
+#include <errno.h>          // For EINTR, EAGAIN, EBUSY
+#include <linux/io_uring.h> // For the io_uring ABI (liburing is not required)
+#include <stdlib.h>         // For calloc, free, posix_memalign
+#include <string.h>         // For memset
+#include <sys/mman.h>       // For mmap, munmap
+#include <sys/uio.h>        // For struct iovec
+#include <unistd.h>         // For syscall, close
+
+// --- Ring ---
+// A minimal io_uring wrapper over the raw system calls. Only the calling thread touches the
+// ring; worker threads only run the crypto between a read completion and the matching write.
+
+/**
+ * @brief Mapped submission and completion queues of one ring.
+ */
+typedef struct {
+    int fd;
+    unsigned entries;
+    void* sq_ring;
+    size_t sq_ring_size;
+    void* cq_ring;
+    size_t cq_ring_size;
+    struct io_uring_sqe* sqes;
+    size_t sqes_size;
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    struct io_uring_cqe* cqes;
+    unsigned to_submit; // SQEs queued but not yet passed to io_uring_enter.
+} uring;
+
+static void uring_exit(uring* ring) {
+    if (ring->sqes) munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring && ring->cq_ring != ring->sq_ring) munmap(ring->cq_ring, ring->cq_ring_size);
+    if (ring->sq_ring) munmap(ring->sq_ring, ring->sq_ring_size);
+    if (ring->fd >= 0) close(ring->fd);
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+}
+
+/**
+ * @brief Creates a ring with room for `entries` submissions and maps its queues.
+ *
+ * @return 0 on success, or NC_ERR_UNSUPPORTED if io_uring is unavailable (old kernel, seccomp).
+ */
+static int uring_init(uring* ring, unsigned entries) {
+    struct io_uring_params params;
+    uint8_t* sq;
+    uint8_t* cq;
+
+    memset(ring, 0, sizeof(*ring));
+    memset(&params, 0, sizeof(params));
+    ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->fd < 0) return NC_ERR_UNSUPPORTED;
+    ring->entries = params.sq_entries;
+
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        // Both queues share one mapping on kernels that support it.
+        if (ring->cq_ring_size > ring->sq_ring_size) ring->sq_ring_size = ring->cq_ring_size;
+        ring->cq_ring_size = ring->sq_ring_size;
+    }
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring->fd, IORING_OFF_SQ_RING);
+    if (ring->sq_ring == MAP_FAILED) {
+        ring->sq_ring = NULL;
+        goto fail;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_ring = ring->sq_ring;
+    } else {
+        ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             ring->fd, IORING_OFF_CQ_RING);
+        if (ring->cq_ring == MAP_FAILED) {
+            ring->cq_ring = NULL;
+            goto fail;
+        }
+    }
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = (struct io_uring_sqe*)mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        ring->sqes = NULL;
+        goto fail;
+    }
+
+    sq = (uint8_t*)ring->sq_ring;
+    cq = (uint8_t*)ring->cq_ring;
+    ring->sq_head = (unsigned*)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned*)(sq + params.sq_off.tail);
+    ring->sq_mask = (unsigned*)(sq + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned*)(sq + params.sq_off.array);
+    ring->cq_head = (unsigned*)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned*)(cq + params.cq_off.tail);
+    ring->cq_mask = (unsigned*)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+    return 0;
+
+    fail:
+    uring_exit(ring);
+    return NC_ERR_UNSUPPORTED;
+}
+
+/**
+ * @brief Returns a cleared SQE to fill in, or NULL if the submission queue is full.
+ *
+ * uring_queue_sqe() publishes the entry; uring_enter() then submits it.
+ */
+static struct io_uring_sqe* uring_get_sqe(uring* ring) {
+    unsigned tail = *ring->sq_tail; // Only this thread writes the tail.
+    unsigned head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    unsigned index;
+    struct io_uring_sqe* sqe;
+
+    if (tail - head >= ring->entries) return NULL;
+    index = tail & *ring->sq_mask;
+    sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    ring->sq_array[index] = index;
+    return sqe;
+}
+
+static void uring_queue_sqe(uring* ring) {
+    __atomic_store_n(ring->sq_tail, *ring->sq_tail + 1, __ATOMIC_RELEASE);
+    ring->to_submit++;
+}
+
+/**
+ * @brief Submits the queued SQEs and waits for at least min_complete completions.
+ *
+ * @return 0 on success, or NC_ERR_IO.
+ */
+static int uring_enter(uring* ring, unsigned min_complete) {
+    for (;;) {
+        long submitted = syscall(__NR_io_uring_enter, ring->fd, ring->to_submit, min_complete,
+                                 min_complete ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+        if (submitted >= 0) {
+            ring->to_submit -= (unsigned)submitted;
+            return 0;
+        }
+        // Interrupted, or the completion queue needs reaping first: the caller retries later.
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EBUSY) return 0;
+        return NC_ERR_IO;
+    }
+}
+
+// --- Engine ---
+
+// user_data of the IORING_OP_ASYNC_CANCEL request (slot indices are always smaller).
+#define CANCEL_USER_DATA UINT64_MAX
+
+// Slot states: each slot holds one segment on its way through read -> crypto -> write.
+#define SLOT_IDLE 0
+#define SLOT_READING 1
+#define SLOT_READY 2 // Read complete, waiting for the crypto.
+#define SLOT_WRITING 3
+
+/**
+ * @brief One queue-depth slot with its (registered) buffer.
+ */
+typedef struct {
+    uint8_t* buf;      // segment_size + SEGMENT_TAG_LEN bytes; the crypto runs in place.
+    struct iovec iov;  // Used for READV/WRITEV when the buffers could not be registered.
+    size_t segment;    // Index of the segment in the slot.
+    size_t len;        // Bytes to read, then bytes to write.
+    size_t done;       // Bytes transferred so far by the current operation.
+    int state;         // One of the SLOT_* states.
+    int status;        // Crypto result: bytes written, or a negative error code.
+} uring_slot;
+
+/**
+ * @brief State of one io_uring seal or open.
+ */
+typedef struct {
+    uring ring;
+    nc_file_pair pair;
+    uring_slot* slots;
+    size_t num_slots;
+    uint8_t* buffers;       // One allocation backing every slot buffer.
+    int fixed;              // 1 if the buffers are registered (READ_FIXED/WRITE_FIXED).
+    size_t inflight;        // Reads and writes submitted but not completed.
+    size_t* ready;          // Indices of SLOT_READY slots.
+    size_t ready_count;
+    // Crypto parameters.
+    const nc_aead_ctx* ctx;
+    int is_seal;
+    const uint8_t* nonce_prefix;
+    const uint8_t* aad;
+    size_t aad_len;
+    size_t num_tasks;       // Worker tasks of the current crypto batch.
+} uring_engine;
+
+static size_t in_stride(const uring_engine* engine) {
+    return engine->is_seal ? engine->pair.segment_size : engine->pair.segment_size + SEGMENT_TAG_LEN;
+}
+
+static size_t out_stride(const uring_engine* engine) {
+    return engine->is_seal ? engine->pair.segment_size + SEGMENT_TAG_LEN : engine->pair.segment_size;
+}
+
+/**
+ * @brief Queues the remaining part of the slot's read or write.
+ */
+static void queue_transfer(uring_engine* engine, size_t index) {
+    uring_slot* slot = &engine->slots[index];
+    int is_read = slot->state == SLOT_READING;
+    size_t stride = is_read ? in_stride(engine) : out_stride(engine);
+    // Every slot has at most one operation in flight, so the queue (>= num_slots) is never full.
+    struct io_uring_sqe* sqe = uring_get_sqe(&engine->ring);
+
+    sqe->fd = is_read ? engine->pair.in_fd : engine->pair.out_fd;
+    sqe->off = (uint64_t)slot->segment * stride + slot->done;
+    sqe->user_data = index;
+    if (engine->fixed) {
+        sqe->opcode = is_read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+        sqe->addr = (uint64_t)(uintptr_t)(slot->buf + slot->done);
+        sqe->len = (unsigned)(slot->len - slot->done);
+        sqe->buf_index = (uint16_t)index;
+    } else {
+        sqe->opcode = is_read ? IORING_OP_READV : IORING_OP_WRITEV;
+        slot->iov.iov_base = slot->buf + slot->done;
+        slot->iov.iov_len = slot->len - slot->done;
+        sqe->addr = (uint64_t)(uintptr_t)&slot->iov;
+        sqe->len = 1;
+    }
+    uring_queue_sqe(&engine->ring);
+    engine->inflight++;
+}
+
+/**
+ * @brief Starts reading a segment into a slot (an empty segment is ready at once).
+ */
+static void start_read(uring_engine* engine, size_t index, size_t segment) {
+    uring_slot* slot = &engine->slots[index];
+    size_t offset = segment * in_stride(engine);
+
+    slot->segment = segment;
+    slot->len = segment + 1 == engine->pair.num_segments ? engine->pair.in_len - offset : in_stride(engine);
+    slot->done = 0;
+    if (slot->len == 0) {
+        slot->state = SLOT_READY;
+        engine->ready[engine->ready_count++] = index;
+        return;
+    }
+    slot->state = SLOT_READING;
+    queue_transfer(engine, index);
+}
+
+/**
+ * @brief Starts reading the next segments into every idle slot.
+ */
+static void refill_slots(uring_engine* engine, size_t* next_segment) {
+    size_t i;
+
+    for (i = 0; i < engine->num_slots && *next_segment < engine->pair.num_segments; i++) {
+        if (engine->slots[i].state == SLOT_IDLE) start_read(engine, i, (*next_segment)++);
+    }
+}
+
+/**
+ * @brief Pool task: seals or opens a contiguous range of the ready slots in place.
+ */
+static void crypto_task(void* arg, size_t task) {
+    uring_engine* engine = (uring_engine*)arg;
+    size_t first = task * engine->ready_count / engine->num_tasks;
+    size_t last = (task + 1) * engine->ready_count / engine->num_tasks;
+    size_t i;
+
+    for (i = first; i < last; i++) {
+        uring_slot* slot = &engine->slots[engine->ready[i]];
+        int is_last = slot->segment + 1 == engine->pair.num_segments;
+        uint8_t nonce[12];
+
+        build_segment_nonce(nonce, engine->nonce_prefix, slot->segment, is_last);
+        slot->status = engine->is_seal
+                       ? nc_aead_seal(engine->ctx, slot->buf, slot->len, nonce, sizeof(nonce),
+                                      engine->aad, engine->aad_len, slot->buf)
+                       : nc_aead_open(engine->ctx, slot->buf, slot->len, nonce, sizeof(nonce),
+                                      engine->aad, engine->aad_len, slot->buf);
+    }
+}
+
+/**
+ * @brief Runs the crypto for every ready slot on the workers, then starts their writes.
+ *
+ * @return The number of segments completed without a write (empty outputs), or a negative error code.
+ */
+static long process_ready(uring_engine* engine, nc_thread_pool* pool, size_t num_threads) {
+    long completed = 0;
+    int result = 0;
+    size_t i;
+
+    engine->num_tasks = num_threads < engine->ready_count ? num_threads : engine->ready_count;
+    nc_thread_pool_run(pool, crypto_task, engine, engine->num_tasks);
+
+    for (i = 0; i < engine->ready_count; i++) {
+        size_t index = engine->ready[i];
+        uring_slot* slot = &engine->slots[index];
+
+        if (slot->status < 0) {
+            if (result == 0) result = slot->status;
+            slot->state = SLOT_IDLE;
+            continue;
+        }
+        slot->len = (size_t)slot->status;
+        slot->done = 0;
+        if (slot->len == 0) {
+            slot->state = SLOT_IDLE;
+            completed++;
+            continue;
+        }
+        slot->state = SLOT_WRITING;
+        queue_transfer(engine, index);
+    }
+    engine->ready_count = 0;
+    return result < 0 ? result : completed;
+}
+
+/**
+ * @brief Allocates the slot buffers and registers them with the ring when the kernel allows it.
+ */
+static int setup_slots(uring_engine* engine, size_t queue_depth) {
+    size_t buf_size = engine->pair.segment_size + SEGMENT_TAG_LEN;
+    struct iovec* iovs;
+    size_t i;
+
+    // Page-aligned buffers keep every transfer page-aligned in the file and in memory.
+    buf_size = (buf_size + 4095) & ~(size_t)4095;
+    engine->num_slots = queue_depth < engine->pair.num_segments ? queue_depth : engine->pair.num_segments;
+    engine->slots = (uring_slot*)calloc(engine->num_slots, sizeof(uring_slot));
+    engine->ready = (size_t*)calloc(engine->num_slots, sizeof(size_t));
+    if (!engine->slots || !engine->ready) return NC_ERR_INVALID_ARGUMENT;
+    if (buf_size > SIZE_MAX / engine->num_slots ||
+        posix_memalign((void**)&engine->buffers, 4096, buf_size * engine->num_slots) != 0) {
+        engine->buffers = NULL;
+        return NC_ERR_INVALID_ARGUMENT;
+    }
+
+    iovs = (struct iovec*)calloc(engine->num_slots, sizeof(struct iovec));
+    if (!iovs) return NC_ERR_INVALID_ARGUMENT;
+    for (i = 0; i < engine->num_slots; i++) {
+        engine->slots[i].buf = engine->buffers + i * buf_size;
+        iovs[i].iov_base = engine->slots[i].buf;
+        iovs[i].iov_len = buf_size;
+    }
+    // Registration pins the buffers, which counts against RLIMIT_MEMLOCK on older kernels; without
+    // it the engine falls back to plain vectored reads and writes.
+    engine->fixed = syscall(__NR_io_uring_register, engine->ring.fd, IORING_REGISTER_BUFFERS,
+                            iovs, (unsigned)engine->num_slots) == 0;
+    free(iovs);
+    return 0;
+}
+
+/**
+ * @brief Handles one completion: advances the slot's read or write, or records an error.
+ *
+ * @return 1 if a segment was fully written, 0 otherwise, or a negative error code.
+ */
+static int handle_completion(uring_engine* engine, const struct io_uring_cqe* cqe) {
+    size_t index = (size_t)cqe->user_data;
+    uring_slot* slot = &engine->slots[index];
+
+    engine->inflight--;
+    if (cqe->res == -EINTR || cqe->res == -EAGAIN) {
+        queue_transfer(engine, index); // Retry the same range.
+        return 0;
+    }
+    if (cqe->res <= 0) {
+        // An error, or an unexpected end of file (the input shrank while it was being read).
+        slot->state = SLOT_IDLE;
+        return NC_ERR_IO;
+    }
+    slot->done += (size_t)cqe->res;
+    if (slot->done < slot->len) {
+        queue_transfer(engine, index); // Short transfer: continue where it stopped.
+        return 0;
+    }
+    if (slot->state == SLOT_READING) {
+        slot->state = SLOT_READY;
+        engine->ready[engine->ready_count++] = index;
+        return 0;
+    }
+    slot->state = SLOT_IDLE;
+    return 1;
+}
+
+/**
+ * @brief After a failed io_uring_enter, waits until the kernel no longer owns any slot buffer.
+ *
+ * SQEs that were queued but never submitted are dropped. In-flight reads and writes are asked to
+ * cancel (regular file I/O usually just runs to completion) and their completions are reaped
+ * without retrying anything.
+ *
+ * @return 0 once nothing is in flight, or NC_ERR_IO if the ring stopped responding.
+ */
+static int drain_inflight(uring_engine* engine) {
+    uring* ring = &engine->ring;
+    int attempts = 0;
+
+    // The kernel has not consumed the unsubmitted entries, so the tail can take them back.
+    __atomic_store_n(ring->sq_tail, *ring->sq_tail - ring->to_submit, __ATOMIC_RELEASE);
+    engine->inflight -= ring->to_submit;
+    ring->to_submit = 0;
+    if (engine->inflight == 0) return 0;
+#ifdef IORING_ASYNC_CANCEL_ANY
+    {
+        // Kernels before 5.19 reject the flag; the loop below then just waits.
+        struct io_uring_sqe* sqe = uring_get_sqe(ring);
+
+        if (sqe) {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+            sqe->user_data = CANCEL_USER_DATA;
+            uring_queue_sqe(ring);
+        }
+    }
+#endif
+    while (engine->inflight > 0) {
+        unsigned head;
+        unsigned tail;
+
+        // A ring that keeps failing gives no guarantee the kernel is done with the buffers.
+        if (uring_enter(ring, 1) < 0 && ++attempts > 3) return NC_ERR_IO;
+        head = *ring->cq_head;
+        tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; head++) {
+            const struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_mask];
+
+            if (cqe->user_data == CANCEL_USER_DATA) continue;
+            engine->slots[(size_t)cqe->user_data].state = SLOT_IDLE;
+            engine->inflight--;
+        }
+        __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    }
+    return 0;
+}
+
+/**
+ * @brief Shared implementation of nc_uring_file_seal() and nc_uring_file_open().
+ */
+static int uring_file_process(const nc_aead_ctx* ctx, int is_seal, const char* in_path, const char* out_path,
+                              const uint8_t* nonce_prefix, const uint8_t* aad, size_t aad_len,
+                              size_t segment_size, size_t queue_depth, size_t num_threads,
+                              uint64_t* out_len) {
+    uring_engine engine;
+    nc_thread_pool* pool = NULL;
+    size_t next_segment = 0;
+    size_t completed = 0;
+    size_t i;
+    int result;
+    int buffers_owned = 0; // Set when the kernel may still write into the slot buffers.
+
+    // --- Parameter Validation ---
+    if (!ctx || !in_path || !out_path || !nonce_prefix || (!aad && aad_len > 0)) {
+        return NC_ERR_INVALID_ARGUMENT;
+    }
+    if (queue_depth == 0) queue_depth = NC_URING_DEFAULT_QUEUE_DEPTH;
+    if (queue_depth > NC_URING_MAX_QUEUE_DEPTH) return NC_ERR_INVALID_ARGUMENT;
+    if (num_threads != 1) {
+        pool = nc_shared_thread_pool();
+        if (num_threads == 0) num_threads = pool ? nc_thread_pool_size(pool) : 1;
+    }
+
+    memset(&engine, 0, sizeof(engine));
+    engine.ctx = ctx;
+    engine.is_seal = is_seal;
+    engine.nonce_prefix = nonce_prefix;
+    engine.aad = aad;
+    engine.aad_len = aad_len;
+    result = uring_init(&engine.ring, (unsigned)queue_depth);
+    if (result < 0) return result;
+    result = nc_file_pair_open(&engine.pair, is_seal, in_path, out_path, segment_size);
+    if (result < 0) {
+        uring_exit(&engine.ring);
+        return result;
+    }
+    result = setup_slots(&engine, queue_depth);
+
+    // --- Pipeline: read -> crypto on the workers -> write, one segment per slot ---
+    while (completed < engine.pair.num_segments) {
+        // Idle slots (at the start, or after a write completed) take the next segments.
+        if (result == 0) refill_slots(&engine, &next_segment);
+
+        if (engine.ready_count > 0) {
+            if (result == 0) {
+                long written;
+                // Hand the queued reads to the kernel before the workers start encrypting.
+                if (engine.ring.to_submit > 0 && uring_enter(&engine.ring, 0) < 0) result = NC_ERR_IO;
+                written = process_ready(&engine, pool, num_threads);
+                if (written < 0) {
+                    result = (int)written;
+                } else {
+                    completed += (size_t)written;
+                }
+            } else {
+                // After a failure, completed reads are dropped instead of processed.
+                for (i = 0; i < engine.ready_count; i++) engine.slots[engine.ready[i]].state = SLOT_IDLE;
+                engine.ready_count = 0;
+            }
+        }
+        if (engine.inflight == 0) {
+            // Empty segments complete without any I/O; otherwise nothing is left to wait for.
+            if (result == 0 && (engine.ready_count > 0 || next_segment < engine.pair.num_segments)) continue;
+            break;
+        }
+
+        // Submit everything queued and wait for at least one completion.
+        if (uring_enter(&engine.ring, 1) < 0) {
+            // Closing the ring does not wait for in-flight requests, so they are reaped here first.
+            result = NC_ERR_IO;
+            buffers_owned = drain_inflight(&engine) < 0;
+            break;
+        }
+        {
+            unsigned head = *engine.ring.cq_head;
+            unsigned tail = __atomic_load_n(engine.ring.cq_tail, __ATOMIC_ACQUIRE);
+
+            for (; head != tail; head++) {
+                const struct io_uring_cqe* cqe = &engine.ring.cqes[head & *engine.ring.cq_mask];
+                int status = handle_completion(&engine, cqe);
+
+                if (status < 0 && result == 0) result = status;
+                if (status == 1) completed++;
+            }
+            __atomic_store_n(engine.ring.cq_head, head, __ATOMIC_RELEASE);
+        }
+    }
+    if (result == 0 && completed < engine.pair.num_segments) result = NC_ERR_IO;
+
+    // --- Cleanup ---
+    uring_exit(&engine.ring);
+    // Leaking the buffers is the only safe option if the kernel may still write into them.
+    if (!buffers_owned) free(engine.buffers);
+    free(engine.slots);
+    free(engine.ready);
+    result = nc_file_pair_close(&engine.pair, out_path, result);
+    if (result < 0) return result;
+    if (out_len) *out_len = (uint64_t)engine.pair.out_len;
+    return 0;
+}
+
+int nc_uring_available(void) {
+    static int available = -1; // Probed once; racing first calls store the same value.
+    int value = __atomic_load_n(&available, __ATOMIC_RELAXED);
+    uring ring;
+
+    if (value < 0) {
+        value = uring_init(&ring, 1) == 0;
+        if (value) uring_exit(&ring);
+        __atomic_store_n(&available, value, __ATOMIC_RELAXED);
+    }
+    return value;
+}
+
+#else // !HAVE_IO_URING
+
+int nc_uring_available(void) {
+    return 0;
+}
+
+#endif // HAVE_IO_URING
+
+int nc_uring_file_seal(
+        const nc_aead_ctx* ctx,
+        const char* in_path, const char* out_path,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size, size_t queue_depth, size_t num_threads,
+        uint64_t* out_len
+) {
+#ifdef HAVE_IO_URING
+    return uring_file_process(ctx, 1, in_path, out_path, nonce_prefix, aad, aad_len, segment_size,
+                              queue_depth, num_threads, out_len);
+#else
+    (void)ctx; (void)in_path; (void)out_path; (void)nonce_prefix; (void)aad; (void)aad_len;
+    (void)segment_size; (void)queue_depth; (void)num_threads; (void)out_len;
+    return NC_ERR_UNSUPPORTED;
+#endif
+}
+
+int nc_uring_file_open(
+        const nc_aead_ctx* ctx,
+        const char* in_path, const char* out_path,
+        const uint8_t* nonce_prefix,
+        const uint8_t* aad, size_t aad_len,
+        size_t segment_size, size_t queue_depth, size_t num_threads,
+        uint64_t* out_plaintext_len
+) {
+#ifdef HAVE_IO_URING
+    return uring_file_process(ctx, 0, in_path, out_path, nonce_prefix, aad, aad_len, segment_size,
+                              queue_depth, num_threads, out_plaintext_len);
+#else
+    (void)ctx; (void)in_path; (void)out_path; (void)nonce_prefix; (void)aad; (void)aad_len;
+    (void)segment_size; (void)queue_depth; (void)num_threads; (void)out_plaintext_len;
+    return NC_ERR_UNSUPPORTED;
+#endif
+}
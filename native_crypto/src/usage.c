@@ -0,0 +1,55 @@
+// RUSAGE_THREAD is a GNU extension of glibc.
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "native_crypto.h" // Public API (nc_thread_usage)
+#include <string.h>         // For memset
+
+#ifndef _WIN32
+#include <sys/resource.h> // For getrusage, RUSAGE_THREAD
+#include <time.h>         // For clock_gettime, CLOCK_THREAD_CPUTIME_ID
+#else
+#include <windows.h>      // For GetThreadTimes
+#endif
+
+uint64_t nc_thread_cpu_time_ns(void) {
+#ifndef _WIN32
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0;
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#else
+    FILETIME creation, exit, kernel, user;
+    ULARGE_INTEGER k, u;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) return 0;
+    k.LowPart = kernel.dwLowDateTime;
+    k.HighPart = kernel.dwHighDateTime;
+    u.LowPart = user.dwLowDateTime;
+    u.HighPart = user.dwHighDateTime;
+    // FILETIME counts 100 ns intervals.
+    return (k.QuadPart + u.QuadPart) * 100;
+#endif
+}
+
+int nc_thread_usage_get(nc_thread_usage* out_usage) {
+    // --- Parameter Validation ---
+    if (!out_usage) return NC_ERR_INVALID_ARGUMENT;
+
+    memset(out_usage, 0, sizeof(*out_usage));
+    out_usage->cpu_time_ns = nc_thread_cpu_time_ns();
+
+#if !defined(_WIN32) && defined(RUSAGE_THREAD)
+    {
+        struct rusage usage;
+        if (getrusage(RUSAGE_THREAD, &usage) != 0) return NC_ERR_UNSUPPORTED;
+        out_usage->minor_faults = (uint64_t)usage.ru_minflt;
+        out_usage->major_faults = (uint64_t)usage.ru_majflt;
+        out_usage->voluntary_switches = (uint64_t)usage.ru_nvcsw;
+        out_usage->involuntary_switches = (uint64_t)usage.ru_nivcsw;
+    }
+    return 0;
+#else
+    // No per-thread rusage (e.g. macOS, Windows): only the CPU time is available.
+    return NC_ERR_UNSUPPORTED;
+#endif
+}
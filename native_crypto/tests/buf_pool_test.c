@@ -0,0 +1,155 @@
+// Buffer pool checks for the behaviour nc_buf_* documents.
+//
+//   - every buffer is aligned to NC_BUF_ALIGNMENT and holds at least the requested size, plus an
+//     AEAD tag for power-of-two payloads,
+//   - a released pooled buffer is handed out again by the next acquire of its class on the thread,
+//   - buffers above NC_BUF_MAX_POOLED_SIZE bypass the free lists and can be acquired and released
+//     repeatedly,
+//   - nc_buf_release_wipe() clears the buffer before it goes back to the free list,
+//   - buffers may be released on a thread other than the one that acquired them,
+//   - releasing NULL does nothing.
+// Releasing a buffer twice is undefined behaviour and is deliberately not exercised.
+// Exits with 0 when every check passes; failures are printed to stderr.
+
+#include "native_crypto.h"
+
+#include <stdint.h> // For uintptr_t
+#include <stdio.h>  // For fprintf
+#include <string.h> // For memset
+
+#ifndef _WIN32
+#include <pthread.h> // For the cross-thread release
+#endif
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                                                      \
+    do {                                                                      \
+        if (!(cond)) {                                                        \
+            fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__);              \
+            fprintf(stderr, __VA_ARGS__);                                     \
+            fputc('\n', stderr);                                              \
+            failures++;                                                       \
+        }                                                                     \
+    } while (0)
+
+static const size_t kSizes[] = {0, 1, 64, 100, 4096, 65536, NC_BUF_MAX_POOLED_SIZE,
+                                NC_BUF_MAX_POOLED_SIZE + 1, (size_t)8 << 20};
+
+/**
+ * @brief Alignment, capacity and write access for every size.
+ */
+static void check_shape(void) {
+    size_t i;
+
+    for (i = 0; i < sizeof(kSizes) / sizeof(kSizes[0]); i++) {
+        size_t size = kSizes[i];
+        uint8_t* buf = (uint8_t*)nc_buf_acquire(size);
+
+        CHECK(buf != NULL, "acquire(%zu) failed", size);
+        if (!buf) continue;
+        CHECK(((uintptr_t)buf & (NC_BUF_ALIGNMENT - 1)) == 0, "acquire(%zu) is misaligned", size);
+        CHECK(nc_buf_capacity(buf) >= size, "capacity %zu < %zu", nc_buf_capacity(buf), size);
+        // A power-of-two payload and its tag fit the payload's own class.
+        if (size > 0 && (size & (size - 1)) == 0 && size <= NC_BUF_MAX_POOLED_SIZE) {
+            CHECK(nc_buf_capacity(buf) >= size + NC_AEAD_TAG_LEN, "no tag room for %zu", size);
+            void* with_tag = nc_buf_acquire(size + NC_AEAD_TAG_LEN);
+            CHECK(nc_buf_capacity(with_tag) == nc_buf_capacity(buf), "%zu + tag moved to a larger class",
+                  size);
+            nc_buf_release(with_tag);
+        }
+        memset(buf, 0xa5, size);
+        nc_buf_release(buf);
+    }
+}
+
+/**
+ * @brief A released pooled buffer is reused by the next acquire of the same class.
+ */
+static void check_reuse(void) {
+    void* first = nc_buf_acquire(4096);
+    void* second;
+
+    nc_buf_release(first);
+    second = nc_buf_acquire(4000); // Same class as 4096.
+    CHECK(second == first, "pooled buffer was not reused");
+    nc_buf_release(second);
+    nc_buf_pool_trim();
+}
+
+/**
+ * @brief A wiped release leaves zeros in the buffer the next acquire of its class returns.
+ */
+static void check_wipe(void) {
+    uint8_t* first = (uint8_t*)nc_buf_acquire(4096);
+    uint8_t* second;
+    size_t i;
+    int dirty = 0;
+
+    memset(first, 0xa5, 4096);
+    nc_buf_release_wipe(first, 4096);
+    second = (uint8_t*)nc_buf_acquire(4096);
+    CHECK(second == first, "wiped buffer was not reused");
+    for (i = 0; i < 4096; i++) dirty |= second[i];
+    CHECK(dirty == 0, "released buffer still holds its contents");
+    // A length beyond the capacity is capped instead of overrunning the block.
+    nc_buf_release_wipe(second, (size_t)1 << 30);
+    nc_buf_release_wipe((uint8_t*)nc_buf_acquire((size_t)8 << 20), (size_t)8 << 20);
+    nc_buf_release_wipe(NULL, 16);
+    nc_buf_pool_trim();
+}
+
+/**
+ * @brief Unpooled buffers go straight back to the allocator and can be cycled freely.
+ */
+static void check_unpooled(void) {
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        uint8_t* buf = (uint8_t*)nc_buf_acquire((size_t)8 << 20);
+        CHECK(buf != NULL, "unpooled acquire %d failed", i);
+        if (!buf) return;
+        buf[0] = 1;
+        buf[((size_t)8 << 20) - 1] = 1;
+        nc_buf_release(buf);
+    }
+}
+
+#ifndef _WIN32
+static void* release_on_thread(void* buf) {
+    nc_buf_release(buf);
+    return NULL;
+}
+
+/**
+ * @brief A buffer acquired here is released on another thread, which later exits.
+ */
+static void check_cross_thread(void) {
+    pthread_t thread;
+    void* buf = nc_buf_acquire(65536);
+
+    CHECK(buf != NULL, "acquire for cross-thread release failed");
+    if (!buf) return;
+    CHECK(pthread_create(&thread, NULL, release_on_thread, buf) == 0, "pthread_create failed");
+    pthread_join(thread, NULL);
+}
+#endif
+
+int main(void) {
+    nc_buf_release(NULL);
+    check_shape();
+    check_reuse();
+    check_wipe();
+    check_unpooled();
+#ifndef _WIN32
+    check_cross_thread();
+#endif
+    nc_buf_pool_trim();
+
+    if (failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("buf_pool_test: all checks passed\n");
+    return 0;
+}
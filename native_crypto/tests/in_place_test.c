@@ -0,0 +1,294 @@
+// In-place and overlap checks for every seal/open entry point that takes separate buffers.
+//
+// For each entry point and a few message sizes:
+//   - sealing and opening within one buffer round-trips,
+//   - an output shifted one byte against its input (a partial overlap) is refused,
+//   - an exact-size output placed directly before or after its input is accepted and produces
+//     the same bytes as the in-place call.
+// Exits with 0 when every check passes; failures are printed to stderr.
+
+#include "native_crypto.h"
+
+#include <stdio.h>  // For fprintf
+#include <stdlib.h> // For malloc, free
+#include <string.h> // For memcmp, memcpy
+
+// Seals len bytes of in into out; returns the bytes written or a negative error code.
+typedef int (*seal_fn)(int algorithm, const uint8_t* in, size_t len, uint8_t* out);
+// Opens len bytes (ciphertext + tag) of in into out; returns the plaintext bytes or a negative error code.
+typedef int (*open_fn)(int algorithm, const uint8_t* in, size_t len, uint8_t* out);
+
+/** @brief An entry point pair under test. */
+typedef struct {
+    const char* name;
+    seal_fn seal;
+    open_fn open;
+} entry_point;
+
+static const uint8_t kKey[32] = {0x4b, 0x65, 0x79};
+static const uint8_t kNonce[12] = {0x4e, 0x6f, 0x6e, 0x63, 0x65};
+static const size_t kSizes[] = {1, 100, 4096, 65537};
+
+// Handle context for the algorithm under test, set up in main.
+static nc_aead_ctx* g_ctx;
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                                                      \
+    do {                                                                      \
+        if (!(cond)) {                                                        \
+            fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__);              \
+            fprintf(stderr, __VA_ARGS__);                                     \
+            fputc('\n', stderr);                                              \
+            failures++;                                                       \
+        }                                                                     \
+    } while (0)
+
+// --- Entry point adapters ---
+
+static int legacy_seal(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    return algorithm == NC_ALG_AES_256_GCM
+           ? encrypt_aes_gcm_256(in, len, kKey, kNonce, sizeof(kNonce), NULL, 0, out)
+           : encrypt_chacha20_poly1305(in, len, kKey, kNonce, sizeof(kNonce), NULL, 0, out);
+}
+
+static int legacy_open(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    return algorithm == NC_ALG_AES_256_GCM
+           ? decrypt_aes_gcm_256(in, len, kKey, kNonce, sizeof(kNonce), NULL, 0, out)
+           : decrypt_chacha20_poly1305(in, len, kKey, kNonce, sizeof(kNonce), NULL, 0, out);
+}
+
+static int legacy_ex_seal(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    size_t out_len = 0;
+    int status = algorithm == NC_ALG_AES_256_GCM
+                 ? encrypt_aes_gcm_256_ex(in, len, kKey, kNonce, sizeof(kNonce), NULL, 0, out, &out_len)
+                 : encrypt_chacha20_poly1305_ex(in, len, kKey, kNonce, sizeof(kNonce), NULL, 0, out, &out_len);
+    return status < 0 ? status : (int)out_len;
+}
+
+static int legacy_ex_open(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    size_t out_len = 0;
+    int status = algorithm == NC_ALG_AES_256_GCM
+                 ? decrypt_aes_gcm_256_ex(in, len, kKey, kNonce, sizeof(kNonce), NULL, 0, out, &out_len)
+                 : decrypt_chacha20_poly1305_ex(in, len, kKey, kNonce, sizeof(kNonce), NULL, 0, out, &out_len);
+    return status < 0 ? status : (int)out_len;
+}
+
+static int stateless_seal(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    size_t out_len = 0;
+    int status = nc_seal(algorithm, kKey, sizeof(kKey), in, len, kNonce, sizeof(kNonce), NULL, 0, out, &out_len);
+    return status < 0 ? status : (int)out_len;
+}
+
+static int stateless_open(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    size_t out_len = 0;
+    int status = nc_open(algorithm, kKey, sizeof(kKey), in, len, kNonce, sizeof(kNonce), NULL, 0, out, &out_len);
+    return status < 0 ? status : (int)out_len;
+}
+
+static int seal_digest(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    uint8_t digest[NC_DIGEST_LEN];
+    size_t out_len = 0;
+    int status = nc_seal_digest(algorithm, kKey, sizeof(kKey), in, len, kNonce, sizeof(kNonce), NULL, 0,
+                                NC_DIGEST_SHA256, 0, out, &out_len, digest);
+    return status < 0 ? status : (int)out_len;
+}
+
+static int handle_seal(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    (void)algorithm;
+    return nc_aead_seal(g_ctx, in, len, kNonce, sizeof(kNonce), NULL, 0, out);
+}
+
+static int handle_open(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    (void)algorithm;
+    return nc_aead_open(g_ctx, in, len, kNonce, sizeof(kNonce), NULL, 0, out);
+}
+
+static int handle_ex_seal(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    size_t out_len = 0;
+    int status = nc_aead_seal_ex(g_ctx, in, len, kNonce, sizeof(kNonce), NULL, 0, out, &out_len);
+    (void)algorithm;
+    return status < 0 ? status : (int)out_len;
+}
+
+static int handle_ex_open(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    size_t out_len = 0;
+    int status = nc_aead_open_ex(g_ctx, in, len, kNonce, sizeof(kNonce), NULL, 0, out, &out_len);
+    (void)algorithm;
+    return status < 0 ? status : (int)out_len;
+}
+
+static int batch_seal(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    nc_aead_batch_item item = {in, len, kNonce, sizeof(kNonce), NULL, 0, out};
+    int status = 0;
+    (void)algorithm;
+    nc_aead_seal_batch(g_ctx, &item, 1, &status);
+    return status;
+}
+
+static int batch_open(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    nc_aead_batch_item item = {in, len, kNonce, sizeof(kNonce), NULL, 0, out};
+    int status = 0;
+    (void)algorithm;
+    nc_aead_open_batch(g_ctx, &item, 1, &status);
+    return status;
+}
+
+// The detached tag is kept right after the ciphertext, so the layouts match the other entry points.
+static int scatter_seal(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    nc_iovec piece = {in, len};
+    int status = nc_aead_seal_scatter(g_ctx, &piece, 1, kNonce, sizeof(kNonce), NULL, 0, out, out + len);
+    (void)algorithm;
+    return status < 0 ? status : status + NC_AEAD_TAG_LEN;
+}
+
+static int gather_open(int algorithm, const uint8_t* in, size_t len, uint8_t* out) {
+    nc_iovec piece = {in, len - NC_AEAD_TAG_LEN};
+    (void)algorithm;
+    return nc_aead_open_gather(g_ctx, &piece, 1, in + piece.len, NC_AEAD_TAG_LEN, kNonce, sizeof(kNonce),
+                               NULL, 0, out);
+}
+
+static const entry_point kEntryPoints[] = {
+    {"encrypt/decrypt", legacy_seal, legacy_open},
+    {"encrypt/decrypt _ex", legacy_ex_seal, legacy_ex_open},
+    {"nc_seal/nc_open", stateless_seal, stateless_open},
+    {"nc_seal_digest/nc_open", seal_digest, stateless_open},
+    {"nc_aead_seal/open", handle_seal, handle_open},
+    {"nc_aead_seal_ex/open_ex", handle_ex_seal, handle_ex_open},
+    {"nc_aead_seal/open_batch", batch_seal, batch_open},
+    {"nc_aead_seal_scatter/open_gather", scatter_seal, gather_open},
+};
+
+// --- Checks ---
+
+/**
+ * @brief Runs the in-place, overlap and adjacency checks of one entry point at one size.
+ *
+ * @param reference The expected ciphertext + tag of plaintext (len + 16 bytes).
+ */
+static void check_entry_point(const entry_point* ep, int algorithm, const uint8_t* plaintext, size_t len,
+                              const uint8_t* reference) {
+    size_t sealed_len = len + NC_AEAD_TAG_LEN;
+    // Room for an input and an exact-size output side by side, plus a byte of shift either way.
+    uint8_t* area = (uint8_t*)malloc(2 * sealed_len + 2);
+    uint8_t* buf = area + 1;
+    int n;
+
+    if (!area) {
+        CHECK(0, "%s: allocation failed", ep->name);
+        return;
+    }
+
+    // --- In place ---
+    memcpy(buf, plaintext, len);
+    n = ep->seal(algorithm, buf, len, buf);
+    CHECK(n == (int)sealed_len && memcmp(buf, reference, sealed_len) == 0, "%s, %zu B: in-place seal (%d)",
+          ep->name, len, n);
+    n = ep->open(algorithm, buf, sealed_len, buf);
+    CHECK(n == (int)len && memcmp(buf, plaintext, len) == 0, "%s, %zu B: in-place open (%d)", ep->name, len, n);
+
+    // --- Partial overlap, one byte either way ---
+    // A one-byte message shifted by one byte is merely adjacent, so it is left to the checks below.
+    if (len > 1) {
+        memcpy(buf, plaintext, len);
+        CHECK(ep->seal(algorithm, buf, len, buf + 1) < 0, "%s, %zu B: seal into input + 1 accepted",
+              ep->name, len);
+        CHECK(ep->seal(algorithm, buf, len, buf - 1) < 0, "%s, %zu B: seal into input - 1 accepted",
+              ep->name, len);
+        memcpy(buf, reference, sealed_len);
+        CHECK(ep->open(algorithm, buf, sealed_len, buf + 1) < 0, "%s, %zu B: open into input + 1 accepted",
+              ep->name, len);
+        CHECK(ep->open(algorithm, buf, sealed_len, buf - 1) < 0, "%s, %zu B: open into input - 1 accepted",
+              ep->name, len);
+    }
+
+    // --- Adjacent exact-size outputs ---
+    // Seal: [plaintext][output] and [output][plaintext].
+    memcpy(buf, plaintext, len);
+    n = ep->seal(algorithm, buf, len, buf + len);
+    CHECK(n == (int)sealed_len && memcmp(buf + len, reference, sealed_len) == 0,
+          "%s, %zu B: seal into the bytes after the input (%d)", ep->name, len, n);
+    memcpy(buf + sealed_len, plaintext, len);
+    n = ep->seal(algorithm, buf + sealed_len, len, buf);
+    CHECK(n == (int)sealed_len && memcmp(buf, reference, sealed_len) == 0,
+          "%s, %zu B: seal into the bytes before the input (%d)", ep->name, len, n);
+    // Open: [ciphertext + tag][output] and [output][ciphertext + tag].
+    memcpy(buf, reference, sealed_len);
+    n = ep->open(algorithm, buf, sealed_len, buf + sealed_len);
+    CHECK(n == (int)len && memcmp(buf + sealed_len, plaintext, len) == 0,
+          "%s, %zu B: open into the bytes after the input (%d)", ep->name, len, n);
+    memcpy(buf + len, reference, sealed_len);
+    n = ep->open(algorithm, buf + len, sealed_len, buf);
+    CHECK(n == (int)len && memcmp(buf, plaintext, len) == 0,
+          "%s, %zu B: open into the bytes before the input (%d)", ep->name, len, n);
+
+    free(area);
+}
+
+/**
+ * @brief Checks the single-buffer nc_aead_seal_in_place/nc_aead_open_in_place pair.
+ */
+static void check_in_place_pair(const uint8_t* plaintext, size_t len, const uint8_t* reference) {
+    size_t sealed_len = len + NC_AEAD_TAG_LEN;
+    uint8_t* buf = (uint8_t*)malloc(sealed_len);
+    int n;
+
+    if (!buf) {
+        CHECK(0, "nc_aead_seal_in_place: allocation failed");
+        return;
+    }
+    memcpy(buf, plaintext, len);
+    n = nc_aead_seal_in_place(g_ctx, buf, len, kNonce, sizeof(kNonce), NULL, 0);
+    CHECK(n == (int)sealed_len && memcmp(buf, reference, sealed_len) == 0,
+          "nc_aead_seal_in_place, %zu B (%d)", len, n);
+    n = nc_aead_open_in_place(g_ctx, buf, sealed_len, kNonce, sizeof(kNonce), NULL, 0);
+    CHECK(n == (int)len && memcmp(buf, plaintext, len) == 0, "nc_aead_open_in_place, %zu B (%d)", len, n);
+    free(buf);
+}
+
+int main(void) {
+    static const int kAlgorithmIds[] = {NC_ALG_AES_256_GCM, NC_ALG_CHACHA20_POLY1305};
+    size_t a, s, e;
+
+    for (a = 0; a < sizeof(kAlgorithmIds) / sizeof(kAlgorithmIds[0]); a++) {
+        int algorithm = kAlgorithmIds[a];
+
+        g_ctx = nc_aead_ctx_new(algorithm, kKey, sizeof(kKey));
+        if (!g_ctx) {
+            fprintf(stderr, "FAIL: nc_aead_ctx_new(%d)\n", algorithm);
+            return 1;
+        }
+        for (s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); s++) {
+            size_t len = kSizes[s];
+            uint8_t* plaintext = (uint8_t*)malloc(len);
+            uint8_t* reference = (uint8_t*)malloc(len + NC_AEAD_TAG_LEN);
+            size_t reference_len = 0;
+
+            if (!plaintext || !reference) {
+                fprintf(stderr, "FAIL: allocation of %zu bytes\n", len);
+                return 1;
+            }
+            nc_fill_random(plaintext, len, NC_RANDOM_SEEDED, len);
+            // Out of place, non-overlapping buffers: the ciphertext every other layout must reproduce.
+            CHECK(nc_seal(algorithm, kKey, sizeof(kKey), plaintext, len, kNonce, sizeof(kNonce), NULL, 0,
+                          reference, &reference_len) == 0 && reference_len == len + NC_AEAD_TAG_LEN,
+                  "reference seal, %zu B", len);
+
+            for (e = 0; e < sizeof(kEntryPoints) / sizeof(kEntryPoints[0]); e++) {
+                check_entry_point(&kEntryPoints[e], algorithm, plaintext, len, reference);
+            }
+            check_in_place_pair(plaintext, len, reference);
+            free(reference);
+            free(plaintext);
+        }
+        nc_aead_ctx_free(g_ctx);
+    }
+
+    if (failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("in_place_test: all checks passed\n");
+    return 0;
+}
@@ -33,7 +33,8 @@ def load_and_clean_data(filepath):
         implementation_map = {
             'ffi': 'FFI',
             'platformChannel': 'Platform Channel',
-            'dart': 'Dart'
+            'dart': 'Dart',
+            'native': 'Native'
         }
         df['Implementation'] = implementation_raw.map(implementation_map)
 
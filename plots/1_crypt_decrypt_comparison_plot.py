@@ -29,7 +29,7 @@ def load_and_combine_data(file_mapping):
 
             # Mapowanie implementacji
             implementation_raw = df['Implementation'].str.split('.').str[-1]
-            implementation_map = {'ffi': 'FFI', 'platformChannel': 'Platform Channel', 'dart': 'Dart'}
+            implementation_map = {'ffi': 'FFI', 'platformChannel': 'Platform Channel', 'dart': 'Dart', 'native': 'Native'}
             df['Implementation'] = implementation_raw.map(implementation_map)
 
             # Mapowanie algorytmów
@@ -33,7 +33,7 @@ def przetwarzaj_plik(filepath, device_name):
 
     # --- Krok 1: Mapowanie nazw ---
     implementation_raw = df['Implementation'].str.split('.').str[-1]
-    implementation_map = {'ffi': 'FFI', 'platformChannel': 'Platform Channel', 'dart': 'Dart'}
+    implementation_map = {'ffi': 'FFI', 'platformChannel': 'Platform Channel', 'dart': 'Dart', 'native': 'Native'}
     df['Implementation'] = implementation_raw.map(implementation_map)
 
     algorithm_raw = df['Algorithm'].str.split('.').str[-1]
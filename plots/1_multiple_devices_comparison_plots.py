@@ -26,7 +26,7 @@ def load_and_combine_data(file_mapping):
             df = pd.read_csv(filepath, sep=';', skip_blank_lines=True)
             df.columns = df.columns.str.strip()
             implementation_raw = df['Implementation'].str.split('.').str[-1]
-            implementation_map = {'ffi': 'FFI', 'platformChannel': 'Platform Channel', 'dart': 'Dart'}
+            implementation_map = {'ffi': 'FFI', 'platformChannel': 'Platform Channel', 'dart': 'Dart', 'native': 'Native'}
             df['Implementation'] = implementation_raw.map(implementation_map)
             algorithm_raw = df['Algorithm'].str.split('.').str[-1]
             algorithm_map = {'aesGcm': 'AES-GCM 256', 'chaChaPoly': 'ChaCha20-Poly1305'}
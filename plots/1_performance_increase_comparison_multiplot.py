@@ -27,7 +27,7 @@ def load_and_combine_data(file_mapping):
             df = pd.read_csv(filepath, sep=';', skip_blank_lines=True)
             df.columns = df.columns.str.strip()
             implementation_raw = df['Implementation'].str.split('.').str[-1].str.lower().str.strip()
-            implementation_map = {'ffi': 'FFI', 'platformchannel': 'Platform Channel', 'dart': 'Dart'}
+            implementation_map = {'ffi': 'FFI', 'platformchannel': 'Platform Channel', 'dart': 'Dart', 'native': 'Native'}
             df['Implementation'] = implementation_raw.map(implementation_map)
             algorithm_raw = df['Algorithm'].str.split('.').str[-1].str.lower().str.strip()
             algorithm_map = {'aesgcm': 'AES-GCM 256', 'chachapoly': 'ChaCha20-Poly1305'}